@@ -24,6 +24,8 @@ int main()
     v.lightingEffects();
     mplot::VisualTextModel<>* fps_tm;
     v.addLabel ("0 FPS", {0.13f, -0.23f, 0.0f}, fps_tm); // With fps_tm can update the VisualTextModel with fps_tm->setupText("new text")
+    // The FPS text changes often, so reserve room for it to be rewritten in place with updateText()
+    fps_tm->reserved_glyphs = 64;
 
     // Create a hexgrid to show in the scene
     constexpr float hex_to_hex = 0.02f;
@@ -104,7 +106,7 @@ int main()
             rest_fps = std::max (rest_fps, std::round((((double)fcount/rest_tau))*1000.0));
             std::stringstream ss;
             ss << "FPS: " << data_fps << " [dat] " << update_fps << " [upd] " << rest_fps << " [rest] " << all_fps << " [all]\n";
-            fps_tm->setupText (ss.str());
+            fps_tm->updateText (ss.str());
             data_dur = sc::duration{0};
             update_dur = sc::duration{0};
             all_dur = sc::duration{0};
@@ -1,6 +1,10 @@
 /*
  * An example mplot::Visual scene, containing a Grid, and using GridVisual. The function shown
  * changes and is updated with reinitColours() and reinit() and each is profiled.
+ *
+ * Built as grid_flat_dynamic_static (with STATIC_COLOURMAP defined), the GridVisual's colour map
+ * is an mplot::StaticColourMap. Its type is fixed at compile time, so the colour map is not
+ * switched, and the FPS can be compared with that of the Cork map in grid_flat_dynamic.
  */
 
 #include <iostream>
@@ -14,6 +18,12 @@
 #include <mplot/Visual.h>
 #include <mplot/VisualDataModel.h>
 #include <mplot/GridVisual.h>
+#ifdef STATIC_COLOURMAP
+# include <mplot/StaticColourMap.h>
+using cmap_t = mplot::StaticColourMap<mplot::ColourMapType::Cork>;
+#else
+using cmap_t = mplot::ColourMap<float>;
+#endif
 
 int main()
 {
@@ -37,11 +47,13 @@ int main()
     // Add a GridVisual to display the Grid within the mplot::Visual scene
     sm::vec<float, 3> offset = { -step * grid.width(), -step * grid.width(), 0.0f };
 
-    auto gv = std::make_unique<mplot::GridVisual<float>>(&grid, offset);
+    auto gv = std::make_unique<mplot::GridVisual<float, unsigned int, float, mplot::gl::version_4_1, cmap_t>>(&grid, offset);
     v.bindmodel (gv);
     gv->gridVisMode = mplot::GridVisMode::Triangles; // Choose [fastest-->] Triangles, Pixels, RectInterp or Columns [-->slowest]
     gv->setScalarData (&data);
+#ifndef STATIC_COLOURMAP
     gv->cm.setType (mplot::ColourMapType::Cork);
+#endif
     gv->zScale.do_autoscale = false;
     gv->zScale.null_scaling();
     gv->colourScale.do_autoscale = false;
@@ -69,6 +81,7 @@ int main()
 
         v.poll();
 
+#ifndef STATIC_COLOURMAP
         if (incrementer %500 == 0) { // change colourmap
             if (gvp->cm.getType() == mplot::ColourMapType::Cork) {
                 gvp->cm.setType (mplot::ColourMapType::Jet);
@@ -76,6 +89,7 @@ int main()
                 gvp->cm.setType (mplot::ColourMapType::Cork);
             }
         }
+#endif
 
         if (incrementer % 1000 == 0) { // switch modes
             reinitJustColours = reinitJustColours ? false : true;
@@ -125,7 +125,7 @@ namespace mplot {
             this->setupScaling();
 
             for (unsigned int ri = 0; ri < nrect; ++ri) {
-                std::array<float, 3> clr = this->setColour (ri);
+                std::array<float, 3> clr = this->colourAt (ri);
                 this->vertex_push (this->cg->d_x[ri]+centering_offset[0],
                                    this->cg->d_y[ri]+centering_offset[1], this->dcopy[ri], this->vertexPositions);
                 this->vertex_push (clr, this->vertexColors);
@@ -198,7 +198,7 @@ namespace mplot {
 
                 // Use a single colour for each rect, even though rectangle's z
                 // positions are interpolated. Do the _colour_ scaling:
-                std::array<float, 3> clr = this->setColour (ri);
+                std::array<float, 3> clr = this->colourAt (ri);
 
                 // First push the 5 positions of the triangle vertices, starting with the centre
                 this->vertex_push (this->cg->d_x[ri]+centering_offset[0], this->cg->d_y[ri]+centering_offset[1], datumC, this->vertexPositions);
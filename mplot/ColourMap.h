@@ -9,6 +9,15 @@
 #include <stdexcept>
 #include <cmath>
 #include <cstdint>
+#include <span>
+#include <array>
+#include <limits>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <compare>
 #include <mplot/tools.h>
 
 #include <sm/vec>
@@ -563,6 +572,17 @@ namespace mplot {
         //! colour retrieved from the map.
         bool act_2d = false;
 
+        //! The number of entries in a 1D lookup table
+        static constexpr std::size_t lut_size = 4096;
+        //! The number of entries along each side of a 2D lookup table
+        static constexpr std::size_t lut2d_size = 256;
+        using lut_type = std::vector<std::array<float, 3>>;
+        //! Colours for the procedural 1D maps, sampled at lut_size points on [0, 1] (see bake_luts)
+        std::shared_ptr<const lut_type> lut1d;
+        //! Colours for the 2D maps (and for convertWithSaturation in act_2d mode), sampled on a
+        //! lut2d_size by lut2d_size grid over [0, 1]x[0, 1], with the first datum varying fastest
+        std::shared_ptr<const lut_type> lut2d;
+
     public:
         //! Default constructor is required, but need not do anything.
         ColourMap() {}
@@ -1742,6 +1762,18 @@ namespace mplot {
          * full colour disc.
          */
         std::array<float, 3> convert (T _datum1, T _datum2) const
+        {
+            if constexpr (std::is_floating_point<std::decay_t<T>>::value == true) {
+                if (this->lut2d && ColourMap<T>::procedural_2d (this->type)
+                    && _datum1 >= T{0} && _datum1 <= T{1} && _datum2 >= T{0} && _datum2 <= T{1}) {
+                    return this->lut2d_lookup (static_cast<float>(_datum1), static_cast<float>(_datum2));
+                }
+            }
+            return this->compute (_datum1, _datum2);
+        }
+
+        //! Compute the colour for convert (T, T) without using the lookup table
+        std::array<float, 3> compute (T _datum1, T _datum2) const
         {
             std::array<float, 3> c = {0.0f, 0.0f, 0.0f};
             if (this->type == ColourMapType::Duochrome) {
@@ -1851,15 +1883,23 @@ namespace mplot {
         //! A 2D convert() which adjusts the saturation of the retrieved colour using the second dimension.
         std::array<float, 3> convertWithSaturation (const T _datum, const T _saturation) const
         {
+            float saturation = _saturation > T{1} ? 1.0f : static_cast<float>(_saturation);
+            saturation = saturation < 0.0f ? 0.0f : saturation;
+            if (this->lut2d && !ColourMap<T>::procedural_2d (this->type)) {
+                const float datum = this->unit_datum (_datum);
+                if (!std::isnan (datum) && !std::isnan (saturation)) { return this->lut2d_lookup (datum, saturation); }
+            }
             std::array<float, 3> c = this->convert (_datum);
             std::array<float, 3> hsv = ColourMap<T>::rgb2hsv (c);
-            float saturation = _saturation > T{1} ? 1.0f : static_cast<float>(_saturation);
-            hsv[1] *= saturation < 0.0f ? 0.0f : saturation;
+            hsv[1] *= saturation;
             return ColourMap<T>::hsv2rgb (hsv);
         }
 
-        //! Convert the scalar datum into an RGB (or BGR) colour
-        std::array<float, 3> convert (T _datum) const
+        /*!
+         * Convert the datum into the range [0, 1] used to index the colour map, clamping
+         * out-of-range values. A NaN datum remains NaN.
+         */
+        float unit_datum (T _datum) const
         {
             float datum = 0.0f;
 
@@ -1887,14 +1927,31 @@ namespace mplot {
                 throw std::runtime_error ("Unhandled ColourMap data type.");
             }
 
-            std::array<float, 3> c = {0.0f, 0.0f, 0.0f};
+            return datum;
+        }
+
+        //! Convert the scalar datum into an RGB (or BGR) colour
+        std::array<float, 3> convert (T _datum) const
+        {
+            const float datum = this->unit_datum (_datum);
 
             // Check for nan and return a 'nan' colour for the colour map
             if constexpr (std::is_same<std::decay_t<T>, double>::value == true
                           || std::is_same<std::decay_t<T>, float>::value == true) {
-                if (std::isnan(datum) == true) { c = ColourMap<T>::nanColour(this->type); return c; }
+                if (std::isnan(datum) == true) { return ColourMap<T>::nanColour(this->type); }
             }
 
+            if (this->lut1d) {
+                return (*this->lut1d)[static_cast<std::size_t>(std::round (datum * static_cast<float>(lut_size - 1)))];
+            }
+            return this->compute (datum);
+        }
+
+        //! Compute the colour for a datum in the range [0, 1] without using the lookup table
+        std::array<float, 3> compute (const float datum) const
+        {
+            std::array<float, 3> c = {0.0f, 0.0f, 0.0f};
+
             switch (this->type) {
             case ColourMapType::Jet:
             {
@@ -2677,6 +2734,202 @@ namespace mplot {
             return c;
         }
 
+        /*!
+         * The colour table for a listed colour map type (one whose colour is simply looked up from
+         * a table, such as Viridis or any of the CET and Crameri maps). Empty for types that are
+         * computed, or that have special cases (such as RainbowZeroBlack).
+         */
+        static constexpr std::span<const std::array<float, 3>> listed_table (const ColourMapType _t)
+        {
+            switch (_t) {
+            case ColourMapType::Jet: { return mplot::cet::cm_CET_R4; }
+            case ColourMapType::Rainbow: { return mplot::cet::cm_CET_C6; }
+            case ColourMapType::Magma: { return mplot::cm_magma; }
+            case ColourMapType::Inferno: { return mplot::cm_inferno; }
+            case ColourMapType::Plasma: { return mplot::cm_plasma; }
+            case ColourMapType::Viridis: { return mplot::cm_viridis; }
+            case ColourMapType::Cividis: { return mplot::cm_cividis; }
+            case ColourMapType::Twilight: { return mplot::cm_twilight; }
+            case ColourMapType::Petrov: { return mplot::cm_petrov; }
+            case ColourMapType::Devon: { return mplot::crameri::cm_devon; }
+            case ColourMapType::NaviaW: { return mplot::crameri::cm_naviaW; }
+            case ColourMapType::BrocO: { return mplot::crameri::cm_brocO; }
+            case ColourMapType::Acton: { return mplot::crameri::cm_acton; }
+            case ColourMapType::Batlow: { return mplot::crameri::cm_batlow; }
+            case ColourMapType::Berlin: { return mplot::crameri::cm_berlin; }
+            case ColourMapType::Tofino: { return mplot::crameri::cm_tofino; }
+            case ColourMapType::Broc: { return mplot::crameri::cm_broc; }
+            case ColourMapType::CorkO: { return mplot::crameri::cm_corkO; }
+            case ColourMapType::Lapaz: { return mplot::crameri::cm_lapaz; }
+            case ColourMapType::BamO: { return mplot::crameri::cm_bamO; }
+            case ColourMapType::Vanimo: { return mplot::crameri::cm_vanimo; }
+            case ColourMapType::Lajolla: { return mplot::crameri::cm_lajolla; }
+            case ColourMapType::Lisbon: { return mplot::crameri::cm_lisbon; }
+            case ColourMapType::GrayC: { return mplot::crameri::cm_grayC; }
+            case ColourMapType::Roma: { return mplot::crameri::cm_roma; }
+            case ColourMapType::Vik: { return mplot::crameri::cm_vik; }
+            case ColourMapType::Navia: { return mplot::crameri::cm_navia; }
+            case ColourMapType::Bilbao: { return mplot::crameri::cm_bilbao; }
+            case ColourMapType::Turku: { return mplot::crameri::cm_turku; }
+            case ColourMapType::Lipari: { return mplot::crameri::cm_lipari; }
+            case ColourMapType::VikO: { return mplot::crameri::cm_vikO; }
+            case ColourMapType::BatlowK: { return mplot::crameri::cm_batlowK; }
+            case ColourMapType::Oslo: { return mplot::crameri::cm_oslo; }
+            case ColourMapType::Oleron: { return mplot::crameri::cm_oleron; }
+            case ColourMapType::Davos: { return mplot::crameri::cm_davos; }
+            case ColourMapType::Fes: { return mplot::crameri::cm_fes; }
+            case ColourMapType::Managua: { return mplot::crameri::cm_managua; }
+            case ColourMapType::Glasgow: { return mplot::crameri::cm_glasgow; }
+            case ColourMapType::Tokyo: { return mplot::crameri::cm_tokyo; }
+            case ColourMapType::Bukavu: { return mplot::crameri::cm_bukavu; }
+            case ColourMapType::Bamako: { return mplot::crameri::cm_bamako; }
+            case ColourMapType::BatlowW: { return mplot::crameri::cm_batlowW; }
+            case ColourMapType::Nuuk: { return mplot::crameri::cm_nuuk; }
+            case ColourMapType::Cork: { return mplot::crameri::cm_cork; }
+            case ColourMapType::Hawaii: { return mplot::crameri::cm_hawaii; }
+            case ColourMapType::Bam: { return mplot::crameri::cm_bam; }
+            case ColourMapType::Imola: { return mplot::crameri::cm_imola; }
+            case ColourMapType::RomaO: { return mplot::crameri::cm_romaO; }
+            case ColourMapType::Buda: { return mplot::crameri::cm_buda; }
+            case ColourMapType::CET_L02: { return mplot::cet::cm_CET_L02; }
+            case ColourMapType::CET_L13: { return mplot::cet::cm_CET_L13; }
+            case ColourMapType::CET_C4: { return mplot::cet::cm_CET_C4; }
+            case ColourMapType::CET_D04: { return mplot::cet::cm_CET_D04; }
+            case ColourMapType::CET_L12: { return mplot::cet::cm_CET_L12; }
+            case ColourMapType::CET_C1s: { return mplot::cet::cm_CET_C1s; }
+            case ColourMapType::CET_L01: { return mplot::cet::cm_CET_L01; }
+            case ColourMapType::CET_C5: { return mplot::cet::cm_CET_C5; }
+            case ColourMapType::CET_D11: { return mplot::cet::cm_CET_D11; }
+            case ColourMapType::CET_L04: { return mplot::cet::cm_CET_L04; }
+            case ColourMapType::CET_CBL2: { return mplot::cet::cm_CET_CBL2; }
+            case ColourMapType::CET_C4s: { return mplot::cet::cm_CET_C4s; }
+            case ColourMapType::CET_L15: { return mplot::cet::cm_CET_L15; }
+            case ColourMapType::CET_L20: { return mplot::cet::cm_CET_L20; }
+            case ColourMapType::CET_CBD1: { return mplot::cet::cm_CET_CBD1; }
+            case ColourMapType::CET_D06: { return mplot::cet::cm_CET_D06; }
+            case ColourMapType::CET_I3: { return mplot::cet::cm_CET_I3; }
+            case ColourMapType::CET_D01A: { return mplot::cet::cm_CET_D01A; }
+            case ColourMapType::CET_L16: { return mplot::cet::cm_CET_L16; }
+            case ColourMapType::CET_L06: { return mplot::cet::cm_CET_L06; }
+            case ColourMapType::CET_C2s: { return mplot::cet::cm_CET_C2s; }
+            case ColourMapType::CET_I1: { return mplot::cet::cm_CET_I1; }
+            case ColourMapType::CET_C7s: { return mplot::cet::cm_CET_C7s; }
+            case ColourMapType::CET_I2: { return mplot::cet::cm_CET_I2; }
+            case ColourMapType::CET_C6s: { return mplot::cet::cm_CET_C6s; }
+            case ColourMapType::CET_C6: { return mplot::cet::cm_CET_C6; }
+            case ColourMapType::CET_L05: { return mplot::cet::cm_CET_L05; }
+            case ColourMapType::CET_D08: { return mplot::cet::cm_CET_D08; }
+            case ColourMapType::CET_L03: { return mplot::cet::cm_CET_L03; }
+            case ColourMapType::CET_L14: { return mplot::cet::cm_CET_L14; }
+            case ColourMapType::CET_C2: { return mplot::cet::cm_CET_C2; }
+            case ColourMapType::CET_R3: { return mplot::cet::cm_CET_R3; }
+            case ColourMapType::CET_D01: { return mplot::cet::cm_CET_D01; }
+            case ColourMapType::CET_C1: { return mplot::cet::cm_CET_C1; }
+            case ColourMapType::CET_D02: { return mplot::cet::cm_CET_D02; }
+            case ColourMapType::CET_CBC1: { return mplot::cet::cm_CET_CBC1; }
+            case ColourMapType::CET_D09: { return mplot::cet::cm_CET_D09; }
+            case ColourMapType::CET_L10: { return mplot::cet::cm_CET_L10; }
+            case ColourMapType::CET_R1: { return mplot::cet::cm_CET_R1; }
+            case ColourMapType::CET_C3: { return mplot::cet::cm_CET_C3; }
+            case ColourMapType::CET_CBL1: { return mplot::cet::cm_CET_CBL1; }
+            case ColourMapType::CET_C3s: { return mplot::cet::cm_CET_C3s; }
+            case ColourMapType::CET_C5s: { return mplot::cet::cm_CET_C5s; }
+            case ColourMapType::CET_L08: { return mplot::cet::cm_CET_L08; }
+            case ColourMapType::CET_R4: { return mplot::cet::cm_CET_R4; }
+            case ColourMapType::CET_R2: { return mplot::cet::cm_CET_R2; }
+            case ColourMapType::CET_L11: { return mplot::cet::cm_CET_L11; }
+            case ColourMapType::CET_D10: { return mplot::cet::cm_CET_D10; }
+            case ColourMapType::CET_D07: { return mplot::cet::cm_CET_D07; }
+            case ColourMapType::CET_L17: { return mplot::cet::cm_CET_L17; }
+            case ColourMapType::CET_D12: { return mplot::cet::cm_CET_D12; }
+            case ColourMapType::CET_CBC2: { return mplot::cet::cm_CET_CBC2; }
+            case ColourMapType::CET_D13: { return mplot::cet::cm_CET_D13; }
+            case ColourMapType::CET_D03: { return mplot::cet::cm_CET_D03; }
+            case ColourMapType::CET_C7: { return mplot::cet::cm_CET_C7; }
+            case ColourMapType::CET_L07: { return mplot::cet::cm_CET_L07; }
+            case ColourMapType::CET_L09: { return mplot::cet::cm_CET_L09; }
+            case ColourMapType::CET_L18: { return mplot::cet::cm_CET_L18; }
+            case ColourMapType::CET_L19: { return mplot::cet::cm_CET_L19; }
+            default: { return {}; }
+            }
+        }
+
+        /*!
+         * Convert many scalar data into colours at once. Three floats per datum are written into
+         * rgb_out, which must hold at least 3 * data.size() floats. The colour map type is
+         * examined once. For listed maps (and procedural maps that have been baked into a lookup
+         * table), blocks of data are turned into table indices in one loop (which the compiler can
+         * vectorise) and the colours are then gathered from the table in a second. Other maps fall
+         * back to convert (T) for each datum.
+         */
+        void convert (std::span<const T> data, std::span<float> rgb_out) const
+        {
+            if (rgb_out.size() < 3 * data.size()) { throw std::runtime_error ("ColourMap::convert: rgb_out is too small"); }
+
+            std::span<const std::array<float, 3>> table = ColourMap<T>::listed_table (this->type);
+            if (table.empty() && this->lut1d) { table = *this->lut1d; }
+            if (table.empty()) {
+                for (std::size_t i = 0; i < data.size(); ++i) {
+                    const std::array<float, 3> c = this->convert (data[i]);
+                    rgb_out[3 * i] = c[0];
+                    rgb_out[3 * i + 1] = c[1];
+                    rgb_out[3 * i + 2] = c[2];
+                }
+                return;
+            }
+
+            const std::array<float, 3> nan_colour = ColourMap<T>::nanColour (this->type);
+            const float top = static_cast<float>(table.size() - 1);
+            constexpr uint32_t nan_index = std::numeric_limits<uint32_t>::max();
+            constexpr std::size_t block = 256;
+            std::array<uint32_t, block> idx;
+            for (std::size_t i0 = 0; i0 < data.size(); i0 += block) {
+                const std::size_t n = std::min (block, data.size() - i0);
+                for (std::size_t j = 0; j < n; ++j) {
+                    const float d = this->unit_datum (data[i0 + j]);
+                    idx[j] = std::isnan (d) ? nan_index : static_cast<uint32_t>(std::round (d * top));
+                }
+                float* out = rgb_out.data() + 3 * i0;
+                for (std::size_t j = 0; j < n; ++j) {
+                    const std::array<float, 3>& c = idx[j] == nan_index ? nan_colour : table[idx[j]];
+                    out[3 * j] = c[0];
+                    out[3 * j + 1] = c[1];
+                    out[3 * j + 2] = c[2];
+                }
+            }
+        }
+
+        //! Convert pairs of data (for Duochrome, HSV and Disc maps, or a 1D map with act_2d set)
+        //! into colours, writing three floats per pair into rgb_out.
+        void convert (std::span<const T> data1, std::span<const T> data2, std::span<float> rgb_out) const
+        {
+            if (data2.size() < data1.size() || rgb_out.size() < 3 * data1.size()) {
+                throw std::runtime_error ("ColourMap::convert: input or output span is too small");
+            }
+            for (std::size_t i = 0; i < data1.size(); ++i) {
+                const std::array<float, 3> c = this->convert (data1[i], data2[i]);
+                rgb_out[3 * i] = c[0];
+                rgb_out[3 * i + 1] = c[1];
+                rgb_out[3 * i + 2] = c[2];
+            }
+        }
+
+        //! Convert triplets of data (for Trichrome and RGB maps) into colours, writing three floats
+        //! per triplet into rgb_out.
+        void convert (std::span<const T> data1, std::span<const T> data2, std::span<const T> data3,
+                      std::span<float> rgb_out) const
+        {
+            if (data2.size() < data1.size() || data3.size() < data1.size() || rgb_out.size() < 3 * data1.size()) {
+                throw std::runtime_error ("ColourMap::convert: input or output span is too small");
+            }
+            for (std::size_t i = 0; i < data1.size(); ++i) {
+                const std::array<float, 3> c = this->convert (data1[i], data2[i], data3[i]);
+                rgb_out[3 * i] = c[0];
+                rgb_out[3 * i + 1] = c[1];
+                rgb_out[3 * i + 2] = c[2];
+            }
+        }
+
         //! Getter for type, the ColourMapType of this ColourMap.
         ColourMapType getType() const { return this->type; }
 
@@ -2726,6 +2979,7 @@ namespace mplot {
                 break;
             }
             }
+            this->bake_luts();
         }
 
         //! Setter that takes a string representation of the colour map type
@@ -2739,6 +2993,7 @@ namespace mplot {
             }
             this->hue = 0.0f;
             this->hue2 = 0.6667f;
+            this->bake_luts();
         }
         //! Set Duochrome to be Blue-red
         void setHueBR()
@@ -2748,6 +3003,7 @@ namespace mplot {
             }
             this->hue = 0.6667f;
             this->hue2 = 0.0f;
+            this->bake_luts();
         }
 
         //! Set Duochrome to be Green-Blue
@@ -2758,6 +3014,7 @@ namespace mplot {
             }
             this->hue = 0.3333f;
             this->hue2 = 0.6667f;
+            this->bake_luts();
         }
         //! Set Duochrome to be Blue-Green
         void setHueBG()
@@ -2767,6 +3024,7 @@ namespace mplot {
             }
             this->hue = 0.66667f;
             this->hue2 = 0.3333f;
+            this->bake_luts();
         }
 
         //! Set Duochrome to be Red-Green
@@ -2777,6 +3035,7 @@ namespace mplot {
             }
             this->hue = 0.0f;
             this->hue2 = 0.3333f;
+            this->bake_luts();
         }
         //! Set Duochrome to be Green-Red
         void setHueGR()
@@ -2786,6 +3045,7 @@ namespace mplot {
             }
             this->hue = 0.33333f;
             this->hue2 = 0.0f;
+            this->bake_luts();
         }
 
         //! Set up a Cyan-Magenta Duochrome colour scheme
@@ -2796,6 +3056,7 @@ namespace mplot {
             }
             this->hue = 0.5f;
             this->hue2 = 0.8333f;
+            this->bake_luts();
         }
         //! Set up a Magenta-Cyan Duochrome colour scheme
         void setHueMC()
@@ -2805,6 +3066,7 @@ namespace mplot {
             }
             this->hue = 0.83333f;
             this->hue2 = 0.5f;
+            this->bake_luts();
         }
 
         //! Set a ColourMapType::Duochrome map using h as the first hue and h+0.3333 as the second hue
@@ -2816,6 +3078,7 @@ namespace mplot {
             this->hue = h;
             this->hue2 = h+0.3333f;
             if (hue2 > 1.0f) { hue2 -= 1.0f; }
+            this->bake_luts();
         }
         //! Set a ColourMapType::DuoChrome map using h as the first hue and h-0.3333 as the second hue
         void setDualAntiHue(const float& h)
@@ -2826,6 +3089,7 @@ namespace mplot {
             this->hue = h;
             this->hue2 = h-0.3333f;
             if (hue2 < 0.0f) { hue2 += 1.0f; }
+            this->bake_luts();
         }
 
         //! Set the hue... unless you can't/shouldn't
@@ -2872,6 +3136,7 @@ namespace mplot {
                 break;
             }
             }
+            this->bake_luts();
         }
 
         //! Set the saturation. For many colour maps, this will make little difference,
@@ -2882,6 +3147,7 @@ namespace mplot {
                 throw std::runtime_error ("Only ColourMapType::Fixed ::Monochrome and ::Monoval allow setting of saturation");
             }
             this->sat = _s;
+            this->bake_luts();
         }
 
         //! Set just the colour's value (ColourMapType::Fixed/HSV only)
@@ -2892,6 +3158,7 @@ namespace mplot {
                 throw std::runtime_error ("Only ColourMapType::Fixed ::HSV ::Monochrome and ::Monoval allow setting of value");
             }
             this->val = _v;
+            this->bake_luts();
         }
 
         float getHue() const { return this->hue; }
@@ -2907,6 +3174,7 @@ namespace mplot {
             this->hue = h;
             this->sat = s;
             this->val = v;
+            this->bake_luts();
         }
 
         //! Set the colour by hue, saturation and value (defined in an array) (ColourMapType::Fixed only)
@@ -2919,6 +3187,7 @@ namespace mplot {
             this->hue = hsv[0];
             this->sat = hsv[1];
             this->val = hsv[2];
+            this->bake_luts();
         }
 
         //! Get the hue, in its most saturated form
@@ -2932,6 +3201,7 @@ namespace mplot {
                 throw std::runtime_error ("Only ColourMapType::HSV and Disc* allow setting of hue rotation");
             }
             this->hue_rotation = rotation_rads;
+            this->bake_luts();
         }
 
         void setHueReverse (const bool rev)
@@ -2942,9 +3212,14 @@ namespace mplot {
                 throw std::runtime_error ("It's only relevant to reverse hue direction for ColourMapType::HSV and Disc*");
             }
             this->hue_reverse_direction = rev;
+            this->bake_luts();
         }
 
-        void set_act_2d (const bool _2d) { this->act_2d = _2d; }
+        void set_act_2d (const bool _2d)
+        {
+            this->act_2d = _2d;
+            this->bake_luts();
+        }
 
         /*!
          * @param datum gray value from 0.0 to 1.0
@@ -3054,6 +3329,162 @@ namespace mplot {
         }
 
     private:
+        //! True for the 1D maps whose colours are computed (rather than looked up from a listed table)
+        static bool procedural_1d (const ColourMapType _t)
+        {
+            switch (_t) {
+            case ColourMapType::Fire:
+            case ColourMapType::Ocean:
+            case ColourMapType::Ice:
+            case ColourMapType::DivBlueRed:
+            case ColourMapType::CyclicGrey:
+            case ColourMapType::CyclicFour:
+            case ColourMapType::CyclicSix:
+            case ColourMapType::CyclicDivBlueRed:
+            case ColourMapType::Greyscale:
+            case ColourMapType::GreyscaleInv:
+            case ColourMapType::Monochrome:
+            case ColourMapType::MonochromeRed:
+            case ColourMapType::MonochromeBlue:
+            case ColourMapType::MonochromeGreen:
+            case ColourMapType::Monoval:
+            case ColourMapType::HSV1D:
+            { return true; }
+            // MonovalRed, MonovalGreen and MonovalBlue are left out on purpose: their colour is just
+            // the datum in one channel, which is cheaper to compute than a table lookup, and exact.
+            default: { return false; }
+            }
+        }
+
+        /*!
+         * True for the maps whose convert (T, T) is computed from two data via a radius and angle.
+         * Duochrome is not included; its two hsv2rgb calls are as fast as a bilinear lookup.
+         */
+        static bool procedural_2d (const ColourMapType _t)
+        {
+            return _t == ColourMapType::HSV
+            || _t == ColourMapType::DiscFourWhite || _t == ColourMapType::DiscFourBlack
+            || _t == ColourMapType::DiscSixWhite || _t == ColourMapType::DiscSixBlack;
+        }
+
+        //! Everything that determines the content of a lookup table
+        struct lut_key
+        {
+            ColourMapType type = ColourMapType::Plasma;
+            bool two_d = false;
+            float hue = 0.0f;
+            float hue2 = 0.0f;
+            float sat = 0.0f;
+            float val = 0.0f;
+            double hue_rotation = 0.0;
+            bool hue_reverse_direction = false;
+            auto operator<=> (const lut_key&) const = default;
+        };
+
+        /*!
+         * Return the lookup table for key k, calling make to compute it if it is not already held.
+         * Tables are shared by every ColourMap<T> with the same settings, so that a ColourMap that
+         * is constructed for a single conversion (as in VectorVisual) does not pay to bake its
+         * table each time.
+         */
+        template <typename F>
+        static std::shared_ptr<const lut_type> cached_lut (const lut_key& k, F&& make)
+        {
+            static std::mutex cache_mutex;
+            static std::map<lut_key, std::shared_ptr<const lut_type>> cache;
+            std::lock_guard<std::mutex> lk (cache_mutex);
+            auto ci = cache.find (k);
+            if (ci != cache.end()) { return ci->second; }
+            // Bound the memory used by clients that sweep hue (for example) through many values
+            if (cache.size() >= 32) { cache.clear(); }
+            auto lut = std::make_shared<const lut_type> (make());
+            cache.emplace (k, lut);
+            return lut;
+        }
+
+        /*!
+         * Bake the colours of a procedural map into lut1d (and/or lut2d) so that convert runs at
+         * the speed of a table lookup. Called whenever the type or a colour parameter changes.
+         */
+        void bake_luts()
+        {
+            lut_key k;
+            k.type = this->type;
+            k.hue = this->hue;
+            k.hue2 = this->hue2;
+            k.sat = this->sat;
+            k.val = this->val;
+            k.hue_rotation = static_cast<double>(this->hue_rotation);
+            k.hue_reverse_direction = this->hue_reverse_direction;
+
+            this->lut1d.reset();
+            if (ColourMap<T>::procedural_1d (this->type)) {
+                this->lut1d = ColourMap<T>::cached_lut (k, [this]() {
+                    lut_type lut (lut_size);
+                    for (std::size_t i = 0; i < lut_size; ++i) {
+                        lut[i] = this->compute (static_cast<float>(i) / static_cast<float>(lut_size - 1));
+                    }
+                    return lut;
+                });
+            }
+
+            this->lut2d.reset();
+            k.two_d = true;
+            if (this->act_2d == true && ColourMap<T>::numDatums (this->type) == 1) {
+                // A 2D table over (datum, saturation) for convertWithSaturation
+                this->lut2d = ColourMap<T>::cached_lut (k, [this]() {
+                    lut_type lut (lut2d_size * lut2d_size);
+                    for (std::size_t j = 0; j < lut2d_size; ++j) {
+                        const float s = static_cast<float>(j) / static_cast<float>(lut2d_size - 1);
+                        for (std::size_t i = 0; i < lut2d_size; ++i) {
+                            const float d = static_cast<float>(i) / static_cast<float>(lut2d_size - 1);
+                            const std::array<float, 3> c = this->compute (d);
+                            std::array<float, 3> hsv = ColourMap<T>::rgb2hsv (c);
+                            hsv[1] *= s;
+                            lut[j * lut2d_size + i] = ColourMap<T>::hsv2rgb (hsv);
+                        }
+                    }
+                    return lut;
+                });
+            } else if constexpr (std::is_floating_point<std::decay_t<T>>::value == true) {
+                if (ColourMap<T>::procedural_2d (this->type)) {
+                    this->lut2d = ColourMap<T>::cached_lut (k, [this]() {
+                        lut_type lut (lut2d_size * lut2d_size);
+                        for (std::size_t j = 0; j < lut2d_size; ++j) {
+                            const T y = static_cast<T>(j) / static_cast<T>(lut2d_size - 1);
+                            for (std::size_t i = 0; i < lut2d_size; ++i) {
+                                const T x = static_cast<T>(i) / static_cast<T>(lut2d_size - 1);
+                                lut[j * lut2d_size + i] = this->compute (x, y);
+                            }
+                        }
+                        return lut;
+                    });
+                }
+            }
+        }
+
+        //! Bilinearly interpolate a colour from lut2d. x and y must lie in [0, 1].
+        std::array<float, 3> lut2d_lookup (const float x, const float y) const
+        {
+            constexpr float top = static_cast<float>(lut2d_size - 1);
+            const float fx = x * top;
+            const float fy = y * top;
+            const std::size_t i0 = std::min (static_cast<std::size_t>(fx), lut2d_size - 2);
+            const std::size_t j0 = std::min (static_cast<std::size_t>(fy), lut2d_size - 2);
+            const float ax = fx - static_cast<float>(i0);
+            const float ay = fy - static_cast<float>(j0);
+            const lut_type& lut = *this->lut2d;
+            const std::array<float, 3>& c00 = lut[j0 * lut2d_size + i0];
+            const std::array<float, 3>& c10 = lut[j0 * lut2d_size + i0 + 1];
+            const std::array<float, 3>& c01 = lut[(j0 + 1) * lut2d_size + i0];
+            const std::array<float, 3>& c11 = lut[(j0 + 1) * lut2d_size + i0 + 1];
+            std::array<float, 3> c;
+            for (std::size_t k = 0; k < 3; ++k) {
+                c[k] = (1.0f - ay) * ((1.0f - ax) * c00[k] + ax * c10[k]) + ay * ((1.0f - ax) * c01[k] + ax * c11[k]);
+            }
+            return c;
+        }
+
         /*!
          * @param datum gray value from 0.0 to 1.0
          *
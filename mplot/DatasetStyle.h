@@ -54,6 +54,13 @@ namespace mplot {
         std::array<float, 3> linecolour = mplot::colour::black;
         //! Width of lines between data points
         float linewidth = 0.007f;
+        //! Length of the dashes of a dashed line, in model units. 0 for solid lines. Dashes are only
+        //! drawn by GraphVisual's GPU lines (see GraphVisual::gpu_lines).
+        float linedash = 0.0f;
+        //! Length of the gaps between dashes
+        float linedashgap = 0.0f;
+        //! How segments of the line join (GPU lines only)
+        mplot::linejoin linejoin = mplot::linejoin::miter;
         //! Label for the dataset's legend
         std::string datalabel = "";
         //! Which y axis of a twinax graph should these data relate to?
@@ -78,6 +78,36 @@ namespace mplot {
             }
         }
 
+        //! Increment whenever the vertices made by initializeVertices() change
+        static constexpr uint32_t vertex_generator_version = 1u;
+
+        //! The geodesic's vertices are initially coloured with cm.convert(0), so data isn't hashed
+        uint64_t vertex_cache_key() override
+        {
+            mplot::vertexcache::hasher hh;
+            hh.add_generator ("GeodesicVisual", vertex_generator_version);
+            hh.add (this->iterations);
+            hh.add (this->radius);
+            hh.add (this->colourFaces);
+            hh.add_colourmap (this->cm);
+            return hh.value();
+        }
+
+        void vertex_cache_save_extra (std::ostream& os) override
+        {
+            os.write (reinterpret_cast<const char*>(&this->n_verts), sizeof (this->n_verts));
+            os.write (reinterpret_cast<const char*>(&this->n_faces), sizeof (this->n_faces));
+        }
+
+        bool vertex_cache_load_extra (std::istream& is) override
+        {
+            is.read (reinterpret_cast<char*>(&this->n_verts), sizeof (this->n_verts));
+            is.read (reinterpret_cast<char*>(&this->n_faces), sizeof (this->n_faces));
+            if (!is) { return false; }
+            this->data.resize (this->colourFaces ? this->n_faces : this->n_verts, T{0});
+            return true;
+        }
+
         sm::vvec<sm::vec<float>> cart_centres;
         sm::vvec<sm::vec<float>> sph_centres;
         void vertexPositionsToFaces()
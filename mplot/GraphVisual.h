@@ -14,6 +14,12 @@
 #include <sstream>
 #include <memory>
 #include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <numeric>
+#include <atomic>
+#include <thread>
 
 #include <sm/mathconst>
 #include <sm/scale>
@@ -32,6 +38,7 @@
 #include <mplot/graphstyles.h>
 #include <mplot/ColourMap.h>
 #include <mplot/DatasetStyle.h>
+#include <mplot/decimate.h>
 #include <mplot/VisualTextModel.h>
 
 namespace mplot {
@@ -62,12 +69,22 @@ namespace mplot {
         //! graphDataCoords. Finish up with a call to completeAppend(). didx is the data
         //! index and counts up from 0. Have to save _abscissa and _ordinate in a local
         //! copy of the data to be able to rescale.
+        //!
+        //! Unless the axes have to be rescaled, or a new dataset is begun, only the vertices for
+        //! the new datum are made (in render()) and only those are uploaded to the GPU, so the
+        //! cost of an append does not grow with the number of points already in the graph.
         void append (const Flt& _abscissa, const Flt& _ordinate, const unsigned int didx)
         {
+            if (this->scroll_capacity > 0) {
+                this->scroll_append (_abscissa, _ordinate, didx);
+                return;
+            }
             this->pendingAppended = true;
+            // datastyles may be cleared below, so note which axis this dataset is plotted against
+            const mplot::axisside axisside = this->datastyles[didx].axisside;
             // Transfor the data into temporary containers sd and ad
             Flt o = Flt{0};
-            if (this->datastyles[didx].axisside == mplot::axisside::left) {
+            if (axisside == mplot::axisside::left) {
                 this->ord1.push_back (_ordinate);
                 this->absc1.push_back (_abscissa);
                 try {
@@ -97,17 +114,20 @@ namespace mplot {
 
             // Now sd and ad can be used to construct dataCoords x/y. They are used to
             // set the position of each datum into dataCoords
+            bool new_dataset = false;
             if (graphDataCoords.size() < didx + 1) {
                 // Need to add an additional graphDataCoords to receive data. This can occur after
                 // appending the first data point of a first dataset and then appending the first
                 // data point of a second dataset to an otherwise empty graph.
                 this->graphDataCoords.push_back (std::make_unique<std::vector<sm::vec<float>>>(0u, sm::vec<float>{0,0,0}));
                 // As well as creating a new, empty graphDataCoords, we have to add the right datastyle
-                if (this->datastyles[didx].axisside == mplot::axisside::left) {
+                if (axisside == mplot::axisside::left) {
                     this->datastyles.push_back (this->ds_ord1);
                 } else {
                     this->datastyles.push_back (this->ds_ord2);
                 }
+                // A new dataset (and its legend entry) needs the whole model to be re-built
+                new_dataset = true;
             }
 
             unsigned int oldsz = this->graphDataCoords[didx]->size();
@@ -122,7 +142,7 @@ namespace mplot {
 
             // check y axis
             if (this->auto_rescale_y) {
-                if (this->datastyles[didx].axisside == mplot::axisside::left) {
+                if (axisside == mplot::axisside::left) {
                     redraw_plot += yrange.update (this->ord1.back()) ? 1 : 0;
                 } else {
                     redraw_plot += y2range.update (this->ord2.back()) ? 1 : 0;
@@ -135,11 +155,12 @@ namespace mplot {
 
                 // setdata or this function will re-add these
                 this->graphDataCoords.clear();
+                this->pyramids.clear();
                 this->datastyles.clear();
 
                 this->pendingAppended = true; // as the graph will be re-drawn
                 if (didx == 0) { this->abscissa_scale.reset(); }
-                if (this->datastyles[didx].axisside == mplot::axisside::left) {
+                if (axisside == mplot::axisside::left) {
                     this->ord1_scale.reset();
                 } else {
                     this->ord2_scale.reset();
@@ -155,8 +176,12 @@ namespace mplot {
                 }
             }
 
-            VisualModel<glver>::clear(); // Get rid of the vertices.
-            this->initializeVertices(); // Re-build
+            if (redraw_plot > 0 || new_dataset) {
+                VisualModel<glver>::clear(); // Get rid of the vertices.
+                this->initializeVertices(); // Re-build
+                this->pendingRebuild = true;
+            }
+            // Otherwise, render() adds the vertices for the new datum with drawAppendedData()
         }
 
         //! Before calling the base class's render method, check if we have any pending data
@@ -164,10 +189,23 @@ namespace mplot {
         {
             if (this->pendingAppended == true) {
                 // After adding to graphDataCoords, we have to create the new OpenGL
-                // vertices (CPU side) and update the OpenGL buffers.
+                // vertices (CPU side) and update the OpenGL buffers. Unless the graph was rebuilt,
+                // only the vertices and indices that drawAppendedData adds need to be uploaded.
+                const std::size_t first_vertex = this->vertexPositions.size() / 3;
+                const std::size_t first_index = this->indices.size();
                 this->drawAppendedData();
-                this->reinit_buffers();
+                if (this->pendingRebuild == true) {
+                    this->reinit_buffers();
+                } else {
+                    this->reinit_appended_buffers (first_vertex, first_index);
+                }
                 this->pendingAppended = false;
+                this->pendingRebuild = false;
+            }
+            if (!this->scroll_dirty.empty()) {
+                // Upload the positions of the scrolling samples that have changed since the last render
+                this->reinit_buffer_ranges (this->scroll_dirty, true, false, false);
+                this->scroll_dirty.clear();
             }
             // Now do the usual drawing stuff from VisualModel:
             VisualModel<glver>::render();
@@ -180,19 +218,21 @@ namespace mplot {
             for (unsigned int i = 0; i < dsize; ++i) {
                 this->graphDataCoords[i]->clear();
             }
+            this->pyramids.clear();
             this->reinit();
         }
 
-        //! Update the data for the graph, recomputing the vertices when done.
+        /*!
+         * Update the data for the graph, recomputing the vertices when done. Ctnr2 may not be a
+         * container of containers, so that update (x, ys, {2u}) calls the many-dataset update().
+         */
         template <typename Ctnr1, typename Ctnr2>
         std::enable_if_t<sm::is_copyable_container<Ctnr1>::value
-                         && sm::is_copyable_container<Ctnr2>::value, void>
+                         && sm::is_copyable_container<Ctnr2>::value
+                         && !sm::is_copyable_container<typename Ctnr2::value_type>::value, void>
         update (const Ctnr1& _abscissae, const Ctnr2& _data, const unsigned int data_idx)
         {
-            unsigned int dsize = _data.size();
-            sm::range<Flt> datarange;
-
-            if (_abscissae.size() != dsize) {
+            if (_abscissae.size() != _data.size()) {
                 throw std::runtime_error ("GraphVisual::update: size mismatch");
             }
 
@@ -201,72 +241,56 @@ namespace mplot {
                 return;
             }
 
-            // Ensure the vector at data_idx has enough capacity for the updated data
-            this->graphDataCoords[data_idx]->resize (dsize);
-
-            // Are we auto-rescaling the x axis?
-            if (this->auto_rescale_x) {
-                this->abscissa_scale.reset();
-                datarange = this->datarange_x;
-                for (auto x_val : _abscissae) { datarange.update (x_val); }
-                this->setlimits_x (datarange, true);
-                this->abscissa_scale.compute_scaling (this->datarange_x);
-            }
-
-            // Transform the data into temporary containers sd and ad. Note call of
-            // abscissa_scale.transform comes AFTER the auto_rescale_x logic
-            std::vector<Flt> ad (dsize, Flt{0});
-            this->abscissa_scale.transform (_abscissae, ad);
-
-            std::vector<Flt> sd (dsize, Flt{0});
-            if (this->datastyles[data_idx].axisside == mplot::axisside::left) {
-                // check min and max of the y axis
-                if (this->auto_rescale_y && this->auto_rescale_fit) {
-                    this->ord1_scale.reset();
-                    // Find the data range in _data and setlimits_y accordingly
-                    datarange.search_init();
-                    for (auto y_val : _data) { datarange.update (y_val); }
-                    this->setlimits_y (datarange, true);
-                    this->ord1_scale.compute_scaling (this->datarange_y);
+            this->update_datasets (std::vector<const Ctnr1*>{ &_abscissae }, std::vector<const Ctnr2*>{ &_data },
+                                   std::vector<unsigned int>{ data_idx });
+        }
 
-                } else if (this->auto_rescale_y) {
-                    this->ord1_scale.reset();
-                    // Starting with datarange_y, update datarange.
-                    datarange = this->datarange_y;
-                    for (auto y_val : _data) { datarange.update (y_val); }
-                    this->setlimits_y (datarange, true);
-                    this->ord1_scale.compute_scaling (this->datarange_y);
+        /*!
+         * Update several datasets at once: dataset data_idx[k] is replaced by the data _data[k] at
+         * the abscissae _abscissae[k]. The axis ranges are found from all the new data together
+         * (so with auto_rescale_fit, each y axis fits all the updated datasets that relate to it)
+         * and the graph is rebuilt just once, rather than once per dataset. The data of large
+         * updates are scaled on up to dataset_threads threads.
+         */
+        template <typename Ctnr1, typename Ctnr2>
+        requires (sm::is_copyable_container<Ctnr1>::value && sm::is_copyable_container<Ctnr2>::value)
+        void update (const std::vector<Ctnr1>& _abscissae, const std::vector<Ctnr2>& _data,
+                     const std::vector<unsigned int>& data_idx)
+        {
+            if (_abscissae.size() != data_idx.size() || _data.size() != data_idx.size()) {
+                throw std::runtime_error ("GraphVisual::update: Pass abscissae and data for each dataset index");
+            }
+            std::vector<const Ctnr1*> absc (data_idx.size(), nullptr);
+            std::vector<const Ctnr2*> dat (data_idx.size(), nullptr);
+            std::vector<bool> seen (this->graphDataCoords.size(), false);
+            for (std::size_t k = 0; k < data_idx.size(); ++k) {
+                if (data_idx[k] >= this->graphDataCoords.size()) {
+                    throw std::runtime_error ("GraphVisual::update: No dataset at index " + std::to_string (data_idx[k]));
                 }
-                // scale data with the axis
-                this->ord1_scale.transform (_data, sd);
-            } else {
-                // Similar to the above, for the y2 axis
-                if (this->auto_rescale_y && this->auto_rescale_fit) {
-                    this->ord2_scale.reset();
-                    datarange.search_init();
-                    for (auto y_val : _data) { datarange.update (y_val); }
-                    this->setlimits_y2 (datarange, true);
-                    this->ord2_scale.compute_scaling (this->datarange_y2);
-
-                } else if (this->auto_rescale_y) {
-                    this->ord2_scale.reset();
-                    datarange = this->datarange_y2;
-                    for (auto y_val : _data) { datarange.update (y_val); }
-                    this->setlimits_y2 (datarange, true);
-                    this->ord2_scale.compute_scaling (this->datarange_y2);
+                if (seen[data_idx[k]]) {
+                    throw std::runtime_error ("GraphVisual::update: Dataset " + std::to_string (data_idx[k]) + " is updated twice");
+                }
+                seen[data_idx[k]] = true;
+                if (_abscissae[k].size() != _data[k].size()) {
+                    throw std::runtime_error ("GraphVisual::update: size mismatch");
                 }
-                // scale data with the axis
-                this->ord2_scale.transform (_data, sd);
+                absc[k] = &_abscissae[k];
+                dat[k] = &_data[k];
             }
+            this->update_datasets (absc, dat, data_idx);
+        }
 
-            // Now sd and ad can be used to construct dataCoords x/y. They are used to
-            // set the position of each datum into dataCoords
-            for (unsigned int i = 0; i < dsize; ++i) {
-                this->graphDataCoords[data_idx].get()->at(i) = sm::vec<float>{ static_cast<float>(ad[i]), static_cast<float>(sd[i]), float{0} };
+        //! Update every dataset at once. _data[i] (at _abscissae[i]) replaces dataset i.
+        template <typename Ctnr1, typename Ctnr2>
+        requires (sm::is_copyable_container<Ctnr1>::value && sm::is_copyable_container<Ctnr2>::value)
+        void update (const std::vector<Ctnr1>& _abscissae, const std::vector<Ctnr2>& _data)
+        {
+            if (_data.size() != this->graphDataCoords.size()) {
+                throw std::runtime_error ("GraphVisual::update: Pass data for every dataset (or pass dataset indices)");
             }
-
-            this->clearTexts(); // VisualModel::clearTexts()
-            this->reinit();
+            std::vector<unsigned int> data_idx (_data.size(), 0u);
+            std::iota (data_idx.begin(), data_idx.end(), 0u);
+            this->update (_abscissae, _data, data_idx);
         }
 
         //! update() overload that accepts vvec of coords
@@ -1000,6 +1024,50 @@ namespace mplot {
             this->resetsize (this->width, this->height);
         }
 
+        /*!
+         * Make this a scrolling (oscilloscope) graph, which shows the latest samples of each
+         * dataset, appended with append(), against a fixed x axis. Each dataset keeps at most
+         * n_samples samples. The x axis shows the time before the latest sample, so set the x limits
+         * to the window that you want to see; with setlimits_x (-5, 0) the graph shows the last 5
+         * units of abscissa. Samples that are older than the window are hidden.
+         *
+         * The samples are held in a ring of n_samples fixed-size slots of vertices. Appending a
+         * sample rewrites one or two slots, and the graph is scrolled by translating the slots
+         * when they are rendered, so appending costs the same however long the graph has been
+         * running. The axes are never rebuilt, so auto_rescale_x and auto_rescale_y are ignored.
+         *
+         * Call before setdata/prepdata. Bar and quiver datasets can't scroll.
+         */
+        void setscrolling (const unsigned int n_samples)
+        {
+            if (!this->graphDataCoords.empty()) {
+                throw std::runtime_error ("GraphVisual::setscrolling: Call this function *before* using setdata/prepdata");
+            }
+            if (n_samples < 2) {
+                throw std::runtime_error ("GraphVisual::setscrolling: A scrolling graph needs room for at least 2 samples");
+            }
+            this->scroll_capacity = n_samples;
+        }
+
+        /*!
+         * Apply changes that have been made to the line styles in datastyles (linecolour,
+         * linewidth, linedash, linedashgap, linejoin and markergap). With gpu_lines, only the
+         * uniforms passed to the line shader change, so the graph is not rebuilt and nothing is
+         * uploaded. Otherwise, the graph is rebuilt.
+         */
+        void update_linestyles()
+        {
+            if (this->gpu_lines == false) {
+                this->reinit();
+                return;
+            }
+            for (std::size_t dsi = 0; dsi < this->dataset_polylines.size() && dsi < this->datastyles.size(); ++dsi) {
+                for (std::size_t pli : this->dataset_polylines[dsi]) {
+                    this->style_polyline (this->polylines[pli], this->datastyles[dsi]);
+                }
+            }
+        }
+
         //! Set the 'object thickness' attribute (maybe used just for 'object spacing')
         void setthickness (float th) { this->relative_thickness = th; }
 
@@ -1016,8 +1084,20 @@ namespace mplot {
         //! points are in each graph curve
         std::vector<unsigned int> coords_lengths;
 
+        //! The length of each entry in graphDataCoords when the graph was last built by drawData()
+        std::vector<unsigned int> built_lengths;
+
+        //! Min/max pyramids for the decimation of large datasets (one per graphDataCoords entry)
+        std::vector<mplot::decimate::minmax_pyramid> pyramids;
+
+        //! With gpu_lines, the indices in VisualModel::polylines of the lines of each dataset
+        std::vector<std::vector<std::size_t>> dataset_polylines;
+
         //! Is there pending appended data that needs to be converted into OpenGL shapes?
         bool pendingAppended = false;
+        //! Has the graph been rebuilt since the buffers were last uploaded, so that all of the
+        //! buffers (rather than just the appended vertices) must be uploaded?
+        bool pendingRebuild = false;
 
         //! Compute stuff for a graph
         void initializeVertices()
@@ -1029,6 +1109,8 @@ namespace mplot {
             if (this->legend == true) { this->drawLegend(); }
             this->drawTickLabels(); // from which we can store the tick label widths
             this->drawAxisLabels();
+            // Scrolling data goes last, as it's drawn with an offset from scroll_first_index onwards
+            this->drawScrollData();
         }
 
         //! Is the passed in coordinate within the graph axes (in the x/y sense, ignoring z)?
@@ -1048,6 +1130,13 @@ namespace mplot {
 
         //! dsi: data set iterator
         void drawDataCommon (unsigned int dsi, unsigned int coords_start, unsigned int coords_end, bool appending = false)
+        {
+            this->drawMarkers (dsi, *this->graphDataCoords[dsi], coords_start, coords_end);
+            this->drawLines (dsi, *this->graphDataCoords[dsi], coords_start, coords_end, appending);
+        }
+
+        //! Draw the markers for coords[coords_start] to coords[coords_end - 1] in the style of dataset dsi
+        void drawMarkers (unsigned int dsi, std::vector<sm::vec<float>>& coords, unsigned int coords_start, unsigned int coords_end)
         {
             // Draw data markers
             if (this->datastyles[dsi].markerstyle != markerstyle::none) {
@@ -1055,14 +1144,14 @@ namespace mplot {
                 if (this->datastyles[dsi].markerstyle == markerstyle::bar) { // Data markers are bars
 
                     for (unsigned int i = coords_start; i < coords_end; ++i) {
-                        this->bar ((*this->graphDataCoords[dsi])[i], this->datastyles[dsi]);
+                        this->bar (coords[i], this->datastyles[dsi]);
                     }
 
                 } else if (this->datastyles[dsi].markerstyle == markerstyle::quiver) { // Markers are quivers
 
                     // Check quivers exist and then proceed with code adapted from mplot::QuiverVisual
                     uint64_t nquiv = this->quivers.size();
-                    if ((*this->graphDataCoords[dsi]).size() == nquiv) {
+                    if (coords.size() == nquiv) {
 
                         // Prepare scaling functions
                         if (!this->quiver_colour_scale.ready()) { this->quiver_colour_scale.do_autoscale = true; }
@@ -1107,25 +1196,34 @@ namespace mplot {
                             throw std::runtime_error ("GraphVisual::drawDataCommon: coords_end is off the end of quivers");
                         }
                         for (unsigned int i = coords_start; i < coords_end; ++i) {
-                            this->quiver ((*this->graphDataCoords[dsi])[i], final_quivers[i], colour_qlengths[i], this->datastyles[dsi]);
+                            this->quiver (coords[i], final_quivers[i], colour_qlengths[i], this->datastyles[dsi]);
                         }
 
                     } else {
-                        std::cout << "(*this->graphDataCoords[dsi]).size() = "  << (*this->graphDataCoords[dsi]).size()
+                        std::cout << "Number of coordinates "  << coords.size()
                                   << " does not match quivers size: " << quivers.size() << std::endl;
                     }
 
                 } else { // Regular data markers
 
                     for (unsigned int i = coords_start; i < coords_end; ++i) {
-                        if (this->within_axes ((*this->graphDataCoords[dsi])[i])) {
-                            this->marker ((*this->graphDataCoords[dsi])[i], this->datastyles[dsi]);
+                        if (this->within_axes (coords[i])) {
+                            this->marker (coords[i], this->datastyles[dsi]);
                         } // else marker is outside graph axes so don't draw it
                     }
                 }
             }
+        }
+
+        //! Draw the lines between coords[coords_start] and coords[coords_end - 1] in the style of
+        //! dataset dsi. If appending, the line from coords[coords_start - 1] is drawn, too.
+        void drawLines (unsigned int dsi, std::vector<sm::vec<float>>& coords, unsigned int coords_start, unsigned int coords_end,
+                        bool appending = false)
+        {
             if (this->datastyles[dsi].markerstyle == markerstyle::bar && this->datastyles[dsi].showlines == true) {
                 // No need to do anything, lines will have been drawn by GraphVisual::bar()
+            } else if (this->datastyles[dsi].showlines == true && this->gpu_lines == true) {
+                this->drawPolylines (dsi, coords, coords_start, coords_end, appending);
             } else if (this->datastyles[dsi].showlines == true) {
 
                 // If appending markers to a dataset, need to add the line preceding the first marker
@@ -1134,21 +1232,21 @@ namespace mplot {
                 for (unsigned int i = coords_start+1; i < coords_end; ++i) {
                     // Draw tube from location -1 to location 0.
                     if (this->draw_beyond_axes == true
-                        || (this->within_axes ((*this->graphDataCoords[dsi])[i-1])
-                            && this->within_axes ((*this->graphDataCoords[dsi])[i]))) {
+                        || (this->within_axes (coords[i-1])
+                            && this->within_axes (coords[i]))) {
 
                         if (this->datastyles[dsi].markergap > 0.0f) {
-                            auto point_to_point = (*this->graphDataCoords[dsi])[i] - (*this->graphDataCoords[dsi])[i-1];
+                            auto point_to_point = coords[i] - coords[i-1];
                             if (point_to_point.length() > this->datastyles[dsi].markergap * 2.0f) {
                                 // Draw solid lines between marker points with gaps between line and marker
-                                this->computeFlatLine ((*this->graphDataCoords[dsi])[i-1], (*this->graphDataCoords[dsi])[i], this->uz,
+                                this->computeFlatLine (coords[i-1], coords[i], this->uz,
                                                        this->datastyles[dsi].linecolour,
                                                        this->datastyles[dsi].linewidth, this->datastyles[dsi].markergap);
                             }
                         } else if (appending == true) {
                             // We are appending a line to an existing graph, so compute a single line with rounded ends
-                            this->computeFlatLineRnd ((*this->graphDataCoords[dsi])[i-1], // start
-                                                      (*this->graphDataCoords[dsi])[i],   // end
+                            this->computeFlatLineRnd (coords[i-1], // start
+                                                      coords[i],   // end
                                                       this->uz,
                                                       this->datastyles[dsi].linecolour,
                                                       this->datastyles[dsi].linewidth, 0.0f, true, false);
@@ -1160,30 +1258,30 @@ namespace mplot {
                             // and draw the alt colour (which may be bg colour) between the dashes.
                             if (i == 1+coords_start && (coords_end-coords_start)==2) {
                                 // First and only line
-                                this->computeFlatLine ((*this->graphDataCoords[dsi])[i-1], // start
-                                                       (*this->graphDataCoords[dsi])[i],   // end
+                                this->computeFlatLine (coords[i-1], // start
+                                                       coords[i],   // end
                                                        this->uz,
                                                        this->datastyles[dsi].linecolour,
                                                        this->datastyles[dsi].linewidth);
                             } else if (i == 1+coords_start) {
                                 // First line
-                                this->computeFlatLineN ((*this->graphDataCoords[dsi])[i-1], // start
-                                                        (*this->graphDataCoords[dsi])[i],   // end
-                                                        (*this->graphDataCoords[dsi])[i+1], // next
+                                this->computeFlatLineN (coords[i-1], // start
+                                                        coords[i],   // end
+                                                        coords[i+1], // next
                                                         this->uz,
                                                         this->datastyles[dsi].linecolour,
                                                         this->datastyles[dsi].linewidth);
                             } else if (i == (coords_end-1)) {
                                 // last line
-                                this->computeFlatLineP ((*this->graphDataCoords[dsi])[i-1], (*this->graphDataCoords[dsi])[i],
-                                                        (*this->graphDataCoords[dsi])[i-2],
+                                this->computeFlatLineP (coords[i-1], coords[i],
+                                                        coords[i-2],
                                                         this->uz,
                                                         this->datastyles[dsi].linecolour,
                                                         this->datastyles[dsi].linewidth);
                             } else {
                                 // An intermediate line
-                                this->computeFlatLine ((*this->graphDataCoords[dsi])[i-1], (*this->graphDataCoords[dsi])[i],
-                                                       (*this->graphDataCoords[dsi])[i-2], (*this->graphDataCoords[dsi])[i+1],
+                                this->computeFlatLine (coords[i-1], coords[i],
+                                                       coords[i-2], coords[i+1],
                                                        this->uz,
                                                        this->datastyles[dsi].linecolour,
                                                        this->datastyles[dsi].linewidth);
@@ -1195,12 +1293,80 @@ namespace mplot {
             }
         }
 
+        /*!
+         * Add coords[coords_start] to coords[coords_end - 1] to the polylines of dataset dsi, to be
+         * drawn by the GPU line shader. Each run of points within the axes makes one polyline (or
+         * all the points make one, if draw_beyond_axes is set). If appending, the points continue
+         * the dataset's last polyline, if that ended at coords[coords_start - 1].
+         */
+        void drawPolylines (unsigned int dsi, std::vector<sm::vec<float>>& coords, unsigned int coords_start, unsigned int coords_end,
+                            bool appending = false)
+        {
+            if (this->dataset_polylines.size() <= dsi) { this->dataset_polylines.resize (dsi + 1); }
+            std::vector<std::size_t>& dspl = this->dataset_polylines[dsi];
+
+            // The polyline that points are being added to, if any
+            std::size_t pli = std::numeric_limits<std::size_t>::max();
+            if (appending == true && coords_start > 0 && !dspl.empty()
+                && (this->draw_beyond_axes == true || this->within_axes (coords[coords_start - 1]))) {
+                pli = dspl.back();
+            }
+
+            for (unsigned int i = coords_start; i < coords_end; ++i) {
+                if (this->draw_beyond_axes == false && this->within_axes (coords[i]) == false) {
+                    // The line breaks at points outside the axes
+                    pli = std::numeric_limits<std::size_t>::max();
+                    continue;
+                }
+                if (pli == std::numeric_limits<std::size_t>::max()) {
+                    pli = this->polylines.size();
+                    this->polylines.emplace_back();
+                    this->polylines.back().z = coords[i][2];
+                    this->style_polyline (this->polylines.back(), this->datastyles[dsi]);
+                    dspl.push_back (pli);
+                }
+                this->polylines[pli].push_back (coords[i][0], coords[i][1]);
+            }
+        }
+
+        //! Set the width, colour, dashes and joins of the polyline pl from the DatasetStyle ds
+        static void style_polyline (mplot::visgl::polyline& pl, const mplot::DatasetStyle& ds)
+        {
+            pl.colour = ds.linecolour;
+            pl.width = ds.linewidth;
+            pl.dash = ds.linedash;
+            pl.dashgap = ds.linedashgap;
+            pl.round = ds.linejoin == mplot::linejoin::round;
+            // As for the CPU-drawn lines, a markergap means unjoined segments with gaps at the markers
+            pl.shorten = ds.markergap;
+        }
+
         // Defines a boolean 'true' that can be provided as arg to drawDataCommon()
         static constexpr bool appending_data = true;
 
-        //! Draw markers and lines for data points that are being appended to a graph
+        /*!
+         * Draw markers and lines for data points that are being appended to a graph. Appended
+         * points are drawn in full, so once more than decimation_columns points have been appended
+         * to a decimated dataset since the graph was built, the graph is rebuilt instead, which
+         * decimates the lines and markers of all the data again.
+         */
         void drawAppendedData()
         {
+            if (this->coords_lengths.size() < this->graphDataCoords.size()) {
+                this->coords_lengths.resize (this->graphDataCoords.size(), 0u);
+            }
+            if (this->built_lengths.size() < this->graphDataCoords.size()) {
+                this->built_lengths.resize (this->graphDataCoords.size(), 0u);
+            }
+            for (unsigned int dsi = 0; dsi < this->graphDataCoords.size(); ++dsi) {
+                const std::size_t tail = this->graphDataCoords[dsi]->size() - this->built_lengths[dsi];
+                if (tail > this->decimation_columns && this->decimates (dsi)) {
+                    VisualModel<glver>::clear();
+                    this->initializeVertices();
+                    this->pendingRebuild = true;
+                    return;
+                }
+            }
             for (unsigned int dsi = 0; dsi < this->graphDataCoords.size(); ++dsi) {
                 // Start is old end:
                 unsigned int coords_start = this->coords_lengths[dsi];
@@ -1210,16 +1376,452 @@ namespace mplot {
             }
         }
 
+        /*
+         * Scrolling graphs. Sample k of dataset dsi is held in slot k % scroll_capacity of the
+         * dataset's ring. Each slot has the same number of vertices: those of the line from sample
+         * k to sample k+1 and those of sample k's marker. Empty slots (and the line from the
+         * latest sample) have all of their vertices at one point, so they draw nothing.
+         */
+
+        //! Where the vertices of a scrolling dataset's ring of slots are, and how big each slot is
+        struct scroll_layout
+        {
+            std::size_t v0 = 0;
+            std::size_t i0 = 0;
+            std::size_t nv = 0;
+            std::size_t ni = 0;
+        };
+
+        //! The number of samples kept for each dataset of a scrolling graph. 0 if not scrolling.
+        unsigned int scroll_capacity = 0;
+        //! For each dataset, the ring of sample abscissae and their positions in model coordinates
+        std::vector<std::vector<Flt>> scroll_absc;
+        std::vector<std::vector<sm::vec<float>>> scroll_coords;
+        //! For each dataset, the number of samples appended and the index of the oldest shown
+        std::vector<std::size_t> scroll_count;
+        std::vector<std::size_t> scroll_oldest;
+        std::vector<scroll_layout> scroll_layouts;
+        //! Sample positions are relative to abscissa scroll_t0; the latest abscissa is scroll_tnow
+        Flt scroll_t0 = Flt{0};
+        Flt scroll_tnow = Flt{0};
+        bool scroll_started = false;
+        //! Ranges of vertices that have changed since the last render
+        std::vector<std::array<std::size_t, 2>> scroll_dirty;
+
+        static constexpr std::size_t no_sample = std::numeric_limits<std::size_t>::max();
+
+        //! Is sample k of dataset dsi one that is shown?
+        bool scroll_shown (const unsigned int dsi, const std::size_t k) const
+        {
+            return k != no_sample && k >= this->scroll_oldest[dsi] && k < this->scroll_count[dsi];
+        }
+
+        //! Push the vertices for slot k (the line from sample k to k+1 and sample k's marker)
+        void scroll_geometry (const unsigned int dsi, const std::size_t k)
+        {
+            const DatasetStyle& st = this->datastyles[dsi];
+            const bool shown = this->scroll_shown (dsi, k);
+            const sm::vec<float> p = shown ? this->scroll_coords[dsi][k % this->scroll_capacity] : sm::vec<float>{0.0f, 0.0f, 0.0f};
+            // Collapse the vertices from v_first to the end onto p, so that they draw nothing
+            auto collapse = [this, p](std::size_t v_first)
+            {
+                for (std::size_t i = 3 * v_first; i < this->vertexPositions.size(); i += 3) {
+                    this->vertexPositions[i] = p[0];
+                    this->vertexPositions[i + 1] = p[1];
+                    this->vertexPositions[i + 2] = p[2];
+                }
+            };
+            if (st.showlines == true) {
+                const std::size_t v_first = this->vertexPositions.size() / 3;
+                const bool has_next = shown && this->scroll_shown (dsi, k + 1);
+                const sm::vec<float> q = has_next ? this->scroll_coords[dsi][(k + 1) % this->scroll_capacity] : p + this->ux;
+                // A zero length line has no direction, so it can't be drawn
+                const bool has_line = has_next && (q - p).length() > 0.0f;
+                this->computeFlatLineRnd (p, q, this->uz, st.linecolour, st.linewidth, 0.0f, true, false);
+                if (!has_line) { collapse (v_first); }
+            }
+            if (st.markerstyle != markerstyle::none) {
+                const std::size_t v_first = this->vertexPositions.size() / 3;
+                sm::vec<float> pm = p;
+                this->marker (pm, st);
+                if (!shown) { collapse (v_first); }
+            }
+        }
+
+        //! Lay out the rings of slots for the datasets of a scrolling graph, after all other vertices
+        void drawScrollData()
+        {
+            this->scroll_first_index = std::numeric_limits<std::size_t>::max();
+            this->scroll_dirty.clear();
+            if (this->scroll_capacity == 0) { return; }
+
+            const std::size_t nds = this->graphDataCoords.size();
+            this->scroll_resize (nds);
+            this->scroll_layouts.resize (nds);
+            this->scroll_first_index = this->indices.size();
+            const std::size_t n = this->scroll_capacity;
+            for (unsigned int dsi = 0; dsi < nds; ++dsi) {
+                if (this->datastyles[dsi].markerstyle == markerstyle::bar
+                    || this->datastyles[dsi].markerstyle == markerstyle::quiver) {
+                    throw std::runtime_error ("GraphVisual: Bar and quiver datasets can't scroll");
+                }
+                scroll_layout& sl = this->scroll_layouts[dsi];
+                sl.v0 = this->idx;
+                sl.i0 = this->indices.size();
+                const std::size_t count = this->scroll_count[dsi];
+                for (std::size_t s = 0; s < n; ++s) {
+                    // The latest sample in slot s, if any
+                    std::size_t k = no_sample;
+                    if (count > s) { k = s + ((count - 1 - s) / n) * n; }
+                    this->scroll_geometry (dsi, k);
+                    if (s == 0) {
+                        sl.nv = this->idx - sl.v0;
+                        sl.ni = this->indices.size() - sl.i0;
+                    }
+                }
+                if (this->idx - sl.v0 != n * sl.nv) {
+                    throw std::runtime_error ("GraphVisual::drawScrollData: Scrolling slots differ in size");
+                }
+            }
+        }
+
+        //! Make room for the scrolling state of nds datasets
+        void scroll_resize (const std::size_t nds)
+        {
+            if (this->scroll_coords.size() >= nds) { return; }
+            this->scroll_absc.resize (nds, std::vector<Flt>(this->scroll_capacity, Flt{0}));
+            this->scroll_coords.resize (nds, std::vector<sm::vec<float>>(this->scroll_capacity, sm::vec<float>{0.0f, 0.0f, 0.0f}));
+            this->scroll_count.resize (nds, 0);
+            this->scroll_oldest.resize (nds, 0);
+        }
+
+        //! Re-make the vertices of slot k of dataset dsi and mark them for upload
+        void scroll_write_slot (const unsigned int dsi, const std::size_t k)
+        {
+            if (dsi >= this->scroll_layouts.size()) { return; } // Not yet laid out; drawScrollData will do it
+            const scroll_layout& sl = this->scroll_layouts[dsi];
+            const std::size_t v_first = sl.v0 + (k % this->scroll_capacity) * sl.nv;
+            const std::size_t i_first = sl.i0 + (k % this->scroll_capacity) * sl.ni;
+
+            // The vertex-making functions push_back onto the model's vectors, so swap in empty ones
+            std::vector<float> vp, vn, vc;
+            std::vector<GLuint> ind;
+            std::swap (vp, this->vertexPositions);
+            std::swap (vn, this->vertexNormals);
+            std::swap (vc, this->vertexColors);
+            std::swap (ind, this->indices);
+            const GLuint idx_saved = this->idx;
+            this->idx = static_cast<GLuint>(v_first);
+            this->scroll_geometry (dsi, k);
+            std::swap (vp, this->vertexPositions);
+            std::swap (vn, this->vertexNormals);
+            std::swap (vc, this->vertexColors);
+            std::swap (ind, this->indices);
+            this->idx = idx_saved;
+
+            std::copy (vp.begin(), vp.end(), this->vertexPositions.begin() + 3 * v_first);
+            std::copy (vn.begin(), vn.end(), this->vertexNormals.begin() + 3 * v_first);
+            std::copy (vc.begin(), vc.end(), this->vertexColors.begin() + 3 * v_first);
+            std::copy (ind.begin(), ind.end(), this->indices.begin() + i_first);
+
+            // Only the positions change, and only they are uploaded. Extend the last range if it
+            // ends where this one starts.
+            const std::size_t v_last = v_first + sl.nv;
+            if (!this->scroll_dirty.empty() && this->scroll_dirty.back()[1] == v_first) {
+                this->scroll_dirty.back()[1] = v_last;
+            } else {
+                this->scroll_dirty.push_back ({ v_first, v_last });
+            }
+        }
+
+        //! Append a sample to a dataset of a scrolling graph
+        void scroll_append (const Flt _abscissa, const Flt _ordinate, const unsigned int didx)
+        {
+            if (didx >= this->graphDataCoords.size()) {
+                throw std::runtime_error ("GraphVisual::append: Prepare scrolling datasets with prepdata before appending");
+            }
+            this->scroll_resize (this->graphDataCoords.size());
+            if (!this->scroll_started) {
+                this->scroll_t0 = _abscissa;
+                this->scroll_tnow = _abscissa;
+                this->scroll_started = true;
+            }
+            this->scroll_tnow = std::max (this->scroll_tnow, _abscissa);
+
+            // The x axis shows [xmin, xmax] before the latest sample, so the sample lies at
+            // _abscissa - scroll_tnow + xmax. It is placed as if scroll_tnow were scroll_t0, and
+            // moved into place by scroll_offset when it is rendered.
+            const Flt xmax = this->datarange_x.max;
+            const float x = static_cast<float>(this->abscissa_scale.transform_one (_abscissa - this->scroll_t0 + xmax));
+            const float y = static_cast<float>(this->datastyles[didx].axisside == mplot::axisside::left
+                                               ? this->ord1_scale.transform_one (_ordinate)
+                                               : this->ord2_scale.transform_one (_ordinate));
+
+            const std::size_t n = this->scroll_capacity;
+            const std::size_t k = this->scroll_count[didx]++;
+            this->scroll_absc[didx][k % n] = _abscissa;
+            this->scroll_coords[didx][k % n] = sm::vec<float>{ x, y, 0.0f };
+            if (k + 1 - this->scroll_oldest[didx] > n) { this->scroll_oldest[didx] = k + 1 - n; }
+
+            // The new sample's slot, and the line to it from the previous sample
+            if (k > 0 && this->scroll_shown (didx, k - 1)) { this->scroll_write_slot (didx, k - 1); }
+            this->scroll_write_slot (didx, k);
+
+            // Hide the samples of every dataset that have scrolled off the left of the axes
+            const Flt t_oldest = this->scroll_tnow - (xmax - this->datarange_x.min);
+            for (unsigned int dsi = 0; dsi < this->scroll_count.size(); ++dsi) {
+                while (this->scroll_oldest[dsi] < this->scroll_count[dsi]
+                       && this->scroll_absc[dsi][this->scroll_oldest[dsi] % n] < t_oldest) {
+                    ++this->scroll_oldest[dsi];
+                    this->scroll_write_slot (dsi, this->scroll_oldest[dsi] - 1);
+                }
+            }
+
+            // Units of model x per unit of abscissa (GraphVisual's abscissa scaling is linear)
+            const float dx_dt = static_cast<float>(this->abscissa_scale.transform_one (Flt{1}) - this->abscissa_scale.transform_one (Flt{0}));
+            float shift = dx_dt * static_cast<float>(this->scroll_tnow - this->scroll_t0);
+            if (std::abs (shift) > 64.0f * this->width && !this->scroll_layouts.empty()) {
+                // Keep the vertex coordinates small (and precise) by moving the samples back into
+                // place and restarting scroll_t0 from now. This happens once in every 64 widths of
+                // scrolling, so its cost is shared across many appends.
+                for (auto& ring : this->scroll_coords) { for (auto& c : ring) { c[0] -= shift; } }
+                const std::size_t v_first = this->scroll_layouts.front().v0;
+                for (std::size_t i = 3 * v_first; i < this->vertexPositions.size(); i += 3) { this->vertexPositions[i] -= shift; }
+                this->scroll_dirty.assign (1, { v_first, this->vertexPositions.size() / 3 });
+                this->scroll_t0 = this->scroll_tnow;
+                shift = 0.0f;
+            }
+            this->scroll_offset = { -shift, 0.0f, 0.0f };
+        }
+
+        /*!
+         * Replace the data of datasets didx[k] with *dat[k] at the abscissae *absc[k] and rebuild
+         * the graph. Indices must be valid and unique and the sizes of absc[k] and dat[k] equal.
+         */
+        template <typename Ctnr1, typename Ctnr2>
+        void update_datasets (const std::vector<const Ctnr1*>& absc, const std::vector<const Ctnr2*>& dat,
+                              const std::vector<unsigned int>& didx)
+        {
+            const std::size_t n = didx.size();
+            std::size_t n_points = 0;
+            for (std::size_t k = 0; k < n; ++k) { n_points += dat[k]->size(); }
+
+            // Find the range of each dataset's new data, if the axes are to be rescaled
+            std::vector<sm::range<Flt>> xranges (n);
+            std::vector<sm::range<Flt>> yranges (n);
+            if (this->auto_rescale_x || this->auto_rescale_y) {
+                this->parallel_datasets (n, n_points, [&](const std::size_t k) {
+                    xranges[k].search_init();
+                    yranges[k].search_init();
+                    if (this->auto_rescale_x) { for (auto x_val : *absc[k]) { xranges[k].update (x_val); } }
+                    if (this->auto_rescale_y) { for (auto y_val : *dat[k]) { yranges[k].update (y_val); } }
+                });
+            }
+
+            // Then rescale each axis once, for all of the new data
+            if (this->auto_rescale_x) {
+                this->abscissa_scale.reset();
+                sm::range<Flt> datarange = this->datarange_x;
+                for (std::size_t k = 0; k < n; ++k) {
+                    if (absc[k]->empty()) { continue; }
+                    datarange.update (xranges[k].min);
+                    datarange.update (xranges[k].max);
+                }
+                this->setlimits_x (datarange, true);
+                this->abscissa_scale.compute_scaling (this->datarange_x);
+            }
+            if (this->auto_rescale_y) {
+                for (const mplot::axisside side : { mplot::axisside::left, mplot::axisside::right }) {
+                    // With auto_rescale_fit the axis fits the new data; otherwise it grows to include it
+                    sm::range<Flt> datarange = side == mplot::axisside::left ? this->datarange_y : this->datarange_y2;
+                    if (this->auto_rescale_fit) { datarange.search_init(); }
+                    bool has_data = false;
+                    for (std::size_t k = 0; k < n; ++k) {
+                        if (this->datastyles[didx[k]].axisside != side || dat[k]->empty()) { continue; }
+                        datarange.update (yranges[k].min);
+                        datarange.update (yranges[k].max);
+                        has_data = true;
+                    }
+                    if (!has_data) { continue; }
+                    if (side == mplot::axisside::left) {
+                        this->ord1_scale.reset();
+                        this->setlimits_y (datarange, true);
+                        this->ord1_scale.compute_scaling (this->datarange_y);
+                    } else {
+                        this->ord2_scale.reset();
+                        this->setlimits_y2 (datarange, true);
+                        this->ord2_scale.compute_scaling (this->datarange_y2);
+                    }
+                }
+            }
+
+            // Scale the new data into graphDataCoords
+            bool scales_ready = this->abscissa_scale.ready();
+            for (std::size_t k = 0; k < n; ++k) {
+                this->graphDataCoords[didx[k]]->resize (dat[k]->size());
+                // The data are replaced, so any decimation pyramid must be re-made
+                if (didx[k] < this->pyramids.size()) { this->pyramids[didx[k]].clear(); }
+                const bool left = this->datastyles[didx[k]].axisside == mplot::axisside::left;
+                scales_ready = scales_ready && (left ? this->ord1_scale.ready() : this->ord2_scale.ready());
+            }
+            auto transform = [this, &absc, &dat, &didx](const std::size_t k, sm::scale<Flt>& xscale, sm::scale<Flt>& yscale)
+            {
+                const std::size_t dsize = dat[k]->size();
+                std::vector<Flt> ad (dsize, Flt{0});
+                xscale.transform (*absc[k], ad);
+                std::vector<Flt> sd (dsize, Flt{0});
+                yscale.transform (*dat[k], sd);
+                std::vector<sm::vec<float>>& coords = *this->graphDataCoords[didx[k]];
+                for (std::size_t i = 0; i < dsize; ++i) {
+                    coords[i] = sm::vec<float>{ static_cast<float>(ad[i]), static_cast<float>(sd[i]), float{0} };
+                }
+            };
+            if (scales_ready) {
+                // Ready scales don't change as they transform, so each task can use its own copies
+                this->parallel_datasets (n, n_points, [&](const std::size_t k) {
+                    sm::scale<Flt> xscale = this->abscissa_scale;
+                    sm::scale<Flt> yscale = this->datastyles[didx[k]].axisside == mplot::axisside::left ? this->ord1_scale : this->ord2_scale;
+                    transform (k, xscale, yscale);
+                });
+            } else {
+                // A scale that autoscales on its first transform must be set up by the first dataset
+                for (std::size_t k = 0; k < n; ++k) {
+                    transform (k, this->abscissa_scale,
+                               this->datastyles[didx[k]].axisside == mplot::axisside::left ? this->ord1_scale : this->ord2_scale);
+                }
+            }
+
+            this->clearTexts(); // VisualModel::clearTexts()
+            this->reinit();
+        }
+
+        /*!
+         * Call fn (k) for each k in [0, n), sharing the calls among up to dataset_threads threads.
+         * Threads are only used if there are at least min_per_thread data points (n_points in
+         * total) for each.
+         */
+        template <typename F>
+        void parallel_datasets (const std::size_t n, const std::size_t n_points, F fn) const
+        {
+            constexpr std::size_t min_per_thread = 1u << 16;
+            std::size_t nt = this->dataset_threads == 0u ? std::thread::hardware_concurrency() : this->dataset_threads;
+            nt = std::min ({ std::max (nt, std::size_t{1}), n, std::max (n_points / min_per_thread, std::size_t{1}) });
+            if (nt < 2) {
+                for (std::size_t k = 0; k < n; ++k) { fn (k); }
+                return;
+            }
+            std::atomic<std::size_t> next = 0;
+            auto work = [&next, &fn, n]()
+            {
+                for (std::size_t k = next++; k < n; k = next++) { fn (k); }
+            };
+            std::vector<std::thread> pool;
+            pool.reserve (nt - 1);
+            for (std::size_t t = 1; t < nt; ++t) { pool.emplace_back (work); }
+            work();
+            for (auto& th : pool) { th.join(); }
+        }
+
+        /*!
+         * Bring the min/max pyramids of the datasets that are big enough to be decimated up to
+         * date, with a thread for each of several datasets. The vertices are then made by one
+         * thread, as they are appended to the model's shared vertex arrays.
+         */
+        void update_pyramids()
+        {
+            std::vector<unsigned int> big;
+            std::size_t n_points = 0;
+            for (unsigned int dsi = 0; dsi < static_cast<unsigned int>(this->graphDataCoords.size()); ++dsi) {
+                if (this->decimation_candidate (dsi)) {
+                    big.push_back (dsi);
+                    n_points += this->graphDataCoords[dsi]->size();
+                }
+            }
+            if (big.empty()) { return; }
+            // Size pyramids here so that pyramid() won't resize it in the threads
+            if (this->pyramids.size() < this->graphDataCoords.size()) { this->pyramids.resize (this->graphDataCoords.size()); }
+            this->parallel_datasets (big.size(), n_points, [this, &big](const std::size_t k) { this->pyramid (big[k]); });
+        }
+
         //! Draw all markers and lines for datasets in the graph (as stored in graphDataCoords)
         void drawData()
         {
+            // The polylines were removed with the rest of the model's vertices
+            this->dataset_polylines.clear();
+            this->update_pyramids();
             unsigned int coords_start = 0;
             this->coords_lengths.resize (this->graphDataCoords.size());
+            this->built_lengths.resize (this->graphDataCoords.size());
             for (unsigned int dsi = 0; dsi < static_cast<unsigned int>(this->graphDataCoords.size()); ++dsi) {
                 unsigned int coords_end = this->graphDataCoords[dsi]->size();
                 // Record coords length for future appending:
                 this->coords_lengths[dsi] = coords_end;
-                this->drawDataCommon (dsi, coords_start, coords_end);
+                this->built_lengths[dsi] = coords_end;
+                if (this->decimates (dsi)) {
+                    this->drawDecimatedData (dsi);
+                } else {
+                    this->drawDataCommon (dsi, coords_start, coords_end);
+                }
+            }
+        }
+
+        /*!
+         * The min/max pyramid for dataset dsi, brought up to date with any appended points. The
+         * pyramid refers to the points by index, so it is still valid after the axes are
+         * rescaled. It is cleared when the data are replaced.
+         */
+        mplot::decimate::minmax_pyramid& pyramid (const unsigned int dsi)
+        {
+            if (this->pyramids.size() < this->graphDataCoords.size()) { this->pyramids.resize (this->graphDataCoords.size()); }
+            const std::vector<sm::vec<float>>& coords = *this->graphDataCoords[dsi];
+            if (this->pyramids[dsi].size() > coords.size()) {
+                this->pyramids[dsi].assign (coords);
+            } else {
+                this->pyramids[dsi].extend (coords);
+            }
+            return this->pyramids[dsi];
+        }
+
+        //! Is dataset dsi big enough to decimate, and of a kind that can be decimated?
+        bool decimates (const unsigned int dsi)
+        {
+            if (!this->decimation_candidate (dsi)) { return false; }
+            // Decimation needs the points in order along the x axis
+            return this->pyramid (dsi).sorted_x();
+        }
+
+        //! Is dataset dsi big enough to decimate, and not made of bars or quivers?
+        bool decimation_candidate (const unsigned int dsi) const
+        {
+            if (this->decimation_columns == 0) { return false; }
+            if (this->graphDataCoords[dsi]->size() <= 4 * static_cast<std::size_t>(this->decimation_columns)) { return false; }
+            // Bars and quivers stand for one datum each
+            return this->datastyles[dsi].markerstyle != markerstyle::bar
+                   && this->datastyles[dsi].markerstyle != markerstyle::quiver;
+        }
+
+        /*!
+         * Draw a large dataset through a subset of its points. The lines go through the first,
+         * last, lowest and highest points in each of decimation_columns columns across the axes
+         * (M4 decimation) so that they look the same as lines through all of the points. These
+         * are found with the dataset's min/max pyramid in O(decimation_columns log n) time, so
+         * zooming, panning and appending to a graph of 10^8 points stays quick. At most
+         * decimation_columns markers are drawn, at points chosen from the M4 points by LTTB.
+         */
+        void drawDecimatedData (const unsigned int dsi)
+        {
+            const std::vector<sm::vec<float>>& coords = *this->graphDataCoords[dsi];
+            std::vector<sm::vec<float>> lcoords;
+            for (std::size_t k : this->pyramid (dsi).m4 (coords, 0.0, this->width, this->decimation_columns)) {
+                lcoords.push_back (coords[k]);
+            }
+            if (this->datastyles[dsi].markerstyle != markerstyle::none) {
+                std::vector<sm::vec<float>> mcoords;
+                for (std::size_t k : mplot::decimate::lttb (lcoords, this->decimation_columns)) { mcoords.push_back (lcoords[k]); }
+                this->drawMarkers (dsi, mcoords, 0, static_cast<unsigned int>(mcoords.size()));
+            }
+            if (this->datastyles[dsi].showlines == true) {
+                this->drawLines (dsi, lcoords, 0, static_cast<unsigned int>(lcoords.size()));
             }
         }
 
@@ -1935,6 +2537,29 @@ namespace mplot {
         sm::range<Flt> datarange_y{ Flt{0}, Flt{1} };
         //! If required, the second ordinate's minimum/max data values (twinax)
         sm::range<Flt> datarange_y2{ Flt{0}, Flt{1} };
+        /*!
+         * Datasets with more than 4 * decimation_columns points are decimated before they are
+         * drawn, so that the number of vertices in the graph depends on its resolution, rather
+         * than on the size of the data. Think of decimation_columns as the number of pixels
+         * across the graph when it is displayed; the decimated lines look the same as the full
+         * lines at that resolution. 0 turns decimation off. Decimation is repeated whenever the
+         * graph is rebuilt (such as after update(), or a change of the axis limits). Points added
+         * with append() are drawn in full until decimation_columns of them have built up on a
+         * decimated dataset, when the graph is rebuilt. Only datasets with increasing x are
+         * decimated.
+         */
+        unsigned int decimation_columns = 2048;
+        /*!
+         * If true, lines between data points are drawn by the GPU line shader. Only the points of
+         * each line are uploaded (12 bytes per point, rather than 168 bytes for the vertices
+         * of the triangles that make up a line segment) and changes to the line style can be
+         * applied with update_linestyles() without rebuilding the graph. This also enables dashed
+         * lines and round joins. Set before the data are added.
+         */
+        bool gpu_lines = false;
+        //! The number of threads that update() and the drawing of the data may use for work that
+        //! is done dataset by dataset. 0 means std::thread::hardware_concurrency().
+        unsigned int dataset_threads = 1;
         //! Auto-rescale x axis if data goes off the edge of the graph (by setting the out of range data as new boundary)
         bool auto_rescale_x = false;
         //! Auto-rescale y axis if data goes off the edge of the graph (by setting the out of range data as new boundary)
@@ -3,6 +3,8 @@
 #include <iostream>
 #include <vector>
 #include <array>
+#include <span>
+#include <algorithm>
 #include <unordered_map>
 
 #include <sm/grid>
@@ -57,9 +59,13 @@ namespace mplot {
      * \tparam C The type for the Grid coordinates (default float, must be a signed type)
      *
      * \tparam glver The OpenGL version in use in your program
+     *
+     * \tparam CM The colour map type. Use an mplot::StaticColourMap to fix the map at compile
+     * time so that the colour conversion in each rebuild is inlined.
      */
-    template <typename T, typename I = unsigned int, typename C = float, int glver = mplot::gl::version_4_1>
-    struct GridVisual : public VisualDataModel<T, glver>
+    template <typename T, typename I = unsigned int, typename C = float, int glver = mplot::gl::version_4_1,
+              typename CM = mplot::ColourMap<float>>
+    struct GridVisual : public VisualDataModel<T, glver, CM>
     {
         GridVisual(const sm::grid<I, C>* _grid, const sm::vec<float> _offset)
         {
@@ -112,15 +118,79 @@ namespace mplot {
             }
 
             // now sub-call the scalar or vector reinit colours function
-            if (this->scalarData != nullptr) {
+            if (this->has_scalars()) {
                 this->reinitColoursScalar (n_data, n_cvertices_per_datum);
-            } else if (this->vectorData != nullptr) {
+            } else if (this->has_vectors()) {
                 this->reinitColoursVector (n_data, n_cvertices_per_datum);
             } else {
                 throw std::runtime_error ("No data to reinitColours()");
             }
         }
 
+        /*!
+         * After a sparse updateData (indices, values), rewrite and upload only the vertices of the
+         * changed elements. Pixels and RectInterp modes are updated in place; in RectInterp mode
+         * a change of z also moves the shared corners (and so the normals) of the eight
+         * neighbouring rects. Triangles and Columns modes are rebuilt.
+         */
+        void reinit_at (std::span<const unsigned int> indices, const bool z_changed)
+        {
+            constexpr std::size_t nv = 5; // vertices per element in Pixels and RectInterp modes
+            const bool interp = this->gridVisMode == GridVisMode::RectInterp;
+            if ((this->gridVisMode != GridVisMode::Pixels && !interp)
+                || this->vertexColors.size() < 3 * nv * static_cast<std::size_t>(this->grid->n())) {
+                this->reinit();
+                return;
+            }
+
+            for (auto ri : indices) {
+                const std::array<float, 3> clr = this->colourAt (ri);
+                for (std::size_t j = 0; j < nv; ++j) {
+                    std::copy (clr.begin(), clr.end(), this->vertexColors.begin() + 3 * (nv * ri + j));
+                }
+            }
+            if (z_changed == false) {
+                this->reinit_buffer_ranges (this->vertex_ranges (indices, nv), false, false, true);
+                return;
+            }
+
+            // The elements whose vertices move
+            std::vector<unsigned int> moved (indices.begin(), indices.end());
+            if (interp) {
+                moved.reserve (9 * indices.size());
+                for (auto ri : indices) {
+                    const I i = static_cast<I>(ri);
+                    if (this->grid->has_ne(i)) { moved.push_back (static_cast<unsigned int>(this->grid->index_ne(i))); }
+                    if (this->grid->has_nn(i)) { moved.push_back (static_cast<unsigned int>(this->grid->index_nn(i))); }
+                    if (this->grid->has_nw(i)) { moved.push_back (static_cast<unsigned int>(this->grid->index_nw(i))); }
+                    if (this->grid->has_ns(i)) { moved.push_back (static_cast<unsigned int>(this->grid->index_ns(i))); }
+                    if (this->grid->has_nne(i)) { moved.push_back (static_cast<unsigned int>(this->grid->index_nne(i))); }
+                    if (this->grid->has_nnw(i)) { moved.push_back (static_cast<unsigned int>(this->grid->index_nnw(i))); }
+                    if (this->grid->has_nsw(i)) { moved.push_back (static_cast<unsigned int>(this->grid->index_nsw(i))); }
+                    if (this->grid->has_nse(i)) { moved.push_back (static_cast<unsigned int>(this->grid->index_nse(i))); }
+                }
+                std::sort (moved.begin(), moved.end());
+                moved.erase (std::unique (moved.begin(), moved.end()), moved.end());
+            }
+
+            std::array<sm::vec<float>, 5> vtx;
+            for (auto ri : moved) {
+                const std::size_t v0 = 3 * nv * ri;
+                if (interp) {
+                    this->rectInterpVertices (static_cast<I>(ri), vtx);
+                    const sm::vec<float> vnorm = rectNormal (vtx);
+                    for (std::size_t j = 0; j < nv; ++j) {
+                        std::copy (vtx[j].begin(), vtx[j].end(), this->vertexPositions.begin() + v0 + 3 * j);
+                        std::copy (vnorm.begin(), vnorm.end(), this->vertexNormals.begin() + v0 + 3 * j);
+                    }
+                } else {
+                    // Pixels are flat, so only their z changes
+                    for (std::size_t j = 0; j < nv; ++j) { this->vertexPositions[v0 + 3 * j + 2] = this->dcopy[ri]; }
+                }
+            }
+            this->reinit_buffer_ranges (this->vertex_ranges (moved, nv), true, interp, true);
+        }
+
     public:
         // function that draws a border around the whole image
         void drawBorder()
@@ -361,19 +431,19 @@ namespace mplot {
                 throw std::runtime_error ("GridVisual error: grid is a nullptr");
             }
 
-            if (this->scalarData != nullptr) {
+            if (this->has_scalars()) {
                 // Check scalar data has same size as Grid
-                if (this->scalarData->size() != static_cast<std::size_t>(this->grid->n())) {
+                if (this->scalars().size() != static_cast<std::size_t>(this->grid->n())) {
                     throw std::runtime_error ("GridVisual error: grid size does not match scalarData size");
                 }
-            } else if (this->vectorData != nullptr) {
+            } else if (this->has_vectors()) {
                 // Check vector data matches grid
-                if (this->vectorData->size() != static_cast<std::size_t>(this->grid->n())) {
+                if (this->vectors().size() != static_cast<std::size_t>(this->grid->n())) {
                     throw std::runtime_error ("GridVisual error: grid size does not match vectorData size");
                 }
             }
             // Now call the parent function
-            mplot::VisualDataModel<T, glver>::setupScaling();
+            mplot::VisualDataModel<T, glver, CM>::setupScaling();
         }
 
         //! Do the computations to initialize the vertices that will represent the Grid.
@@ -457,7 +527,7 @@ namespace mplot {
 
             I vidx = 0;
             for (I ri = 0; ri < this->grid->n(); ++ri) {
-                std::array<float, 3> clr = this->setColour (ri);
+                std::array<float, 3> clr = this->colourAt (ri);
 
                 vidx = vpsz + ri * 3;
                 this->vertexPositions[vidx++] = (*this->grid)[ri][0] + centering_offset[0];
@@ -555,139 +625,131 @@ namespace mplot {
             this->idx += this->grid->n();
         }
 
-        //! Initialize as a rectangle made of 4 triangles for each rect, with z position
-        //! of each of the 4 outer edges of the triangles interpolated, but a single colour
-        //! for each rectangle. Gives a smooth surface in which you can see the pixels.
-        void initializeVerticesRectsInterpolated()
+        /*!
+         * Compute the 5 vertices of the rect for element ri in RectInterp mode: the centre, then
+         * the NE, SE, SW and NW corners. The z of each corner is the mean of dcopy for the rects
+         * that meet there.
+         */
+        void rectInterpVertices (const I ri, std::array<sm::vec<float>, 5>& vtx) const
         {
             sm::vec<float, 2> dx = this->grid->get_dx();
-            float hx = 0.5f * dx[0];
-            float vy = 0.5f * dx[1];
-
-            sm::vec<float, 2> gridline_ht = this->get_gridline_ht();
-
-            this->idx = 0;
-            this->setupScaling();
-
-            float datumC = 0.0f;   // datum at the centre
-            float datumNE = 0.0f;  // datum at the hex to the east.
-            float datumNNE = 0.0f;
-            float datumNN = 0.0f;
-            float datumNNW = 0.0f;
-            float datumNW = 0.0f;
-            float datumNSW = 0.0f;
-            float datumNS = 0.0f;
-            float datumNSE = 0.0f;
-
-            float datum = 0.0f;
-
-            sm::vec<float> vtx_0, vtx_1, vtx_2;
+            const float hx = 0.5f * dx[0];
+            const float vy = 0.5f * dx[1];
+            const sm::vec<float, 2> gridline_ht = this->get_gridline_ht();
 
             // Thickness of spacing for selected pixels
-            const float selth_x = this->options.test (gridvisual_flags::selected_pix_thickness_fixed) ? this->selected_pix_thickness : dx[0] * this->selected_pix_thickness;
-            const float selth_y = this->options.test (gridvisual_flags::selected_pix_thickness_fixed) ? this->selected_pix_thickness : dx[1] * this->selected_pix_thickness;
             float sx = 0.0f;
             float sy = 0.0f;
+            if (this->options.test (gridvisual_flags::showselectedpixborder) == true && this->selected_pix.contains (ri)) {
+                const bool fixed = this->options.test (gridvisual_flags::selected_pix_thickness_fixed);
+                sx = fixed ? this->selected_pix_thickness : dx[0] * this->selected_pix_thickness;
+                sy = fixed ? this->selected_pix_thickness : dx[1] * this->selected_pix_thickness;
+            }
 
-            for (I ri = 0; ri < this->grid->n(); ++ri) {
-
-                if (this->options.test (gridvisual_flags::showselectedpixborder) == true) {
-                    if (this->selected_pix.contains(ri)) {
-                        sx = selth_x;
-                        sy = selth_y;
-                    } else { // ri is not in selected_pix
-                        sx = 0.0f;
-                        sy = 0.0f;
-                    }
-                } // else sx = sy = 0
+            // Use the linear scaled copy of the data, dcopy.
+            const float datumC  = this->dcopy[ri];
+            const float datumNE =  this->grid->has_ne(ri)  ? this->dcopy[this->grid->index_ne(ri)] : datumC;
+            const float datumNN =  this->grid->has_nn(ri)  ? this->dcopy[this->grid->index_nn(ri)] : datumC;
+            const float datumNW =  this->grid->has_nw(ri)  ? this->dcopy[this->grid->index_nw(ri)] : datumC;
+            const float datumNS =  this->grid->has_ns(ri)  ? this->dcopy[this->grid->index_ns(ri)] : datumC;
+            const float datumNNE = this->grid->has_nne(ri) ? this->dcopy[this->grid->index_nne(ri)] : datumC;
+            const float datumNNW = this->grid->has_nnw(ri) ? this->dcopy[this->grid->index_nnw(ri)] : datumC;
+            const float datumNSW = this->grid->has_nsw(ri) ? this->dcopy[this->grid->index_nsw(ri)] : datumC;
+            const float datumNSE = this->grid->has_nse(ri) ? this->dcopy[this->grid->index_nse(ri)] : datumC;
 
-                // Use the linear scaled copy of the data, dcopy.
-                datumC  = this->dcopy[ri];
-                datumNE =  this->grid->has_ne(ri)  ? this->dcopy[this->grid->index_ne(ri)] : datumC;
-                datumNN =  this->grid->has_nn(ri)  ? this->dcopy[this->grid->index_nn(ri)] : datumC;
-                datumNW =  this->grid->has_nw(ri)  ? this->dcopy[this->grid->index_nw(ri)] : datumC;
-                datumNS =  this->grid->has_ns(ri)  ? this->dcopy[this->grid->index_ns(ri)] : datumC;
-                datumNNE = this->grid->has_nne(ri) ? this->dcopy[this->grid->index_nne(ri)] : datumC;
-                datumNNW = this->grid->has_nnw(ri) ? this->dcopy[this->grid->index_nnw(ri)] : datumC;
-                datumNSW = this->grid->has_nsw(ri) ? this->dcopy[this->grid->index_nsw(ri)] : datumC;
-                datumNSE = this->grid->has_nse(ri) ? this->dcopy[this->grid->index_nse(ri)] : datumC;
-
-                // Use a single colour for each rect, even though rectangle's z positions are
-                // interpolated. Do the _colour_ scaling:
-                std::array<float, 3> clr = this->setColour (ri);
+            float datum = 0.0f;
 
-                // First push the 5 positions of the triangle vertices, starting with the centre
-                // Use the centre position as the first location for finding the normal vector
-                vtx_0 = { (*this->grid)[ri][0] + centering_offset[0], (*this->grid)[ri][1] + centering_offset[1], datumC };
-                this->vertex_push (vtx_0, this->vertexPositions);
+            // The centre position is the first location for finding the normal vector
+            vtx[0] = { (*this->grid)[ri][0] + centering_offset[0], (*this->grid)[ri][1] + centering_offset[1], datumC };
+
+            // NE vertex
+            // Compute mean of this->data[ri] and N, NE and E elements
+            if (this->grid->has_nn(ri) && this->grid->has_ne(ri) && this->grid->has_nne(ri)) {
+                datum = 0.25f * (datumC + datumNN + datumNE + datumNNE);
+            } else if (this->grid->has_ne(ri)) {
+                // Assume no NN and no NNE
+                datum = 0.5f * (datumC + datumNE);
+            } else if (this->grid->has_nn(ri)) {
+                // Assume no NE and no NNE
+                datum = 0.5f * (datumC + datumNN);
+            } else {
+                datum = datumC;
+            }
+            vtx[1] = { (*this->grid)[ri][0] + hx + centering_offset[0] - gridline_ht[0] - sx, (*this->grid)[ri][1] + vy + centering_offset[1] - gridline_ht[1] - sy, datum };
+
+            // SE vertex
+            if (this->grid->has_ns(ri) && this->grid->has_ne(ri) && this->grid->has_nse(ri)) {
+                datum = 0.25f * (datumC + datumNS + datumNE + datumNSE);
+            } else if (this->grid->has_ne(ri)) {
+                // Assume no NS and no NSE
+                datum = 0.5f * (datumC + datumNE);
+            } else if (this->grid->has_ns(ri)) {
+                // Assume no NE and no NSE
+                datum = 0.5f * (datumC + datumNS);
+            } else {
+                datum = datumC;
+            }
+            vtx[2] = { (*this->grid)[ri][0] + hx + centering_offset[0] - gridline_ht[0] - sx, (*this->grid)[ri][1] - vy + centering_offset[1] + gridline_ht[1] + sy, datum };
+
+            // SW vertex
+            if (this->grid->has_ns(ri) && this->grid->has_nw(ri) && this->grid->has_nsw(ri)) {
+                datum = 0.25f * (datumC + datumNS + datumNW + datumNSW);
+            } else if (this->grid->has_nw(ri)) {
+                datum = 0.5f * (datumC + datumNW);
+            } else if (this->grid->has_ns(ri)) {
+                datum = 0.5f * (datumC + datumNS);
+            } else {
+                datum = datumC;
+            }
+            vtx[3] = { (*this->grid)[ri][0] - hx + centering_offset[0] + gridline_ht[0] + sx, (*this->grid)[ri][1] - vy + centering_offset[1] + gridline_ht[1] + sy, datum };
+
+            // NW vertex
+            if (this->grid->has_nn(ri) && this->grid->has_nw(ri) && this->grid->has_nnw(ri)) {
+                datum = 0.25f * (datumC + datumNN + datumNW + datumNNW);
+            } else if (this->grid->has_nw(ri)) {
+                datum = 0.5f * (datumC + datumNW);
+            } else if (this->grid->has_nn(ri)) {
+                datum = 0.5f * (datumC + datumNN);
+            } else {
+                datum = datumC;
+            }
+            vtx[4] = { (*this->grid)[ri][0] - hx + centering_offset[0] + gridline_ht[0] + sx, (*this->grid)[ri][1] + vy + centering_offset[1] - gridline_ht[1] - sy, datum };
+        }
 
+        //! The normal of the rect whose vertices are vtx (from vtx[0], vtx[1] and vtx[2])
+        static sm::vec<float> rectNormal (const std::array<sm::vec<float>, 5>& vtx)
+        {
+            // This sets the correct normal, but note that there is only one 'layer' of vertices;
+            // the back of the GridVisual will be coloured the same as the front. To get lighting
+            // effects to look really good, the back of the surface could need the opposite normal.
+            sm::vec<float> plane1 = vtx[1] - vtx[0];
+            sm::vec<float> plane2 = vtx[2] - vtx[0];
+            sm::vec<float> vnorm = plane2.cross (plane1);
+            vnorm.renormalize();
+            return vnorm;
+        }
 
-                // NE vertex
-                // Compute mean of this->data[ri] and N, NE and E elements
-                if (this->grid->has_nn(ri) && this->grid->has_ne(ri) && this->grid->has_nne(ri)) {
-                    datum = 0.25f * (datumC + datumNN + datumNE + datumNNE);
-                } else if (this->grid->has_ne(ri)) {
-                    // Assume no NN and no NNE
-                    datum = 0.5f * (datumC + datumNE);
-                } else if (this->grid->has_nn(ri)) {
-                    // Assume no NE and no NNE
-                    datum = 0.5f * (datumC + datumNN);
-                } else {
-                    datum = datumC;
-                }
-                vtx_1 = { (*this->grid)[ri][0] + hx + centering_offset[0] - gridline_ht[0] - sx, (*this->grid)[ri][1] + vy + centering_offset[1] - gridline_ht[1] - sy, datum };
-                this->vertex_push (vtx_1, this->vertexPositions);
+        //! Initialize as a rectangle made of 4 triangles for each rect, with z position
+        //! of each of the 4 outer edges of the triangles interpolated, but a single colour
+        //! for each rectangle. Gives a smooth surface in which you can see the pixels.
+        void initializeVerticesRectsInterpolated()
+        {
+            this->idx = 0;
+            this->setupScaling();
 
-                // SE vertex
-                if (this->grid->has_ns(ri) && this->grid->has_ne(ri) && this->grid->has_nse(ri)) {
-                    datum = 0.25f * (datumC + datumNS + datumNE + datumNSE);
-                } else if (this->grid->has_ne(ri)) {
-                    // Assume no NS and no NSE
-                    datum = 0.5f * (datumC + datumNE);
-                } else if (this->grid->has_ns(ri)) {
-                    // Assume no NE and no NSE
-                    datum = 0.5f * (datumC + datumNS);
-                } else {
-                    datum = datumC;
-                }
-                vtx_2 = {{(*this->grid)[ri][0] + hx + centering_offset[0] - gridline_ht[0] - sx, (*this->grid)[ri][1] - vy + centering_offset[1] + gridline_ht[1] + sy, datum}};
-                this->vertex_push (vtx_2, this->vertexPositions);
+            std::array<sm::vec<float>, 5> vtx;
 
+            for (I ri = 0; ri < this->grid->n(); ++ri) {
 
-                // SW vertex
-                if (this->grid->has_ns(ri) && this->grid->has_nw(ri) && this->grid->has_nsw(ri)) {
-                    datum = 0.25f * (datumC + datumNS + datumNW + datumNSW);
-                } else if (this->grid->has_nw(ri)) {
-                    datum = 0.5f * (datumC + datumNW);
-                } else if (this->grid->has_ns(ri)) {
-                    datum = 0.5f * (datumC + datumNS);
-                } else {
-                    datum = datumC;
-                }
-                // vtx_3
-                this->vertex_push ((*this->grid)[ri][0] - hx + centering_offset[0] + gridline_ht[0] + sx, (*this->grid)[ri][1] - vy + centering_offset[1] + gridline_ht[1] + sy, datum, this->vertexPositions);
+                // Use a single colour for each rect, even though rectangle's z positions are
+                // interpolated. Do the _colour_ scaling:
+                std::array<float, 3> clr = this->colourAt (ri);
 
-                // NW vertex
-                if (this->grid->has_nn(ri) && this->grid->has_nw(ri) && this->grid->has_nnw(ri)) {
-                    datum = 0.25f * (datumC + datumNN + datumNW + datumNNW);
-                } else if (this->grid->has_nw(ri)) {
-                    datum = 0.5f * (datumC + datumNW);
-                } else if (this->grid->has_nn(ri)) {
-                    datum = 0.5f * (datumC + datumNN);
-                } else {
-                    datum = datumC;
-                }
-                // vtx_4
-                this->vertex_push ((*this->grid)[ri][0] - hx + centering_offset[0] + gridline_ht[0] + sx, (*this->grid)[ri][1] + vy + centering_offset[1] - gridline_ht[1] - sy, datum, this->vertexPositions);
+                // Push the 5 positions of the triangle vertices, starting with the centre
+                this->rectInterpVertices (ri, vtx);
+                for (const auto& v : vtx) { this->vertex_push (v, this->vertexPositions); }
 
-                // From vtx_0,1,2 compute normal. This sets the correct normal, but note that there
-                // is only one 'layer' of vertices; the back of the GridVisual will be coloured the
-                // same as the front. To get lighting effects to look really good, the back of the
-                // surface could need the opposite normal.
-                sm::vec<float> plane1 = vtx_1 - vtx_0;
-                sm::vec<float> plane2 = vtx_2 - vtx_0;
-                sm::vec<float> vnorm = plane2.cross (plane1);
-                vnorm.renormalize();
+                sm::vec<float> vnorm = rectNormal (vtx);
                 this->vertex_push (vnorm, this->vertexNormals);
                 this->vertex_push (vnorm, this->vertexNormals);
                 this->vertex_push (vnorm, this->vertexNormals);
@@ -750,12 +812,12 @@ namespace mplot {
 
                 // Use a single colour for each rect, even though rectangle's z positions are
                 // interpolated. Do the _colour_ scaling:
-                std::array<float, 3> clr = this->setColour (ri);
+                std::array<float, 3> clr = this->colourAt (ri);
                 std::array<float, 3> clr_e;
                 std::array<float, 3> clr_n;
                 if (this->options.test (gridvisual_flags::interpolate_colour_sides) == true) {
-                    clr_e = this->setColour (this->grid->has_ne(ri) ? this->grid->index_ne(ri) : ri);
-                    clr_n = this->setColour (this->grid->has_nn(ri) ? this->grid->index_nn(ri) : ri);
+                    clr_e = this->colourAt (this->grid->has_ne(ri) ? this->grid->index_ne(ri) : ri);
+                    clr_n = this->colourAt (this->grid->has_nn(ri) ? this->grid->index_nn(ri) : ri);
                 }
 
                 // First push the 5 positions of the pixel top face, starting with the centre
@@ -940,7 +1002,7 @@ namespace mplot {
 
                 // Use a single colour for each rect, even though rectangle's z positions are
                 // interpolated. Do the _colour_ scaling:
-                std::array<float, 3> clr = this->setColour (ri);
+                std::array<float, 3> clr = this->colourAt (ri);
 
                 // First push the 5 positions of the triangle vertices, starting with the centre
                 // Use the centre position as the first location for finding the normal vector
@@ -1136,16 +1198,22 @@ namespace mplot {
             return gridline_ht;
         }
 
-        //! Called by reinitColours when scalarData is not null
+        //! Called by reinitColours when there is scalar data
         void reinitColoursScalar (const std::size_t n_data, const std::size_t n_cvertices_per_datum)
         {
             if (this->colourScale.do_autoscale == true) { this->colourScale.reset(); }
-            this->dcolour.resize (this->scalarData->size());
-            this->colourScale.transform (*(this->scalarData), this->dcolour);
+            if (this->scalarData != nullptr) {
+                this->dcolour.resize (this->scalarData->size());
+                this->colourScale.transform (*(this->scalarData), this->dcolour);
+            } else {
+                GridVisual::transform_view (this->colourScale, this->scalarView, this->dcolour);
+            }
+            this->rgb.resize (3 * this->dcolour.size());
+            this->cm.convert (std::span<const float>(this->dcolour), std::span<float>(this->rgb));
 
             // Replace elements of vertexColors
             for (std::size_t i = 0u; i < n_data; ++i) {
-                auto c = this->cm.convert (this->dcolour[i]);
+                std::array<float, 3> c = this->colourAt (i);
                 std::size_t d_idx = 3 * i * n_cvertices_per_datum;
                 for (std::size_t j = 0; j < n_cvertices_per_datum; ++j) {
                     this->vertexColors[d_idx + 3 * j] = c[0];
@@ -1158,14 +1226,15 @@ namespace mplot {
             this->reinit_colour_buffer();
         }
 
-        //! Called by reinitColours when vectorData is not null (vectors are probably RGB colour)
+        //! Called by reinitColours when there is vector data (vectors are probably RGB colour)
         void reinitColoursVector (const std::size_t n_data, const std::size_t n_cvertices_per_datum)
         {
             if (this->colourScale.do_autoscale == true) { this->colourScale.reset(); }
-            for (unsigned int i = 0; i < this->vectorData->size(); ++i) {
-                this->dcolour[i] = (*this->vectorData)[i][0];
-                this->dcolour2[i] = (*this->vectorData)[i][1];
-                this->dcolour3[i] = (*this->vectorData)[i][2];
+            const mplot::strided_view<sm::vec<T>> vecs = this->vectors();
+            for (unsigned int i = 0; i < vecs.size(); ++i) {
+                this->dcolour[i] = vecs[i][0];
+                this->dcolour2[i] = vecs[i][1];
+                this->dcolour3[i] = vecs[i][2];
             }
             if (this->cm.getType() != mplot::ColourMapType::RGB
                 && this->cm.getType() != mplot::ColourMapType::RGBMono
@@ -1174,11 +1243,11 @@ namespace mplot {
                 this->colourScale2.transform (this->dcolour2, this->dcolour2);
                 this->colourScale3.transform (this->dcolour3, this->dcolour3);
             } // else assume dcolour/dcolour2/dcolour3 are all in range 0->1 (or 0-255) already
-
+            this->convertColours();
 
             // Replace elements of vertexColors
             for (std::size_t i = 0u; i < n_data; ++i) {
-                std::array<float, 3> c = this->setColour (i);
+                std::array<float, 3> c = this->colourAt (i);
                 std::size_t d_idx = 3 * i * n_cvertices_per_datum;
                 for (std::size_t j = 0; j < n_cvertices_per_datum; ++j) {
                     this->vertexColors[d_idx + 3 * j] = c[0];
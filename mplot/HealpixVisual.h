@@ -1,6 +1,14 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
+#include <span>
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 #include <sm/scale>
 #include <sm/vec>
 #include <sm/vvec>
@@ -35,6 +43,61 @@ namespace mplot {
 
         void setColourData (std::vector<std::array<float, 3>>* cdata) { this->colourdata = cdata; }
 
+        /*!
+         * Change pixeldata at a few NEST indices. Only those pixels' vertices are recoloured (and,
+         * if relief is shown, moved) and uploaded. If an autoscaled scale would change (because a
+         * new value lies outside the range of pixeldata, or a value at a limit of the range
+         * moves) then the model is re-initialized as reinit() does.
+         */
+        void updateData (std::span<const int64_t> indices, std::span<const T> values)
+        {
+            if (indices.size() != values.size()) {
+                throw std::runtime_error ("HealpixVisual::updateData: indices and values differ in size");
+            }
+            const int64_t n_p = this->n_pixels();
+            for (auto p : indices) {
+                if (p < 0 || p >= n_p) { throw std::runtime_error ("HealpixVisual::updateData: index out of range"); }
+            }
+
+            // Each pixel is one vertex, numbered by its NEST index, unless face spheres come first
+            bool rebuild = this->k == 0 || this->show_face_spheres || this->show_nest_labels
+                || this->vertexColors.size() < 3u * static_cast<uint64_t>(n_p);
+            const bool c_auto = this->colourdata == nullptr && this->colourScale.do_autoscale == true;
+            const bool r_auto = this->relief == true && this->reliefScale.do_autoscale == true;
+            if (!rebuild && (c_auto || r_auto)) {
+                rebuild = !this->data_range_valid;
+                for (std::size_t i = 0; i < indices.size() && !rebuild; ++i) {
+                    const T x = values[i];
+                    const T prev = this->pixeldata[indices[i]];
+                    if (x < this->data_range[0] || x > this->data_range[1]
+                        || (prev == this->data_range[0] && x != prev) || (prev == this->data_range[1] && x != prev)) {
+                        rebuild = true;
+                    }
+                }
+            }
+
+            for (std::size_t i = 0; i < indices.size(); ++i) { this->pixeldata[indices[i]] = values[i]; }
+            if (rebuild) {
+                this->reinit();
+                return;
+            }
+
+            for (auto p : indices) {
+                if (this->colourdata == nullptr) {
+                    const std::array<float, 3> clr = this->cm.convert (this->colourScale.transform_one (this->pixeldata[p]));
+                    std::copy (clr.begin(), clr.end(), this->vertexColors.begin() + 3 * p);
+                }
+                if (this->relief == true) {
+                    // The normal is the unit vector towards the pixel
+                    const float _r = this->r + static_cast<float>(this->reliefScale.transform_one (this->pixeldata[p]));
+                    for (int64_t j = 0; j < 3; ++j) {
+                        this->vertexPositions[3 * p + j] = this->vertexNormals[3 * p + j] * _r * this->r;
+                    }
+                }
+            }
+            this->reinit_buffer_ranges (this->vertex_ranges (indices, 1), this->relief, false, this->colourdata == nullptr);
+        }
+
         void reinitColours()
         {
             size_t n_data = this->n_pixels();
@@ -46,15 +109,23 @@ namespace mplot {
             if (this->colourdata == nullptr) {
                 // Scale data
                 sm::vvec<float> scaled_data (this->pixeldata.size());
-                if (this->colourScale.do_autoscale == true) { this->colourScale.reset(); }
+                if (this->colourScale.do_autoscale == true) {
+                    this->colourScale.reset();
+                    this->find_data_range();
+                }
                 this->colourScale.transform (this->pixeldata, scaled_data);
 
                 // Re-colour
-                for (size_t i = 0u; i < n_data; ++i) {
-                    auto c = this->cm.convert (scaled_data[i]);
-                    this->vertexColors[3*i] = c[0];
-                    this->vertexColors[3*i+1] = c[1];
-                    this->vertexColors[3*i+2] = c[2];
+                if constexpr (std::is_same_v<std::decay_t<T>, float>) {
+                    this->cm.convert (std::span<const float>(scaled_data).first (n_data),
+                                      std::span<float>(this->vertexColors).first (3 * n_data));
+                } else {
+                    for (size_t i = 0u; i < n_data; ++i) {
+                        auto c = this->cm.convert (scaled_data[i]);
+                        this->vertexColors[3*i] = c[0];
+                        this->vertexColors[3*i+1] = c[1];
+                        this->vertexColors[3*i+2] = c[2];
+                    }
                 }
             } else {
                 // Use colour in colourdata directly, assuming it is in correct range (0->1 for each channel)
@@ -69,6 +140,32 @@ namespace mplot {
             this->reinit_colour_buffer();
         }
 
+        //! Scale pixeldata with colourScale and reliefScale, autoscaling them if they autoscale
+        void scale_pixeldata (sm::vvec<float>& scaled_colours, sm::vvec<float>& scaled_relief)
+        {
+            if (this->colourScale.do_autoscale == true || this->reliefScale.do_autoscale == true) {
+                this->find_data_range();
+            }
+            if (this->colourScale.do_autoscale == true) { this->colourScale.reset(); }
+            this->colourScale.transform (this->pixeldata, scaled_colours);
+            if (this->reliefScale.do_autoscale == true) { this->reliefScale.reset(); }
+            this->reliefScale.transform (this->pixeldata, scaled_relief);
+        }
+
+        //! Record the range of pixeldata that the autoscaled scales will find
+        void find_data_range()
+        {
+            this->data_range = { std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest() };
+            for (const T& x : this->pixeldata) {
+                if constexpr (std::is_floating_point<std::decay_t<T>>::value == true) {
+                    if (std::isnan (x)) { continue; }
+                }
+                this->data_range[0] = std::min (x, this->data_range[0]);
+                this->data_range[1] = std::max (x, this->data_range[1]);
+            }
+            this->data_range_valid = this->data_range[0] <= this->data_range[1];
+        }
+
         // Draw spheres at vertex locations (for debugging the geometry)
         void vertex_spheres()
         {
@@ -354,11 +451,8 @@ namespace mplot {
         {
             // For colours and relief, we scale data
             sm::vvec<float> scaled_colours (this->pixeldata.size());
-            if (this->colourScale.do_autoscale == true) { this->colourScale.reset(); }
-            this->colourScale.transform (this->pixeldata, scaled_colours);
             sm::vvec<float> scaled_relief (this->pixeldata.size());
-            if (this->reliefScale.do_autoscale == true) { this->reliefScale.reset(); }
-            this->reliefScale.transform (this->pixeldata, scaled_relief);
+            this->scale_pixeldata (scaled_colours, scaled_relief);
 
             // The first loop creates all the *vertices* using nest scheme.
             int64_t n_p = this->n_pixels();
@@ -371,6 +465,15 @@ namespace mplot {
                 if (this->colourdata->size() >= static_cast<size_t>(n_p)) { use_colourdata = true; }
             }
 
+            // Convert all the scaled colours in one pass
+            std::vector<float> rgb;
+            if constexpr (std::is_same_v<std::decay_t<T>, float>) {
+                if (anticipate_colourdata == false) {
+                    rgb.resize (3 * scaled_colours.size());
+                    this->cm.convert (std::span<const float>(scaled_colours), std::span<float>(rgb));
+                }
+            }
+
             for (int64_t p = 0; p < n_p; ++p) {
                 // Convert nest index p to angle for this pixel
                 hp::t_ang ang = hp::nest2ang (this->nside, p);
@@ -388,6 +491,8 @@ namespace mplot {
                     sc = (*this->colourdata)[p];
                 } else if (anticipate_colourdata == true) {
                     // Do nothing
+                } else if (!rgb.empty()) {
+                    sc = { rgb[3 * p], rgb[3 * p + 1], rgb[3 * p + 2] };
                 } else {
                     sc = this->cm.convert (scaled_colours[p]);
                 }
@@ -466,6 +571,43 @@ namespace mplot {
             if (this->enable_angles_map && this->angles.empty()) { this->populate_angles(); }
         }
 
+        //! Increment whenever the vertices made by initializeVertices() change
+        static constexpr uint32_t vertex_generator_version = 1u;
+
+        //! The vertices depend on the order, radius, relief, data and colour settings
+        uint64_t vertex_cache_key() override
+        {
+            // Labels are not cached, so models that show them are rebuilt each time
+            if (this->k == 0 || this->show_face_spheres || this->show_nest_labels) { return 0u; }
+            mplot::vertexcache::hasher hh;
+            hh.add_generator ("HealpixVisual", vertex_generator_version);
+            hh.add (sizeof (T));
+            hh.add (this->k);
+            hh.add (this->r);
+            hh.add (this->relief);
+            hh.add (this->show_spheres);
+            hh.add (this->indicate_axes);
+            hh.add_scale (this->colourScale);
+            hh.add_scale (this->reliefScale);
+            hh.add_colourmap (this->cm);
+            hh.add (this->pixeldata);
+            if (this->colourdata != nullptr) { hh.add (*this->colourdata); }
+            return hh.value();
+        }
+
+        //! Do the non-vertex work of initializeVertices(), including autoscaling the scales
+        bool vertex_cache_load_extra ([[maybe_unused]] std::istream& is) override
+        {
+            if (this->pixeldata.size() != static_cast<uint64_t>(this->n_pixels())) {
+                this->pixeldata.resize (this->n_pixels(), 0.0f);
+            }
+            sm::vvec<float> scaled_colours (this->pixeldata.size());
+            sm::vvec<float> scaled_relief (this->pixeldata.size());
+            this->scale_pixeldata (scaled_colours, scaled_relief);
+            if (this->enable_angles_map && this->angles.empty()) { this->populate_angles(); }
+            return true;
+        }
+
         // Draw a small set of coordinate arrows with origin at pixel 0
         void draw_coordaxes()
         {
@@ -556,6 +698,10 @@ namespace mplot {
         // What data to show on the healpix? Indexed by NEST index
         sm::vvec<T> pixeldata;
 
+        // The range of pixeldata when the scales last autoscaled (see updateData)
+        std::array<T, 2> data_range = { T{0}, T{0} };
+        bool data_range_valid = false;
+
         // If this is non-null, it'll be used to colour the Fourpi instead of pixeldata.
         std::vector<std::array<float, 3>>* colourdata = nullptr;
 
@@ -3,6 +3,9 @@
 #include <iostream>
 #include <vector>
 #include <array>
+#include <span>
+#include <algorithm>
+#include <cmath>
 #include <sm/vec>
 #include <sm/vvec>
 #include <sm/hexgrid>
@@ -58,9 +61,9 @@ namespace mplot {
     };
 
     //! The template argument T is the type of the data which this HexGridVisual
-    //! will visualize.
-    template <class T, int glver = mplot::gl::version_4_1>
-    class HexGridVisual : public VisualDataModel<T,glver>
+    //! will visualize. CM is the colour map type (see mplot::StaticColourMap).
+    template <class T, int glver = mplot::gl::version_4_1, typename CM = mplot::ColourMap<float>>
+    class HexGridVisual : public VisualDataModel<T,glver,CM>
     {
     public:
         //! Simplest constructor. Use this in all new code!
@@ -133,24 +136,75 @@ namespace mplot {
             this->reinit_buffers(); // could potentially be 'reinit_position_color_buffers_only()'
         }
 
+        using VisualDataModel<T,glver,CM>::updateData;
+
         // Override the updateData method
         void updateData (const std::vector<T>* _data)
         {
             this->scalarData = _data;
+            this->reinit_after_update();
+        }
+
+        //! Update the scalar data from a view of memory owned by the client
+        void updateData (mplot::strided_view<T> _data)
+        {
+            this->setScalarData (_data);
+            this->reinit_after_update();
+        }
+
+        //! Rebuild after new data, keeping the existing indices and normals where possible
+        void reinit_after_update()
+        {
             switch (this->hexVisMode) {
             case HexVisMode::Triangles:
             {
-                this->reinit_on_update(); // instead of VisualDataModel<T,glver>::reinit().
+                this->reinit_on_update(); // instead of VisualDataModel<T,glver,CM>::reinit().
                 break;
             }
             default:
             {
-                VisualDataModel<T,glver>::reinit();
+                VisualDataModel<T,glver,CM>::reinit();
                 break;
             }
             }
         }
 
+        /*!
+         * After a sparse updateData (indices, values), rewrite and upload only the vertices of the
+         * changed hexes. In Triangles mode each hex is one vertex, so its z and colour are updated
+         * in place. In HexInterp mode, the colours are updated in place, but a change of z moves
+         * the interpolated corners and normals of the neighbouring hexes too, so the model is
+         * rebuilt.
+         */
+        void reinit_at (std::span<const unsigned int> indices, const bool z_changed)
+        {
+            const std::size_t nhex = this->hg->num();
+            const bool posns_from_data = this->dataCoords == nullptr;
+            if (this->hexVisMode == HexVisMode::Triangles) {
+                if (this->vertexColors.size() < 3 * nhex) { this->reinit_after_update(); return; }
+                constexpr std::array<float, 3> blkclr = {0,0,0};
+                for (auto hi : indices) {
+                    const std::array<float, 3> clr = this->markedHexes.count(hi) ? blkclr : this->colourAt (hi);
+                    std::copy (clr.begin(), clr.end(), this->vertexColors.begin() + 3 * hi);
+                    if (posns_from_data) { this->vertexPositions[3 * hi + 2] = this->zoom * this->dcopy[hi]; }
+                }
+                this->reinit_buffer_ranges (this->vertex_ranges (indices, 1), z_changed && posns_from_data, false, true);
+                return;
+            }
+
+            if ((z_changed && posns_from_data) || this->showhexes == false || this->vertexColors.size() < 21 * nhex) {
+                this->reinit_after_update();
+                return;
+            }
+            for (auto hi : indices) {
+                const std::array<std::array<float, 3>, 7> clrs = this->hexColours (hi, this->colourAt (hi));
+                for (std::size_t j = 0; j < 7; ++j) {
+                    std::copy (clrs[j].begin(), clrs[j].end(), this->vertexColors.begin() + 3 * (7 * hi + j));
+                }
+            }
+            this->reinit_buffer_ranges (this->vertex_ranges (indices, 7), false, false, true);
+        }
+
         // Initialize vertex buffer objects and vertex array object.
 
         /*!
@@ -176,7 +230,7 @@ namespace mplot {
             }
 
             for (unsigned int hi = 0; hi < nhex; ++hi) {
-                std::array<float, 3> clr = this->setColour (hi);
+                std::array<float, 3> clr = this->colourAt (hi);
                 // If dataCoords has been populated, use these for hex positions, allowing for
                 // mapping of the 2D hexgrid onto a 3D manifold.
                 if (this->dataCoords == nullptr) {
@@ -330,14 +384,13 @@ namespace mplot {
 
                 // Use a single colour for each hex, even though hex z positions are
                 // interpolated. Do the _colour_ scaling:
-                std::array<float, 3> clr = this->setColour (hi);
+                std::array<float, 3> clr = this->colourAt (hi);
                 if (this->showboundary && (this->hg->vhexen[hi])->boundaryHex() == true) {
                     this->markHex (hi);
                 }
                 if (this->showcentre && _x == 0.0f && _y == 0.0f) {
                     this->markHex (hi);
                 }
-                std::array<float, 3> blkclr = {0,0,0};
 
                 // First push the 7 positions of the triangle vertices, starting with the centre
 
@@ -541,40 +594,7 @@ namespace mplot {
                 this->vertex_push (vnorm, this->vertexNormals);
                 this->vertex_push (vnorm, this->vertexNormals);
 
-                // Usually seven vertices with the same colour, but if the hex is
-                // marked, then three of the vertices are given the colour black,
-                // marking the hex out visually.
-                if (std::isnan(this->dcolour[hi])) {
-                    this->vertex_push (clr, this->vertexColors);
-                    this->vertex_push (blkclr, this->vertexColors);
-                    this->vertex_push (blkclr, this->vertexColors);
-                    this->vertex_push (blkclr, this->vertexColors);
-                    this->vertex_push (blkclr, this->vertexColors);
-                    this->vertex_push (blkclr, this->vertexColors);
-                    this->vertex_push (blkclr, this->vertexColors);
-                } else {
-                    this->vertex_push (clr, this->vertexColors);
-                    if (this->markedHexes.count(hi)) {
-                        this->vertex_push (blkclr, this->vertexColors);
-                    } else {
-                        this->vertex_push (clr, this->vertexColors);
-                    }
-
-                    this->vertex_push (clr, this->vertexColors);
-
-                    if (this->markedHexes.count(hi)) {
-                        this->vertex_push (blkclr, this->vertexColors);
-                    } else {
-                        this->vertex_push (clr, this->vertexColors);
-                    }
-                    this->vertex_push (clr, this->vertexColors);
-                    if (this->markedHexes.count(hi)) {
-                        this->vertex_push (blkclr, this->vertexColors);
-                    } else {
-                        this->vertex_push (clr, this->vertexColors);
-                    }
-                    this->vertex_push (clr, this->vertexColors);
-                }
+                for (const auto& c : this->hexColours (hi, clr)) { this->vertex_push (c, this->vertexColors); }
 
                 // Define indices now to produce the 6 triangles in the hex
                 this->indices.push_back (this->idx+1);
@@ -605,6 +625,22 @@ namespace mplot {
             }
         }
 
+        /*!
+         * The colours of the 7 vertices of hex hi in HexInterp mode, given its colour clr. Usually
+         * all seven have the same colour, but if the hex is marked, then three of the vertices are
+         * given the colour black, marking the hex out visually. A hex with no (NaN) datum has
+         * a coloured centre and black corners.
+         */
+        std::array<std::array<float, 3>, 7> hexColours (const unsigned int hi, const std::array<float, 3>& clr) const
+        {
+            constexpr std::array<float, 3> blkclr = {0,0,0};
+            if (std::isnan (this->dcolour[hi])) {
+                return { clr, blkclr, blkclr, blkclr, blkclr, blkclr, blkclr };
+            }
+            const std::array<float, 3>& mclr = this->markedHexes.count(hi) ? blkclr : clr;
+            return { clr, mclr, clr, mclr, clr, mclr, clr };
+        }
+
         // Show a Flat surface for the zero plane. Currently, this is expensively
         // plotting out all the hexes because that was easy. it could be simply a big
         // rectangle of two triangles.
@@ -118,7 +118,7 @@ namespace mplot {
 
                 for (int j = 0; j < static_cast<int>(this->numsegs); j++) {
 
-                    std::array<float, 3> clr = this->setColour ((ring - 1) * this->numsegs + j);
+                    std::array<float, 3> clr = this->colourAt ((ring - 1) * this->numsegs + j);
 
                     float t = j * sm::mathconst<float>::two_pi/static_cast<float>(this->numsegs);
 
@@ -9,6 +9,10 @@
 #include <iostream>
 #include <vector>
 #include <array>
+#include <span>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
 #include <sm/vec>
 #include <mplot/tools.h>
 #include <mplot/VisualDataModel.h>
@@ -65,6 +69,38 @@ namespace mplot {
             this->reinit_buffers();
         }
 
+        using VisualDataModel<Flt, glver>::updateData;
+
+        /*!
+         * Recolour only the markers at indices, whose new scalar values are values. Markers of a
+         * fixed size all have the same number of vertices, so marker i's vertices are found and
+         * recoloured in place. A full rebuild is made if the markers are sized by value
+         * (sizeFactor is non-zero), if the data are vectors or if colourScale has yet to be
+         * autoscaled; the client's scalarData must then already hold the new values.
+         */
+        void updateData (std::span<const unsigned int> indices, std::span<const Flt> values) override
+        {
+            if (indices.size() != values.size()) {
+                throw std::runtime_error ("ScatterVisual::updateData: indices and values differ in size");
+            }
+            const std::size_t ncoords = this->dataCoords == nullptr ? 0 : this->dataCoords->size();
+            const std::size_t nverts = this->vertexColors.size() / 3;
+            if (this->sizeFactor != Flt{0} || this->vectorData != nullptr || this->scalarData == nullptr
+                || ncoords == 0 || nverts % ncoords != 0 || !this->colourScale.ready()) {
+                this->reinit();
+                return;
+            }
+            const std::size_t nv = nverts / ncoords; // vertices per marker
+            for (std::size_t k = 0; k < indices.size(); ++k) {
+                if (indices[k] >= ncoords) { throw std::runtime_error ("ScatterVisual::updateData: index out of range"); }
+                const std::array<float, 3> clr = this->cm.convert (this->colourScale.transform_one (values[k]));
+                for (std::size_t j = 0; j < nv; ++j) {
+                    std::copy (clr.begin(), clr.end(), this->vertexColors.begin() + 3 * (nv * indices[k] + j));
+                }
+            }
+            this->reinit_buffer_ranges (this->vertex_ranges (indices, nv), false, false, true);
+        }
+
         //! Compute spheres for a scatter plot
         void initializeVertices()
         {
@@ -120,16 +156,29 @@ namespace mplot {
 
             } // else no scaling required - spheres will be one colour
 
+            // Convert the colours in one pass
+            this->rgb.clear();
+            if constexpr (std::is_same_v<std::decay_t<Flt>, float>) {
+                if (ndata && !nvdata) {
+                    this->rgb.resize (3 * dcopy.size());
+                    this->cm.convert (std::span<const float>(dcopy), std::span<float>(this->rgb));
+                } else if (nvdata) {
+                    this->rgb.resize (3 * vdcopy1.size());
+                    this->cm.convert (std::span<const float>(vdcopy1), std::span<const float>(vdcopy2),
+                                      std::span<float>(this->rgb));
+                }
+            }
+
             for (unsigned int i = 0; i < ncoords; ++i) {
                 // Scale colour (or use single colour)
                 std::array<float, 3> clr = this->cm.getHueRGB();
                 if (ndata && !nvdata) {
-                    clr = this->cm.convert (dcopy[i]);
+                    clr = this->rgb.empty() ? this->cm.convert (dcopy[i]) : this->colourAt (i);
                 } else if (nvdata) {
                     // Combine colour from two values. vdcopy1, vdcopy2? OR just do RGB for now?
                     // ColourMap in 'dual hue' (or triple hue) mode.
                     //std::cout << "Convert colour from vdcopy1[i]: " << vdcopy1[i] << ", vdcopy2[i]: " << vdcopy2[i] << std::endl;
-                    clr = this->cm.convert (vdcopy1[i], vdcopy2[i]);
+                    clr = this->rgb.empty() ? this->cm.convert (vdcopy1[i], vdcopy2[i]) : this->colourAt (i);
                 }
 
                 if (this->sizeFactor == Flt{0}) {
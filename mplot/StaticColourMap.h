@@ -0,0 +1,130 @@
+/*!
+ * \file
+ *
+ * A ColourMap whose type is fixed at compile time.
+ *
+ * \author Seb James
+ * \date October 2026
+ */
+#pragma once
+
+#include <array>
+#include <span>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <mplot/ColourMap.h>
+
+namespace mplot
+{
+    /*!
+     * A ColourMap with its ColourMapType given as a template parameter
+     *
+     * ColourMap::convert examines the map type on every call. When the type is known when the
+     * program is compiled, StaticColourMap resolves the colour table at compile time so that
+     * convert (and the bulk, span-based convert) compiles down to a clamp, a round and a table
+     * read. Loops that colour many data (such as a GridVisual rebuild) can then be inlined and
+     * vectorised by the compiler. Use one as the CM template parameter of a VisualDataModel
+     * derived class:
+     *
+     * mplot::GridVisual<float, int, float, mplot::gl::version_4_1,
+     *                   mplot::StaticColourMap<mplot::ColourMapType::Viridis>> gv (&grid, offset);
+     *
+     * Maps that are computed, rather than listed (Fire, Monochrome, HSV and so on) are accepted,
+     * but they convert via ColourMap<T>::convert, and so gain nothing from the fixed type.
+     *
+     * The type can't be changed. There is no setType, and VisualDataModel::setColourMap fails to
+     * compile for a model whose CM is a StaticColourMap.
+     *
+     * \tparam cmt The colour map type
+     *
+     * \tparam T The type of the datum, as for ColourMap<T>
+     */
+    template <ColourMapType cmt, typename T = float>
+    class StaticColourMap : private ColourMap<T>
+    {
+    public:
+        StaticColourMap() : ColourMap<T> (cmt) {}
+
+        //! The colour map type, which can't be changed. VisualDataModel checks for this member.
+        static constexpr ColourMapType fixed_type = cmt;
+
+        //! The colour table for cmt. Empty if cmt is a computed colour map.
+        static constexpr std::span<const std::array<float, 3>> table = ColourMap<T>::listed_table (cmt);
+
+        /*
+         * ColourMap<T> is a private base, so that a StaticColourMap can't be passed as a
+         * ColourMap<T>& and have its type changed with setType. Everything else is made public.
+         */
+        using ColourMap<T>::flags;
+        using ColourMap<T>::range_max;
+        using ColourMap<T>::numDatums;
+        using ColourMap<T>::nanColour;
+        using ColourMap<T>::unit_datum;
+        using ColourMap<T>::compute;
+        using ColourMap<T>::convert_angular;
+        using ColourMap<T>::convertWithSaturation;
+        using ColourMap<T>::getType;
+        using ColourMap<T>::getTypeStr;
+        using ColourMap<T>::getFlagsStr;
+        using ColourMap<T>::setHue;
+        using ColourMap<T>::setSat;
+        using ColourMap<T>::setVal;
+        using ColourMap<T>::getHue;
+        using ColourMap<T>::getSat;
+        using ColourMap<T>::getVal;
+        using ColourMap<T>::setHSV;
+        using ColourMap<T>::setRGB;
+        using ColourMap<T>::getHueRGB;
+        using ColourMap<T>::setHueRotation;
+        using ColourMap<T>::setHueReverse;
+        using ColourMap<T>::set_act_2d;
+        using ColourMap<T>::strToColourMapType;
+        using ColourMap<T>::colourMapTypeToStr;
+        using ColourMap<T>::colourMapFlagsToStr;
+        using ColourMap<T>::listed_table;
+        using ColourMap<T>::hsv2rgb;
+        using ColourMap<T>::rgb2hsv;
+
+        //! Read only access to the ColourMap, for code that takes a const ColourMap<T>&
+        const ColourMap<T>& colourmap() const { return *this; }
+
+        // The 2 and 3 datum converts are those of ColourMap<T>
+        using ColourMap<T>::convert;
+
+        //! Convert the scalar datum into an RGB colour
+        std::array<float, 3> convert (T _datum) const
+        {
+            if constexpr (table.empty()) {
+                return ColourMap<T>::convert (_datum);
+            } else {
+                const float datum = this->unit_datum (_datum);
+                if constexpr (std::is_floating_point<std::decay_t<T>>::value == true) {
+                    if (std::isnan (datum)) { return ColourMap<T>::nanColour (cmt); }
+                }
+                return table[static_cast<std::size_t>(std::round (datum * static_cast<float>(table.size() - 1)))];
+            }
+        }
+
+        //! Convert many scalar data into colours, writing three floats per datum into rgb_out
+        void convert (std::span<const T> data, std::span<float> rgb_out) const
+        {
+            if constexpr (table.empty()) {
+                ColourMap<T>::convert (data, rgb_out);
+            } else {
+                if (rgb_out.size() < 3 * data.size()) {
+                    throw std::runtime_error ("StaticColourMap::convert: rgb_out is too small");
+                }
+                float* out = rgb_out.data();
+                for (std::size_t i = 0; i < data.size(); ++i) {
+                    const std::array<float, 3> c = this->convert (data[i]);
+                    out[3 * i] = c[0];
+                    out[3 * i + 1] = c[1];
+                    out[3 * i + 2] = c[2];
+                }
+            }
+        }
+    };
+
+} // namespace mplot
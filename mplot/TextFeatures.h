@@ -46,6 +46,20 @@ namespace mplot {
         std::array<float, 3> colour = mplot::colour::black;
         //! The supported font to use when displaying a text string
         mplot::VisualFont font = mplot::VisualFont::DVSans;
+        /*!
+         * If true, draw the text from a signed distance field glyph atlas. This ignores fontres:
+         * one atlas at sdf_fontres serves every font size, and the text stays sharp at any zoom.
+         * The default for new TextFeatures is taken from sdf_default.
+         */
+        bool sdf = sdf_default;
+
+        //! The initial value of sdf for new TextFeatures
+        static inline bool sdf_default = false;
+        //! The pixel resolution at which signed distance field glyphs are generated
+        static constexpr int sdf_fontres = 64;
+
+        //! The pixel resolution of the glyph textures that will actually be used
+        int texture_res() const { return this->sdf ? sdf_fontres : this->fontres; }
 
         // Maybe also things like rotate, centre_vert, etc
     };
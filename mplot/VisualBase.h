@@ -14,7 +14,12 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <sstream>
+#include <fstream>
+#include <limits>
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
 
 #include <sm/flags>
 #include <sm/quaternion>
@@ -27,6 +32,7 @@
 #include <mplot/TextGeometry.h>
 #include <mplot/VisualCommon.h>
 #include <mplot/gl/shaders.h>
+#include <mplot/gl/program_cache.h>
 #include <mplot/keys.h>
 #include <mplot/version.h>
 
@@ -41,6 +47,7 @@
 #define LODEPNG_NO_COMPILE_DECODER 1
 #define LODEPNG_NO_COMPILE_ANCILLARY_CHUNKS 1
 #include <mplot/lodepng.h>
+#include <mplot/savepng.h>
 
 namespace mplot {
 
@@ -174,6 +181,10 @@ namespace mplot {
         //! failure. Set transparent_bg to get a transparent background.
         virtual sm::vec<int, 2> saveImage (const std::string& img_filename, const bool transparent_bg = false) = 0;
 
+        //! Options for the PNG encoder used by saveImage. Choose compression level 'best' to get
+        //! the (slower) lodepng encoder.
+        mplot::png::encoder_options png_options;
+
         /*!
          * Set up the passed-in VisualModel (or indeed, VisualTextModel) with functions that need access to Visual attributes.
          */
@@ -184,6 +195,8 @@ namespace mplot {
             model->get_shaderprogs = &mplot::VisualBase<glver>::get_shaderprogs;
             model->get_gprog = &mplot::VisualBase<glver>::get_gprog;
             model->get_tprog = &mplot::VisualBase<glver>::get_tprog;
+            // VisualTextModels have no lines to draw
+            if constexpr (requires { model->get_lprog; }) { model->get_lprog = &mplot::VisualBase<glver>::get_lprog; }
         }
 
         /*!
@@ -283,10 +296,46 @@ namespace mplot {
         mplot::visgl::visual_shaderprogs shaders;
         //! Which shader is active for graphics shading?
         mplot::visgl::graphics_shader_type active_gprog = mplot::visgl::graphics_shader_type::none;
+        //! The linked projection2d and cylindrical graphics programs. Once linked, each is kept
+        //! until deconstructCommon() so that switching projection just changes shaders.gprog.
+        GLuint gprog_proj2d = 0;
+        GLuint gprog_cyl = 0;
+        /*!
+         * If not empty, linked shader program binaries are cached in this directory to save
+         * compiling and linking the shaders on later runs (see mplot/gl/program_cache.h). The
+         * cache is off by default; it is set from the environment variable MPLOT_SHADER_CACHE.
+         * Because the shaders are loaded in init_gl(), this must be changed before then to have
+         * an effect (i.e. when using the default constructor, as in a Qt widget).
+         */
+        std::filesystem::path shader_cache_dir = mplot::gl::program_cache::env_dir();
+        /*!
+         * Opt in to sharing GL objects between Visuals. A Visual that is created while this is true
+         * shares one FT_Library and one set of glyph atlases with all the other sharing Visuals in
+         * the process. These are reference counted and freed with the last sharing Visual. GLFW
+         * windows are created with a shared context. For Qt, also set Qt::AA_ShareOpenGLContexts.
+         */
+        static inline bool share_gl_resources = false;
+        //! True if this Visual was created while share_gl_resources was set
+        const bool shares_resources = share_gl_resources;
+        /*!
+         * If true, VisualTextModels don't draw themselves. Instead, each adds its quads to the
+         * text_batch for its glyph atlas and alpha and at the end of render() the Visual draws each batch
+         * with one call. The batches are rebuilt and uploaded on every render() and all text is
+         * drawn after the models, so this is off by default. It helps scenes with hundreds of
+         * labels, where draw calls dominate.
+         */
+        bool batch_text = false;
+        //! The text quads collected during the current render(), one batch per glyph atlas and alpha
+        std::vector<mplot::visgl::text_batch> text_batches;
+        //! The vertex array and buffers (positions, colours, uvs, indices) for drawing text_batches
+        GLuint text_batch_vao = 0;
+        std::array<GLuint, 4> text_batch_vbos = { 0, 0, 0, 0 };
         //! Stores the info required to load the 2D projection shader
         std::vector<mplot::gl::ShaderInfo> proj2d_shader_progs;
         //! Stores the info required to load the text shader
         std::vector<mplot::gl::ShaderInfo> text_shader_progs;
+        //! Stores the info required to load the line shader
+        std::vector<mplot::gl::ShaderInfo> line_shader_progs;
 
         //! Stores the info required to load the cylindrical projection shader
         std::vector<mplot::gl::ShaderInfo> cyl_shader_progs;
@@ -304,6 +353,12 @@ namespace mplot {
         static mplot::visgl::visual_shaderprogs get_shaderprogs (mplot::VisualBase<glver>* _v) { return _v->shaders; };
         static GLuint get_gprog (mplot::VisualBase<glver>* _v) { return _v->shaders.gprog; };
         static GLuint get_tprog (mplot::VisualBase<glver>* _v) { return _v->shaders.tprog; };
+        //! The line program is linked the first time a VisualModel draws polylines
+        static GLuint get_lprog (mplot::VisualBase<glver>* _v)
+        {
+            if (!_v->shaders.lprog) { _v->load_line_program(); }
+            return _v->shaders.lprog;
+        };
 
         //! The colour of ambient and diffuse light sources
         sm::vec<float, 3> light_colour = { 1.0f, 1.0f, 1.0f };
@@ -621,6 +676,182 @@ namespace mplot {
             fout.close();
         }
 
+        /*!
+         * Save all the VisualModels in this Visual out to a binary glTF (.glb) file. The vertex
+         * data is streamed straight from each VisualModel's vertex vectors into the file's binary
+         * chunk, so peak memory use stays close to the size of the models.
+         *
+         * If quantise is true, use the KHR_mesh_quantization extension to store positions as
+         * normalized shorts (with the dequantization in each node's translation and scale),
+         * colours as normalized unsigned bytes, normals as normalized bytes and indices as unsigned
+         * shorts where possible. This makes files about 3 times smaller.
+         */
+        virtual void saveglb (const std::string& glb_file, const bool quantise = false)
+        {
+            // Models without triangles can't be exported (glTF disallows empty bufferViews)
+            std::vector<std::size_t> models;
+            for (std::size_t vmi = 0u; vmi < this->vm.size(); ++vmi) {
+                if (this->vm[vmi]->indices_size() > 0u && this->vm[vmi]->vpos_size() > 0u) { models.push_back (vmi); }
+            }
+
+            // Lay out the binary chunk. There are four bufferViews per model: indices, position,
+            // colour and normal. Each starts on a 4 byte boundary.
+            auto pad4 = [](std::size_t n) { return (n + 3u) & ~std::size_t{3}; };
+            std::vector<std::array<std::size_t, 4>> view_offsets (models.size());
+            std::vector<std::array<std::size_t, 4>> view_lengths (models.size());
+            std::vector<bool> short_indices (models.size(), false);
+            std::size_t binlen = 0u;
+            for (std::size_t m = 0u; m < models.size(); ++m) {
+                auto& vmp = this->vm[models[m]];
+                vmp->computeVertexMaxMins();
+                const std::size_t nv = vmp->vpos_size() / 3u;
+                short_indices[m] = quantise && vmp->indices_fit_u16();
+                view_lengths[m][0] = vmp->indices_size() * (short_indices[m] ? 2u : 4u);
+                view_lengths[m][1] = nv * (quantise ? 8u : 12u);
+                view_lengths[m][2] = nv * (quantise ? 4u : 12u);
+                view_lengths[m][3] = nv * (quantise ? 4u : 12u);
+                for (std::size_t v = 0u; v < 4u; ++v) {
+                    view_offsets[m][v] = binlen;
+                    binlen += pad4 (view_lengths[m][v]);
+                }
+            }
+
+            // The JSON chunk
+            std::stringstream js;
+            js << "{\n  \"scenes\" : [ { \"nodes\" : [ ";
+            for (std::size_t m = 0u; m < models.size(); ++m) { js << m << (m < models.size()-1 ? ", " : ""); }
+            js << " ] } ],\n";
+
+            js << "  \"nodes\" : [\n";
+            for (std::size_t m = 0u; m < models.size(); ++m) {
+                auto& vmp = this->vm[models[m]];
+                js << "    { \"mesh\" : " << m;
+                if (quantise) {
+                    sm::vec<float, 3> t = vmp->get_mv_offset() + vmp->vpos_quant_centre();
+                    js << ", \"translation\" : " << t.str_mat()
+                       << ", \"scale\" : " << vmp->vpos_quant_halfwidth().str_mat();
+                } else {
+                    js << ", \"translation\" : " << vmp->translation_str();
+                }
+                js << (m < models.size()-1 ? " },\n" : " }\n");
+            }
+            js << "  ],\n";
+
+            js << "  \"meshes\" : [\n";
+            for (std::size_t m = 0u; m < models.size(); ++m) {
+                js << "    { \"primitives\" : [ { \"attributes\" : { \"POSITION\" : " << 1+m*4
+                   << ", \"COLOR_0\" : " << 2+m*4
+                   << ", \"NORMAL\" : " << 3+m*4 << " }, \"indices\" : " << m*4 << ", \"material\": 0 } ] }"
+                   << (m < models.size()-1 ? ",\n" : "\n");
+            }
+            js << "  ],\n";
+
+            js << "  \"buffers\" : [ { \"byteLength\" : " << binlen << " } ],\n";
+
+            js << "  \"bufferViews\" : [\n";
+            for (std::size_t m = 0u; m < models.size(); ++m) {
+                for (std::size_t v = 0u; v < 4u; ++v) {
+                    js << "    { \"buffer\" : 0, \"byteOffset\" : " << view_offsets[m][v]
+                       << ", \"byteLength\" : " << view_lengths[m][v];
+                    if (v == 0u) {
+                        js << ", \"target\" : 34963";
+                    } else {
+                        // Quantised attributes are padded to keep each element 4 byte aligned
+                        if (quantise) { js << ", \"byteStride\" : " << (v == 1u ? 8 : 4); }
+                        js << ", \"target\" : 34962";
+                    }
+                    js << ((m < models.size()-1 || v < 3u) ? " },\n" : " }\n");
+                }
+            }
+            js << "  ],\n";
+
+            js << "  \"accessors\" : [\n";
+            for (std::size_t m = 0u; m < models.size(); ++m) {
+                auto& vmp = this->vm[models[m]];
+                const std::size_t nv = vmp->vpos_size() / 3u;
+                // 5120 byte, 5121 unsigned byte, 5122 short, 5123 unsigned short, 5125 unsigned int, 5126 float
+                js << "    { \"bufferView\" : " << m*4 << ", \"componentType\" : " << (short_indices[m] ? 5123 : 5125)
+                   << ", \"type\" : \"SCALAR\", \"count\" : " << vmp->indices_size() << " },\n";
+                if (quantise) {
+                    // With normalized shorts, the quantised extents are always +-32767 (or 0 in a flat dimension)
+                    sm::vec<int, 3> qmax = vmp->vpos_quant_max();
+                    sm::vec<int, 3> qmin = { -qmax[0], -qmax[1], -qmax[2] };
+                    js << "    { \"bufferView\" : " << 1+m*4 << ", \"componentType\" : 5122, \"normalized\" : true"
+                       << ", \"type\" : \"VEC3\", \"count\" : " << nv
+                       << ", \"max\" : " << qmax.str_mat() << ", \"min\" : " << qmin.str_mat() << " },\n";
+                    js << "    { \"bufferView\" : " << 2+m*4 << ", \"componentType\" : 5121, \"normalized\" : true"
+                       << ", \"type\" : \"VEC3\", \"count\" : " << nv << " },\n";
+                    js << "    { \"bufferView\" : " << 3+m*4 << ", \"componentType\" : 5120, \"normalized\" : true"
+                       << ", \"type\" : \"VEC3\", \"count\" : " << nv << " }";
+                } else {
+                    js << "    { \"bufferView\" : " << 1+m*4 << ", \"componentType\" : 5126"
+                       << ", \"type\" : \"VEC3\", \"count\" : " << nv
+                       << ", \"max\" : " << vmp->vpos_max() << ", \"min\" : " << vmp->vpos_min() << " },\n";
+                    js << "    { \"bufferView\" : " << 2+m*4 << ", \"componentType\" : 5126"
+                       << ", \"type\" : \"VEC3\", \"count\" : " << nv << " },\n";
+                    js << "    { \"bufferView\" : " << 3+m*4 << ", \"componentType\" : 5126"
+                       << ", \"type\" : \"VEC3\", \"count\" : " << nv << " }";
+                }
+                js << (m < models.size()-1 ? ",\n" : "\n");
+            }
+            js << "  ],\n";
+
+            js << "  \"materials\" : [ { \"doubleSided\" : true } ],\n";
+            if (quantise) {
+                js << "  \"extensionsUsed\" : [ \"KHR_mesh_quantization\" ],\n"
+                   << "  \"extensionsRequired\" : [ \"KHR_mesh_quantization\" ],\n";
+            }
+            js << "  \"asset\" : {\n"
+               << "    \"generator\" : \"https://github.com/ABRG-Models/mplotologica: mplot::Visual::saveglb() (ver "
+               << mplot::version_string() << ")\",\n"
+               << "    \"version\" : \"2.0\"\n"
+               << "  }\n";
+            js << "}";
+            std::string json = js.str();
+            // The JSON chunk is padded with spaces
+            json.append (pad4 (json.size()) - json.size(), ' ');
+            if (12u + 8u + json.size() + 8u + binlen > std::numeric_limits<uint32_t>::max()) {
+                throw std::runtime_error ("Visual::saveglb(): Scene too large for a .glb file (4 GB limit)");
+            }
+
+            std::ofstream fout;
+            fout.open (glb_file, std::ios::out|std::ios::trunc|std::ios::binary);
+            if (!fout.is_open()) { throw std::runtime_error ("Visual::saveglb(): Failed to open file for writing"); }
+
+            auto write_u32 = [&fout](uint32_t u) {
+                const char b[4] = { static_cast<char>(u & 0xff), static_cast<char>(u >> 8 & 0xff),
+                                    static_cast<char>(u >> 16 & 0xff), static_cast<char>(u >> 24 & 0xff) };
+                fout.write (b, 4);
+            };
+
+            // Header: magic "glTF", version 2 and total length
+            write_u32 (0x46546c67u);
+            write_u32 (2u);
+            write_u32 (static_cast<uint32_t>(12u + 8u + json.size() + 8u + binlen));
+            // JSON chunk
+            write_u32 (static_cast<uint32_t>(json.size()));
+            write_u32 (0x4e4f534au);
+            fout.write (json.data(), json.size());
+            // BIN chunk, streamed model by model
+            write_u32 (static_cast<uint32_t>(binlen));
+            write_u32 (0x004e4942u);
+            for (std::size_t m = 0u; m < models.size(); ++m) {
+                auto& vmp = this->vm[models[m]];
+                vmp->write_indices_glb (fout, short_indices[m]);
+                if (quantise) {
+                    vmp->write_vpos_quantised_glb (fout);
+                    vmp->write_vcol_quantised_glb (fout);
+                    vmp->write_vnorm_quantised_glb (fout);
+                } else {
+                    vmp->write_vpos_glb (fout);
+                    vmp->write_vcol_glb (fout);
+                    vmp->write_vnorm_glb (fout);
+                }
+            }
+            if (!fout) { throw std::runtime_error ("Visual::saveglb(): Failed writing file"); }
+            fout.close();
+        }
+
         void set_winsize (int _w, int _h) { this->window_w = _w; this->window_h = _h; }
 
     protected:
@@ -663,6 +894,10 @@ namespace mplot {
         // required to render the Visual.
         virtual void init_gl() = 0;
 
+        //! Link the line shader program (line_shader_progs) into shaders.lprog and set its
+        //! projection. Called with the context current, from within render().
+        virtual void load_line_program() = 0;
+
         //! The window (and OpenGL context) for this Visual
         mplot::win_t* window = nullptr;
 
@@ -9,6 +9,11 @@
 #include <stdexcept>
 #include <iostream>
 #include <cstring>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <vector>
 #include <sm/vec>
 #include <mplot/tools.h>
 
@@ -25,6 +30,9 @@ namespace mplot {
             unsigned int /*GLuint*/ gprog = 0;
             //! A text shader program, which uses textures to draw text on quads.
             unsigned int /*GLuint*/ tprog = 0;
+            //! A line shader program, which expands polyline segments into quads on the GPU. It is
+            //! linked the first time a VisualModel draws polylines.
+            unsigned int /*GLuint*/ lprog = 0;
         };
 
         // This defines different graphics shader types, as used in mplot::Visual. The essential
@@ -41,10 +49,109 @@ namespace mplot {
         //! mplot::Visual GLSL programs
         enum AttribLocn { posnLoc = 0, normLoc = 1, colLoc = 2, textureLoc = 3 };
 
+        //! The locations of the vertex attributes of the line shader program: the points before,
+        //! at the start of, at the end of and after a segment. These are consecutive points of one
+        //! buffer, so that the attributes are bound at consecutive offsets.
+        enum LineAttribLocn { linePrevLoc = 0, lineStartLoc = 1, lineEndLoc = 2, lineNextLoc = 3 };
+
+        /*!
+         * A line through a sequence of points in the x-y plane of a VisualModel, drawn by the line
+         * shader program. Only the points are uploaded to the GPU; the vertex shader expands each
+         * segment into a quad of the given width. So, unlike lines made with
+         * VisualModel::computeFlatLine, the width, colour, joins and dashes can be changed without
+         * remaking any vertices.
+         *
+         * Each point is held as (x, y, s), where s is the distance along the line to the point, which
+         * sets the phase of the dashes. The first and last points are duplicated at either end of
+         * the points array, so that every segment has a point before and a point after it.
+         */
+        struct polyline
+        {
+            //! 3 floats per point, with the first and last points repeated (see size())
+            std::vector<float> points;
+            //! The line colour
+            std::array<float, 3> colour = { 0.0f, 0.0f, 0.0f };
+            //! Width of the line, in model units
+            float width = 0.01f;
+            //! The z of the plane that the line lies in
+            float z = 0.0f;
+            //! If true, segments have round ends, giving round joins (and caps). Otherwise,
+            //! segments meet in miter joins and the line has square ends.
+            bool round = false;
+            //! Length of the dashes, if dashed. 0 for a solid line.
+            float dash = 0.0f;
+            //! Length of the gaps between dashes
+            float dashgap = 0.0f;
+            //! If non-zero, each segment is shortened by this much at each end (leaving room for a
+            //! graph's markers) and is not joined to its neighbours
+            float shorten = 0.0f;
+
+            //! Add a point to the end of the line
+            void push_back (const float x, const float y)
+            {
+                const std::size_t n_slots = this->points.size() / 3;
+                if (n_slots == 0) {
+                    this->points = { x, y, 0.0f, x, y, 0.0f, x, y, 0.0f };
+                    return;
+                }
+                // Overwrite the duplicate of the last point with the new point, then duplicate that
+                const float* last = this->points.data() + 3 * (n_slots - 2);
+                const float s = last[2] + std::hypot (x - last[0], y - last[1]);
+                float* dup = this->points.data() + 3 * (n_slots - 1);
+                dup[0] = x;
+                dup[1] = y;
+                dup[2] = s;
+                this->points.insert (this->points.end(), { x, y, s });
+                this->n_uploaded = std::min (this->n_uploaded, n_slots - 1);
+            }
+
+            //! The number of points in the line
+            std::size_t size() const { return this->points.empty() ? 0 : this->points.size() / 3 - 2; }
+            //! The number of segments in the line, each of which is drawn as one instance
+            std::size_t segments() const { return this->size() < 2 ? 0 : this->size() - 1; }
+
+            // GL state, managed by VisualModelImpl
+            //! The vertex array object and the buffer that holds points
+            unsigned int vao = 0;
+            unsigned int vbo = 0;
+            //! The number of points (including the duplicates) that the buffer has room for
+            std::size_t buffer_capacity = 0;
+            //! The number of the points (including the duplicates) that are up to date in the buffer
+            std::size_t n_uploaded = 0;
+        };
+
+        /*!
+         * Text quads from any number of VisualTextModels that share a glyph atlas and an alpha,
+         * gathered up so that they can be drawn in a single call (see VisualBase::batch_text). Positions are
+         * already transformed into the scene's eye space.
+         */
+        struct text_batch
+        {
+            //! The glyph atlas texture that all the quads in the batch sample
+            unsigned int texture = 0;
+            //! True if the atlas holds signed distance fields
+            bool sdf = false;
+            //! The model-wide alpha of the texts in the batch
+            float alpha = 1.0f;
+            std::vector<float> positions;
+            std::vector<float> colours;
+            std::vector<float> uvs;
+            std::vector<unsigned int> indices;
+
+            //! Empty the batch, keeping the memory for the next frame
+            void clear()
+            {
+                this->positions.clear();
+                this->colours.clear();
+                this->uvs.clear();
+                this->indices.clear();
+            }
+        };
+
         //! A struct to hold information about font glyph properties
         struct CharInfo
         {
-            //! ID handle of the glyph texture
+            //! ID handle of the texture (the face's glyph atlas) containing the glyph
             unsigned int textureID;
             //! Size of glyph
             sm::vec<int,2>  size;
@@ -52,6 +159,8 @@ namespace mplot {
             sm::vec<int,2>  bearing;
             //! Offset to advance to next glyph
             unsigned int advance;
+            //! Position of the glyph's top left corner within the atlas texture, in texels
+            sm::vec<int,2>  atlas_pos;
         };
 
     } // namespace gl
@@ -4,18 +4,28 @@
 #pragma once
 
 #include <vector>
+#include <span>
+#include <array>
+#include <algorithm>
+#include <thread>
 #include <cstdint>
+#include <cmath>
+#include <limits>
+#include <type_traits>
 #include <sm/vec>
 #include <sm/vvec>
 #include <sm/scale>
 #include <mplot/VisualModel.h>
 #include <mplot/ColourMap.h>
+#include <mplot/strided_view.h>
+#include <mplot/range_tracker.h>
 
 namespace mplot
 {
     //! Class for VisualModels that visualize data of type T. T is probably float or
-    //! double, but may be integer types, too.
-    template <typename T, int glver = mplot::gl::version_4_1>
+    //! double, but may be integer types, too. CM is the type of the colour map, cm. Pass an
+    //! mplot::StaticColourMap to fix the map type at compile time.
+    template <typename T, int glver = mplot::gl::version_4_1, typename CM = ColourMap<float>>
     struct VisualDataModel : public VisualModel<glver>
     {
         VisualDataModel() : mplot::VisualModel<glver>::VisualModel() {}
@@ -48,6 +58,19 @@ namespace mplot
         void setCScale (const sm::scale<T, float>& cscale) { this->colourScale = cscale; }
         void setScalarData (const std::vector<T>* _data) { this->scalarData = _data; }
         void setVectorData (const std::vector<sm::vec<T>>* _vectors) { this->vectorData = _vectors; }
+        //! Visualise scalar data in place, without copying it into a std::vector. The viewed
+        //! memory must remain valid until the model is next rebuilt.
+        void setScalarData (mplot::strided_view<T> _data)
+        {
+            this->scalarData = nullptr;
+            this->scalarView = _data;
+        }
+        //! Visualise vector data in place
+        void setVectorData (mplot::strided_view<sm::vec<T>> _vectors)
+        {
+            this->vectorData = nullptr;
+            this->vectorView = _vectors;
+        }
         void setDataCoords (std::vector<sm::vec<float>>* _coords) { this->dataCoords = _coords; }
 
         void updateZScale (const sm::scale<T, float>& zscale)
@@ -70,6 +93,8 @@ namespace mplot
 
         void setColourMap (ColourMapType _cmt, const float _hue = 0.0f)
         {
+            static_assert (!requires { CM::fixed_type; },
+                           "VisualDataModel::setColourMap: The type of a StaticColourMap is fixed at compile time");
             this->cm.setHue (_hue);
             this->cm.setType (_cmt);
         }
@@ -81,6 +106,13 @@ namespace mplot
             this->reinit();
         }
 
+        //! Update the scalar data from a view of memory owned by the client
+        virtual void updateData (mplot::strided_view<T> _data)
+        {
+            this->setScalarData (_data);
+            this->reinit();
+        }
+
         //! Update the scalar data with an associated z-scaling
         void updateData (const std::vector<T>* _data, const sm::scale<T, float>& zscale)
         {
@@ -141,6 +173,128 @@ namespace mplot
             this->reinit();
         }
 
+        /*!
+         * Change the scalar data at a few elements without rebuilding the whole model. values[k] is
+         * the new value of element indices[k]. Only the vertices of those elements (and of any
+         * neighbours that share their geometry) are rewritten and uploaded. If an autoscaled range
+         * changes, or the model does not override reinit_at, the whole model is rebuilt from the
+         * data instead, so the client's data (scalarData or the view) must already hold the new
+         * values.
+         */
+        virtual void updateData (std::span<const unsigned int> indices, std::span<const T> values)
+        {
+            bool z_changed = false;
+            if (this->rescale_at (indices, values, z_changed) == true) {
+                // If reinit_at rebuilds, the tracker (if any) still matches the data
+                this->tracker_current = this->tracker_synced;
+                this->reinit_at (indices, z_changed);
+                this->tracker_current = false;
+            } else {
+                this->reinit();
+            }
+        }
+
+        /*!
+         * Rewrite and upload the vertices of the elements at indices, whose dcopy, dcolour and rgb
+         * have been updated by rescale_at. z_changed is true if any element's dcopy changed. This
+         * default rebuilds the whole model.
+         */
+        virtual void reinit_at ([[maybe_unused]] std::span<const unsigned int> indices,
+                                [[maybe_unused]] const bool z_changed)
+        {
+            this->reinit();
+        }
+
+        /*!
+         * Scale the new values for the elements at indices into dcopy, dcolour and rgb. Returns
+         * false (changing nothing) if a full rebuild is needed instead: when there are no scaled
+         * scalar data to update, or when a scale is autoscaling and the range of the data would
+         * change. A new value outside the range extends it; moving an element that was at a limit
+         * of the range may shrink it.
+         */
+        bool rescale_at (std::span<const unsigned int> indices, std::span<const T> values, bool& z_changed)
+        {
+            if (indices.size() != values.size()) {
+                throw std::runtime_error ("VisualDataModel::updateData: indices and values differ in size");
+            }
+            z_changed = false;
+            const std::size_t n = this->dcolour.size();
+            if (!this->has_scalars() || this->cm.numDatums() != 1
+                || this->dcopy.size() != n || this->rgb.size() != 3 * n) {
+                return false;
+            }
+            for (auto ri : indices) {
+                if (ri >= n) { throw std::runtime_error ("VisualDataModel::updateData: index out of range"); }
+            }
+
+            // Keep the tracker in step with the data on every sparse update, even while the scales
+            // are ready and don't use it, so that it is still right after a clearAutoscale()
+            const bool tracking = this->track_range == true && this->tracker_synced == true;
+            if (tracking) {
+                for (std::size_t k = 0; k < indices.size(); ++k) { this->tracker.set (indices[k], values[k]); }
+            }
+
+            const bool z_auto = this->zScale.do_autoscale == true && !this->zScale.ready();
+            const bool c_auto = this->colourScale.do_autoscale == true && !this->colourScale.ready();
+            if ((z_auto || c_auto) && tracking) {
+                // The tracker gives the new range without a scan of the data
+                const value_range<T> r = this->tracked_range();
+                const value_range<T>& r0 = this->scalar_range;
+                // Percentiles are approximate, so ignore changes smaller than the tracker's resolution
+                const bool clipped = this->autoscale_percentiles[0] > 0.0f || this->autoscale_percentiles[1] < 100.0f;
+                const double tol = clipped ? this->tracker.resolution() : 0.0;
+                if (!r.valid() || !r0.valid()
+                    || std::abs (static_cast<double>(r.min) - static_cast<double>(r0.min)) > tol
+                    || std::abs (static_cast<double>(r.max) - static_cast<double>(r0.max)) > tol) {
+                    // The rebuild takes the new range from the (already updated) tracker
+                    this->tracker_current = true;
+                    return false;
+                }
+                if (z_auto) { this->zScale.compute_scaling (r0.min, r0.max); }
+                if (c_auto) { this->colourScale.compute_scaling (r0.min, r0.max); }
+            } else if (z_auto || c_auto) {
+                const value_range<T>& r = this->scalar_range;
+                if (!r.valid()) { return false; }
+                // If the range is unchanged, autoscaling gives the same scales as last time
+                if (z_auto) { this->zScale.compute_scaling (r.min, r.max); }
+                if (c_auto) { this->colourScale.compute_scaling (r.min, r.max); }
+                const sm::scale<T, float>& s = c_auto ? this->colourScale : this->zScale;
+                const sm::vvec<float>& scaled = c_auto ? this->dcolour : this->dcopy;
+                const float lo = s.transform_one (r.min);
+                const float hi = s.transform_one (r.max);
+                bool same_range = true;
+                for (std::size_t k = 0; k < indices.size() && same_range; ++k) {
+                    const T x = values[k];
+                    const float prev = scaled[indices[k]];
+                    bool isnan_x = false;
+                    if constexpr (std::is_floating_point<std::decay_t<T>>::value == true) { isnan_x = std::isnan (x); }
+                    if (!isnan_x && (x < r.min || x > r.max)) { same_range = false; }
+                    if ((prev == lo && (isnan_x || x != r.min)) || (prev == hi && (isnan_x || x != r.max))) {
+                        same_range = false;
+                    }
+                }
+                if (!same_range) {
+                    // Leave the scales to autoscale in the full rebuild
+                    if (z_auto) { this->zScale.reset(); }
+                    if (c_auto) { this->colourScale.reset(); }
+                    return false;
+                }
+            }
+
+            const float z_nan = this->zScale.transform_one (0.0f);
+            for (std::size_t k = 0; k < indices.size(); ++k) {
+                const std::size_t ri = indices[k];
+                float z = this->zScale.transform_one (values[k]);
+                z = std::isnan (z) ? z_nan : z;
+                if (z != this->dcopy[ri]) { z_changed = true; }
+                this->dcopy[ri] = z;
+                this->dcolour[ri] = this->colourScale.transform_one (values[k]);
+                const std::array<float, 3> clr = this->cm.convert (this->dcolour[ri]);
+                std::copy (clr.begin(), clr.end(), this->rgb.begin() + 3 * ri);
+            }
+            return true;
+        }
+
         //! An overridable function to set the colour of rect ri
         std::array<float, 3> setColour (uint64_t ri)
         {
@@ -161,64 +315,285 @@ namespace mplot
             return clr;
         }
 
+        /*!
+         * Convert all of dcolour (with dcolour2 and dcolour3 for 2 and 3 datum colour maps) into
+         * RGB colours in one pass, storing the result in rgb. The colour map type is examined once
+         * rather than once per element. setupScaling does this for you; call convertColours if you
+         * change dcolour (etc) afterwards. Read the colours with colourAt.
+         */
+        void convertColours()
+        {
+            this->rgb.resize (3 * this->dcolour.size());
+            std::span<float> out (this->rgb);
+            if (this->cm.numDatums() == 3) {
+                if constexpr (std::is_integral<std::decay_t<T>>::value) {
+                    for (uint64_t ri = 0; ri < this->dcolour.size(); ++ri) {
+                        std::array<float, 3> clr = this->setColour (ri);
+                        std::copy (clr.begin(), clr.end(), out.begin() + 3 * ri);
+                    }
+                } else {
+                    this->cm.convert (std::span<const float>(this->dcolour), std::span<const float>(this->dcolour2),
+                                      std::span<const float>(this->dcolour3), out);
+                }
+            } else if (this->cm.numDatums() == 2) {
+                this->cm.convert (std::span<const float>(this->dcolour), std::span<const float>(this->dcolour2), out);
+            } else {
+                this->cm.convert (std::span<const float>(this->dcolour), out);
+            }
+        }
+
+        //! The colour of element ri, as computed by setupScaling or convertColours
+        std::array<float, 3> colourAt (uint64_t ri) const
+        {
+            return { this->rgb[3 * ri], this->rgb[3 * ri + 1], this->rgb[3 * ri + 2] };
+        }
+
         //! Find datasize
         void determine_datasize()
         {
             this->datasize = 0;
             if (this->vectorData != nullptr && !this->vectorData->empty()) {
                 this->datasize = this->vectorData->size();
+            } else if (!this->vectorView.empty()) {
+                this->datasize = this->vectorView.size();
             } else if (this->scalarData != nullptr && !this->scalarData->empty()) {
                 this->datasize = this->scalarData->size();
+            } else if (!this->scalarView.empty()) {
+                this->datasize = this->scalarView.size();
             } // else datasize remains 0
         }
 
-        // Common function for setting up the z and colour scaling
-        void setupScaling()
+        //! True if there is scalar data, either in scalarData or in scalarView
+        bool has_scalars() const { return this->scalarData != nullptr || !this->scalarView.empty(); }
+        //! True if there is vector data, either in vectorData or in vectorView
+        bool has_vectors() const { return this->vectorData != nullptr || !this->vectorView.empty(); }
+
+        //! A view of the scalar data, wherever it is held
+        mplot::strided_view<T> scalars() const
         {
-            this->dcopy.resize (this->datasize, 0);
-            this->dcolour.resize (this->datasize);
-
-            if (this->scalarData != nullptr) {
-                // What do these scaling operations do to any NaNs in scalarData? They should remain
-                // NaN. Then in dcopy, might want to make them 0.
-                this->zScale.transform (*(this->scalarData), this->dcopy);
-                this->dcopy.replace_nan_with (this->zScale.transform_one(0.0f));
-                this->colourScale.transform (*(this->scalarData), this->dcolour);
-
-            } else if (this->vectorData != nullptr) {
-
-                this->dcolour2.resize (this->datasize);
-                this->dcolour3.resize (this->datasize);
-                sm::vvec<float> veclens(this->dcopy);
-                for (unsigned int i = 0; i < this->datasize; ++i) {
-                    veclens[i] = (*this->vectorData)[i].length();
-                    this->dcolour[i] = (*this->vectorData)[i][0];
-                    this->dcolour2[i] = (*this->vectorData)[i][1];
-                    // Could also extract a third colour for Trichrome vs Duochrome (or for raw RGB signal)
-                    this->dcolour3[i] = (*this->vectorData)[i][2];
+            return this->scalarData != nullptr ? mplot::strided_view<T>(*this->scalarData) : this->scalarView;
+        }
+        //! A view of the vector data, wherever it is held
+        mplot::strided_view<sm::vec<T>> vectors() const
+        {
+            return this->vectorData != nullptr ? mplot::strided_view<sm::vec<T>>(*this->vectorData) : this->vectorView;
+        }
+
+        /*!
+         * Apply the scale s to each element of the view v, writing the results into out. As
+         * sm::scale::transform does for containers, autoscale first if s requires it.
+         */
+        template <typename S>
+        static void transform_view (S& s, const mplot::strided_view<T>& v, sm::vvec<float>& out)
+        {
+            if (s.do_autoscale == true && !s.ready()) {
+                T mn = std::numeric_limits<T>::max();
+                T mx = std::numeric_limits<T>::lowest();
+                for (const T& x : v) {
+                    if constexpr (std::is_floating_point<std::decay_t<T>>::value == true) {
+                        if (std::isnan (x)) { continue; }
+                    }
+                    mn = x < mn ? x : mn;
+                    mx = x > mx ? x : mx;
                 }
-                this->zScale.transform (veclens, this->dcopy);
-
-                // Handle case where this->cm.getType() == mplot::ColourMapType::RGB and there is
-                // exactly one colour. ColourMapType::RGB (and RGBMono/Grey) assumes R/G/B data all
-                // in range 0->1 ALREADY and therefore they don't need to be re-scaled with
-                // this->colourScale.
-                if (this->cm.getType() != mplot::ColourMapType::RGB
-                    && this->cm.getType() != mplot::ColourMapType::RGBMono
-                    && this->cm.getType() != mplot::ColourMapType::RGBGrey) {
-                    this->colourScale.transform (this->dcolour, this->dcolour);
-                    // Dual axis colour maps like Duochrome and HSV will need to use colourScale2 to
-                    // transform their second colour/axis,
-                    this->colourScale2.transform (this->dcolour2, this->dcolour2);
-                    // Similarly for Triple axis maps
-                    this->colourScale3.transform (this->dcolour3, this->dcolour3);
-                } // else assume dcolour/dcolour2/dcolour3 are all in range 0->1 (or 0-255) already
+                if (mn <= mx) { s.compute_scaling (mn, mx); }
+            }
+            out.resize (v.size());
+            for (std::size_t i = 0; i < v.size(); ++i) { out[i] = s.transform_one (v[i]); }
+        }
+
+        //! The smallest and largest non-NaN values seen
+        template <typename V>
+        struct value_range
+        {
+            V min = std::numeric_limits<V>::max();
+            V max = std::numeric_limits<V>::lowest();
+            void update (const V x)
+            {
+                if constexpr (std::is_floating_point<std::decay_t<V>>::value == true) {
+                    if (std::isnan (x)) { return; }
+                }
+                this->min = x < this->min ? x : this->min;
+                this->max = x > this->max ? x : this->max;
+            }
+            void update (const value_range<V>& r)
+            {
+                this->min = r.min < this->min ? r.min : this->min;
+                this->max = r.max > this->max ? r.max : this->max;
+            }
+            bool valid() const { return this->min <= this->max; }
+        };
+
+        /*!
+         * Call fn (i0, i1) on consecutive sub-ranges of [0, n), using up to scaling_threads threads
+         * (each given at least min_per_thread elements)
+         */
+        template <typename F>
+        void parallel_ranges (const std::size_t n, F fn) const
+        {
+            constexpr std::size_t min_per_thread = 1u << 16;
+            std::size_t nt = this->scaling_threads == 0u ? std::thread::hardware_concurrency() : this->scaling_threads;
+            nt = std::min (std::max (nt, std::size_t{1}), std::max (n / min_per_thread, std::size_t{1}));
+            if (nt < 2) {
+                fn (std::size_t{0}, n, std::size_t{0});
+                return;
+            }
+            const std::size_t per = (n + nt - 1) / nt;
+            std::vector<std::thread> pool;
+            pool.reserve (nt - 1);
+            for (std::size_t t = 1; t < nt; ++t) {
+                pool.emplace_back (fn, std::min (t * per, n), std::min ((t + 1) * per, n), t);
+            }
+            fn (std::size_t{0}, std::min (per, n), std::size_t{0});
+            for (auto& th : pool) { th.join(); }
+        }
+
+        /*!
+         * The range to autoscale to, from the tracker: its extremes, or the autoscale_percentiles
+         * of the data
+         */
+        value_range<T> tracked_range()
+        {
+            value_range<T> r;
+            if (this->tracker.empty()) { return r; }
+            if (this->autoscale_percentiles[0] > 0.0f || this->autoscale_percentiles[1] < 100.0f) {
+                r.min = static_cast<T>(this->tracker.percentile (this->autoscale_percentiles[0]));
+                r.max = static_cast<T>(this->tracker.percentile (this->autoscale_percentiles[1]));
+            } else {
+                r.min = this->tracker.min();
+                r.max = this->tracker.max();
+            }
+            return r;
+        }
+
+        /*!
+         * Scale scalar data into dcopy (NaNs replaced by the z of 0) and dcolour and convert dcolour
+         * into rgb. At most two passes are made over the data: one to find its range (only if a
+         * scale needs to autoscale; zScale and colourScale share it) and one that scales, then
+         * converts each block of 256 elements while they are in cache.
+         */
+        void scale_scalars (const mplot::strided_view<T>& v)
+        {
+            const std::size_t n = v.size();
+            const bool z_auto = this->zScale.do_autoscale == true && !this->zScale.ready();
+            const bool c_auto = this->colourScale.do_autoscale == true && !this->colourScale.ready();
+            if ((z_auto || c_auto) && this->track_range == true) {
+                // After a sparse update, the tracker is already up to date
+                if (this->tracker_current == false) { this->tracker.assign (v); }
+                this->tracker_synced = true;
+                const value_range<T> r = this->tracked_range();
+                if (r.valid()) {
+                    if (z_auto) { this->zScale.compute_scaling (r.min, r.max); }
+                    if (c_auto) { this->colourScale.compute_scaling (r.min, r.max); }
+                }
+                this->scalar_range = r;
+            } else if (z_auto || c_auto) {
+                std::vector<value_range<T>> ranges (this->scaling_threads == 0u ? std::thread::hardware_concurrency() + 1 : this->scaling_threads + 1);
+                this->parallel_ranges (n, [&v, &ranges](std::size_t i0, std::size_t i1, std::size_t t) {
+                    for (std::size_t i = i0; i < i1; ++i) { ranges[t].update (v[i]); }
+                });
+                value_range<T> r;
+                for (const auto& rt : ranges) { r.update (rt); }
+                if (r.valid()) {
+                    if (z_auto) { this->zScale.compute_scaling (r.min, r.max); }
+                    if (c_auto) { this->colourScale.compute_scaling (r.min, r.max); }
+                }
+                this->scalar_range = r;
+            } else {
+                this->scalar_range = value_range<T>{};
+                // The data may have changed without the tracker seeing it
+                if (this->tracker_current == false) { this->tracker_synced = false; }
+            }
+            this->tracker_current = false;
+
+            this->dcopy.resize (n);
+            this->dcolour.resize (n);
+            this->rgb.resize (3 * n);
+            const float z_nan = this->zScale.transform_one (0.0f);
+            this->parallel_ranges (n, [this, &v, z_nan](std::size_t i0, std::size_t i1, std::size_t) {
+                constexpr std::size_t block = 256;
+                for (std::size_t b = i0; b < i1; b += block) {
+                    const std::size_t e = std::min (b + block, i1);
+                    for (std::size_t i = b; i < e; ++i) {
+                        const float z = this->zScale.transform_one (v[i]);
+                        this->dcopy[i] = std::isnan (z) ? z_nan : z;
+                        this->dcolour[i] = this->colourScale.transform_one (v[i]);
+                    }
+                    this->cm.convert (std::span<const float>(this->dcolour.data() + b, e - b),
+                                      std::span<float>(this->rgb.data() + 3 * b, 3 * (e - b)));
+                }
+            });
+        }
+
+        /*!
+         * Scale vector data: lengths into dcopy, components into dcolour, dcolour2 and dcolour3,
+         * then convert these into rgb. The ranges of all four are found in a single pass, if any
+         * scale needs to autoscale.
+         */
+        void scale_vectors (const mplot::strided_view<sm::vec<T>>& vecs)
+        {
+            const std::size_t n = vecs.size();
+            // ColourMapType::RGB (and RGBMono/Grey) assumes R/G/B data all in range 0->1 ALREADY
+            // and therefore they don't need to be re-scaled with this->colourScale.
+            const bool scale_colours = this->cm.getType() != mplot::ColourMapType::RGB
+                                       && this->cm.getType() != mplot::ColourMapType::RGBMono
+                                       && this->cm.getType() != mplot::ColourMapType::RGBGrey;
+            sm::scale<T, float>* cscales[3] = { &this->colourScale, &this->colourScale2, &this->colourScale3 };
+            const bool z_auto = this->zScale.do_autoscale == true && !this->zScale.ready();
+            bool c_auto[3] = { false, false, false };
+            for (int j = 0; j < 3; ++j) {
+                c_auto[j] = scale_colours && cscales[j]->do_autoscale == true && !cscales[j]->ready();
+            }
+            if (z_auto || c_auto[0] || c_auto[1] || c_auto[2]) {
+                value_range<float> lr;
+                value_range<float> cr[3];
+                for (std::size_t i = 0; i < n; ++i) {
+                    lr.update (static_cast<float>(vecs[i].length()));
+                    for (int j = 0; j < 3; ++j) { cr[j].update (static_cast<float>(vecs[i][j])); }
+                }
+                if (z_auto && lr.valid()) { this->zScale.compute_scaling (static_cast<T>(lr.min), static_cast<T>(lr.max)); }
+                for (int j = 0; j < 3; ++j) {
+                    if (c_auto[j] && cr[j].valid()) {
+                        cscales[j]->compute_scaling (static_cast<T>(cr[j].min), static_cast<T>(cr[j].max));
+                    }
+                }
+            }
+
+            this->dcopy.resize (n);
+            this->dcolour.resize (n);
+            this->dcolour2.resize (n);
+            this->dcolour3.resize (n);
+            sm::vvec<float>* dcs[3] = { &this->dcolour, &this->dcolour2, &this->dcolour3 };
+            for (std::size_t i = 0; i < n; ++i) {
+                this->dcopy[i] = this->zScale.transform_one (static_cast<float>(vecs[i].length()));
+                for (int j = 0; j < 3; ++j) {
+                    const float c = static_cast<float>(vecs[i][j]);
+                    (*dcs[j])[i] = scale_colours ? cscales[j]->transform_one (c) : c;
+                }
+            }
+            this->convertColours();
+        }
+
+        /*!
+         * Common function for setting up the z and colour scaling. On return, dcopy holds the z
+         * values, dcolour (and dcolour2/3 for vector data) the scaled colour values and rgb the
+         * final colours (see colourAt).
+         */
+        void setupScaling()
+        {
+            if (this->has_scalars()) {
+                this->scale_scalars (this->scalars());
+            } else if (this->has_vectors()) {
+                this->scale_vectors (this->vectors());
+            } else {
+                this->dcopy.resize (this->datasize, 0);
+                this->dcolour.resize (this->datasize);
             }
         }
 
         //! All data models use a a colour map. Change the type/hue of this colour map
         //! object to generate different types of map.
-        ColourMap<float> cm;
+        CM cm;
 
         //! A Scaling function for the colour map. Perhaps a scale class contains a
         //! colour map? If not, then this scale might well be autoscaled. Applied to scalarData.
@@ -246,6 +621,12 @@ namespace mplot
         //! hexes.
         const std::vector<sm::vec<T>>* vectorData = nullptr;
 
+        //! Scalar data held elsewhere (an mmapped file, a field of a structure-of-arrays, a
+        //! matrix row). Used when scalarData is nullptr. Set with setScalarData (strided_view).
+        mplot::strided_view<T> scalarView;
+        //! Vector data held elsewhere. Used when vectorData is nullptr.
+        mplot::strided_view<sm::vec<T>> vectorView;
+
         //! The coordinates at which to visualize data, if appropriate (e.g. scatter
         //! graph, quiver plot). Note fixed type of float, which is suitable for
         //! OpenGL coordinates. Not const as child code may resize or update content.
@@ -264,6 +645,33 @@ namespace mplot
         sm::vvec<float> dcolour2;
         //! For the third field of vectorData
         sm::vvec<float> dcolour3;
+        //! Three floats per element; the colours of dcolour (etc) computed by setupScaling or convertColours
+        std::vector<float> rgb;
+
+        //! The range of the scalar data found when setupScaling last autoscaled. Used by
+        //! rescale_at to tell whether a sparse update would change the autoscaled range.
+        value_range<T> scalar_range;
+
+        /*!
+         * If true, keep a range_tracker of the scalar data. Autoscaling after a sparse
+         * updateData (indices, values) then takes the range from the tracker, with no scan of the
+         * data, and the data are only re-scanned when the last value at an extreme is overwritten.
+         * The tracker holds a copy of the data.
+         */
+        bool track_range = false;
+        //! With track_range, autoscale between these percentiles of the scalar data rather than
+        //! between its extremes. { 1, 99 } clips the most extreme 1% of values at each end.
+        std::array<float, 2> autoscale_percentiles = { 0.0f, 100.0f };
+        //! The tracker used if track_range is true
+        mplot::range_tracker<T> tracker;
+        //! True while tracker holds the same values as the scalar data
+        bool tracker_synced = false;
+        //! Set by rescale_at when it has updated the tracker and a rebuild follows
+        bool tracker_current = false;
+
+        //! The number of threads that setupScaling may use to scale scalar data. 0 means one per
+        //! hardware thread. Threads are only started for data with more than 65536 elements each.
+        unsigned int scaling_threads = 1;
 
         //! The length of the data structure that will be visualized. May be length of
         //! this->scalarData or of this->vectorData.
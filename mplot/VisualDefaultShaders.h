@@ -170,10 +170,12 @@ namespace mplot {
     "layout(location = 2) in vec4 vcolor;\n"
     "layout(location = 3) in vec4 texture;\n"
     "out vec2 TexCoords;\n"
+    "out vec3 TextTint;\n"
     "void main()\n"
     "{\n"
     "    gl_Position = p_matrix * v_matrix * m_matrix * position;\n"
     "    TexCoords = texture.xy;\n"
+    "    TextTint = vcolor.rgb;\n"
     "}";
 
     std::string getDefaultTextVtxShader (const int glver)
@@ -186,12 +188,20 @@ namespace mplot {
 
     // Default text fragment shader. See VisText.frag.glsl
     const char* defaultTextFragShader = "in vec2 TexCoords;\n"
+    "in vec3 TextTint;\n"
     "out vec4 color;\n"
     "uniform sampler2D text;\n"
     "uniform vec3 textColor;\n"
+    "uniform int sdf;\n"
     "void main()\n"
     "{\n"
-    "    color = vec4(textColor, texture(text, TexCoords).r);\n"
+    "    vec2 uv = TexCoords / vec2(textureSize(text, 0));\n"
+    "    float a = texture(text, uv).r;\n"
+    "    if (sdf != 0) {\n"
+    "        float w = max(fwidth(a), 0.0001);\n"
+    "        a = smoothstep(0.5 - w, 0.5 + w, a);\n"
+    "    }\n"
+    "    color = vec4(textColor * TextTint, a);\n"
     "}\n";
 
     std::string getDefaultTextFragShader (const int glver)
@@ -260,4 +270,109 @@ namespace mplot {
         return shdr;
     }
 
+    // Default line vertex shader. Expands each segment of a polyline into a quad. See VisLine.vert.glsl
+    const char* defaultLineVtxShader = "uniform mat4 m_matrix;\n"
+    "uniform mat4 v_matrix;\n"
+    "uniform mat4 p_matrix;\n"
+    "uniform highp float linewidth;\n"
+    "uniform float linez;\n"
+    "uniform highp int lineround;\n"
+    "uniform float shorten;\n"
+    "layout(location = 0) in vec3 prev;\n"
+    "layout(location = 1) in vec3 pt_a;\n"
+    "layout(location = 2) in vec3 pt_b;\n"
+    "layout(location = 3) in vec3 next;\n"
+    "out highp vec2 fragxy;\n"
+    "flat out highp vec2 seg_a;\n"
+    "flat out highp vec2 seg_b;\n"
+    "flat out highp float seg_s;\n"
+    "void main()\n"
+    "{\n"
+    "    const float ends[6] = float[6](0.0, 0.0, 1.0, 0.0, 1.0, 1.0);\n"
+    "    const float sides[6] = float[6](-1.0, 1.0, 1.0, -1.0, 1.0, -1.0);\n"
+    "    float end = ends[gl_VertexID];\n"
+    "    float side = sides[gl_VertexID];\n"
+    "    vec2 a = pt_a.xy;\n"
+    "    vec2 b = pt_b.xy;\n"
+    "    float hw = 0.5 * linewidth;\n"
+    "    float len = length(b - a);\n"
+    "    vec2 d = len > 0.0 ? (b - a) / len : vec2(1.0, 0.0);\n"
+    "    vec2 n = vec2(-d.y, d.x);\n"
+    "    float s = pt_a.z;\n"
+    "    if (shorten > 0.0) {\n"
+    "        if (len <= 2.0 * shorten) { hw = 0.0; }\n"
+    "        float sh = min(shorten, 0.5 * len);\n"
+    "        a += d * sh;\n"
+    "        b -= d * sh;\n"
+    "        s += sh;\n"
+    "    }\n"
+    "    vec2 p = end == 0.0 ? a : b;\n"
+    "    vec2 off = n * hw;\n"
+    "    if (lineround == 1) {\n"
+    "        p += d * (end == 0.0 ? -hw : hw);\n"
+    "    } else if (shorten <= 0.0) {\n"
+    "        vec2 e = end == 0.0 ? a - prev.xy : next.xy - b;\n"
+    "        float elen = length(e);\n"
+    "        if (elen > 0.0) {\n"
+    "            vec2 t = d + e / elen;\n"
+    "            float tlen = length(t);\n"
+    "            if (tlen > 0.001) {\n"
+    "                t /= tlen;\n"
+    "                vec2 m = vec2(-t.y, t.x);\n"
+    "                float cos_half = dot(m, n);\n"
+    "                if (cos_half > 0.25) { off = m * (hw / cos_half); }\n"
+    "            }\n"
+    "        }\n"
+    "    }\n"
+    "    fragxy = p + side * off;\n"
+    "    seg_a = a;\n"
+    "    seg_b = b;\n"
+    "    seg_s = s;\n"
+    "    gl_Position = p_matrix * v_matrix * m_matrix * vec4(fragxy, linez, 1.0);\n"
+    "}\n";
+
+    std::string getDefaultLineVtxShader (const int glver)
+    {
+        std::string shdr;
+        shdr += mplot::gl::version::shaderpreamble (glver);
+        shdr += defaultLineVtxShader;
+        return shdr;
+    }
+
+    // Default line fragment shader. See VisLine.frag.glsl
+    const char* defaultLineFragShader = "in highp vec2 fragxy;\n"
+    "flat in highp vec2 seg_a;\n"
+    "flat in highp vec2 seg_b;\n"
+    "flat in highp float seg_s;\n"
+    "uniform vec3 linecolour;\n"
+    "uniform float alpha;\n"
+    "uniform highp float linewidth;\n"
+    "uniform highp int lineround;\n"
+    "uniform float dash;\n"
+    "uniform float dashgap;\n"
+    "out vec4 finalcolor;\n"
+    "void main()\n"
+    "{\n"
+    "    highp vec2 ab = seg_b - seg_a;\n"
+    "    highp float len2 = dot(ab, ab);\n"
+    "    highp float t = len2 > 0.0 ? dot(fragxy - seg_a, ab) / len2 : 0.0;\n"
+    "    if (lineround == 1) {\n"
+    "        highp vec2 nearest = seg_a + clamp(t, 0.0, 1.0) * ab;\n"
+    "        if (length(fragxy - nearest) > 0.5 * linewidth) { discard; }\n"
+    "    }\n"
+    "    if (dash > 0.0) {\n"
+    "        highp float s = seg_s + t * sqrt(len2);\n"
+    "        if (mod(s, dash + dashgap) > dash) { discard; }\n"
+    "    }\n"
+    "    finalcolor = vec4(linecolour, alpha);\n"
+    "}\n";
+
+    std::string getDefaultLineFragShader (const int glver)
+    {
+        std::string shdr;
+        shdr += mplot::gl::version::shaderpreamble (glver);
+        shdr += defaultLineFragShader;
+        return shdr;
+    }
+
 } // namespace mplot
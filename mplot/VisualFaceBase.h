@@ -13,14 +13,19 @@
 #pragma once
 
 #include <map>
+#include <array>
+#include <bitset>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <utility>
-#include <fstream>
 
-#include <mplot/tools.h>
 #include <mplot/VisualCommon.h> // for visgl::CharInfo
 #include <mplot/VisualFont.h>
 #include <mplot/TextFeatures.h>
+#include <mplot/text_layout_cache.h>
 
 // FreeType for text rendering
 #include <ft2build.h>
@@ -168,249 +173,388 @@ namespace mplot {
         struct VisualFaceBase
         {
             VisualFaceBase () {}
-            ~VisualFaceBase () {}
+            virtual ~VisualFaceBase ()
+            {
+                // The FT_Face is kept for the lifetime of the VisualFace, so that glyphs can be
+                // rasterised as they are first needed
+                if (this->face != nullptr) { FT_Done_Face (this->face); }
+            }
 
             //! Set true for informational/debug messages
             static constexpr bool debug_visualface = false;
 
+            /*!
+             * If true, the printable ASCII glyphs are rasterised when a VisualFace is created. All
+             * other glyphs are rasterised the first time that glyph() is called for them.
+             */
+            static inline bool prewarm_ascii = true;
+
             //! The FT_Face that we're managing
-            FT_Face face;
+            FT_Face face = nullptr;
 
-            //! The OpenGL character info stuff
+            //! True if this face's atlas holds signed distance fields rather than coverage bitmaps
+            bool sdf = false;
+            //! The distance, in texels, over which a signed distance field glyph ramps from fully
+            //! outside (0) through the edge (0.5) to fully inside (1). Also the margin added around
+            //! each SDF glyph.
+            static constexpr int sdf_spread = 8;
+
+            //! Info for the glyphs rasterised so far outside the Basic Multilingual Plane. Use glyph().
             std::map<char32_t, mplot::visgl::CharInfo> glchars;
 
+            //! Laid-out strings in this face, for VisualTextModel::layout()
+            mplot::text_layout_cache layouts;
+
+            //! The single-channel texture into which all of this face's glyphs are packed
+            unsigned int atlas_texture = 0;
+            //! Current atlas dimensions in texels. The width is fixed; the height grows as required.
+            int atlas_w = 0;
+            int atlas_h = 0;
+
+            /*!
+             * Return the info for the character c, rasterising its glyph into a texture if this is
+             * the first time it has been requested. Characters that the font does not contain get
+             * a zero CharInfo (no texture, no size and no advance). The GL context of the face's
+             * Visual must be current.
+             */
+            const mplot::visgl::CharInfo& glyph (const char32_t c)
+            {
+                if (c < 0x10000) {
+                    // A direct lookup in the flat table for the Basic Multilingual Plane
+                    const glyph_page* page = this->bmp_pages[c >> 8].get();
+                    if (page != nullptr && page->loaded[c & 0xff]) { return page->info[c & 0xff]; }
+                    return this->load_glyph (c);
+                }
+                auto gi = this->glchars.find (c);
+                if (gi != this->glchars.end()) { return gi->second; }
+                return this->load_glyph (c);
+            }
+
         protected:
+            //! The info for 256 consecutive code points in the Basic Multilingual Plane
+            struct glyph_page
+            {
+                std::array<mplot::visgl::CharInfo, 256> info = {};
+                std::bitset<256> loaded;
+            };
+            //! A flat, two level table for glyphs in the BMP. Pages are allocated when one of their
+            //! glyphs is first loaded, so references into them remain valid.
+            std::array<std::unique_ptr<glyph_page>, 256> bmp_pages;
+
+            //! Empty texels between neighbouring glyphs in the atlas, so that linear filtering at a
+            //! glyph's edge doesn't pick up its neighbour
+            static constexpr int atlas_pad = 1;
+            //! The largest atlas dimension. Derived classes set this from GL_MAX_TEXTURE_SIZE.
+            int atlas_max = 4096;
+            //! CPU-side copy of the atlas, which is re-uploaded in full when the atlas grows
+            std::vector<unsigned char> atlas_pixels;
+            //! Shelf packing state: the next free x on the current shelf, the shelf's y and its height
+            int shelf_x = 0;
+            int shelf_y = 0;
+            int shelf_h = 0;
+
+            /*!
+             * Upload the w by h region of atlas_pixels at (x, y) into atlas_texture. If realloc is
+             * true, the atlas has been created or has grown, and the whole texture must be
+             * (re)specified at the size atlas_w by atlas_h.
+             */
+            virtual void upload_atlas (const bool realloc, const int x, const int y, const int w, const int h) = 0;
+
+            //! Choose the initial atlas size from the font resolution
+            void init_atlas (const unsigned int fontpixels)
+            {
+                // Room for about 16 'm's per shelf
+                this->atlas_w = 256;
+                while (this->atlas_w < static_cast<int>(16u * fontpixels) && this->atlas_w < this->atlas_max) {
+                    this->atlas_w *= 2;
+                }
+                this->atlas_w = std::min (this->atlas_w, this->atlas_max);
+                this->atlas_h = std::max (1, this->atlas_w / 4);
+                this->atlas_pixels.assign (static_cast<std::size_t>(this->atlas_w) * this->atlas_h, 0);
+                this->shelf_x = 0;
+                this->shelf_y = 0;
+                this->shelf_h = 0;
+            }
 
-            void init_common (const mplot::VisualFont _font, unsigned int fontpixels, FT_Library& ft_freetype)
+            /*!
+             * Find space for a w by h glyph in the atlas, growing the atlas height if necessary.
+             * Writes the glyph's position into pos and returns false if it can't fit.
+             * grew is set true if the atlas was enlarged.
+             */
+            bool atlas_pack (const int w, const int h, sm::vec<int, 2>& pos, bool& grew)
             {
-                std::string fontpath = "";
-#ifdef _MSC_VER
-		char* userprofile = getenv ("USERPROFILE");
-		std::string uppath("");
-		if (userprofile != nullptr) {
-		    uppath = std::string (userprofile);
-		}
+                grew = false;
+                const int pw = w + atlas_pad;
+                const int ph = h + atlas_pad;
+                if (pw > this->atlas_w) { return false; }
+                if (this->shelf_x + pw > this->atlas_w) {
+                    // Start a new shelf
+                    this->shelf_y += this->shelf_h;
+                    this->shelf_x = 0;
+                    this->shelf_h = 0;
+                }
+                const int needed_h = this->shelf_y + std::max (this->shelf_h, ph);
+                int new_h = this->atlas_h;
+                while (needed_h > new_h) {
+                    if (new_h >= this->atlas_max) { return false; }
+                    new_h = std::min (new_h * 2, this->atlas_max);
+                }
+                if (new_h != this->atlas_h) {
+                    // Rows are atlas_w wide, so growing the height keeps existing glyphs in place
+                    this->atlas_h = new_h;
+                    this->atlas_pixels.resize (static_cast<std::size_t>(this->atlas_w) * this->atlas_h, 0);
+                    grew = true;
+                }
+                pos = { this->shelf_x, this->shelf_y };
+                this->shelf_x += pw;
+                this->shelf_h = std::max (this->shelf_h, ph);
+                return true;
+            }
 
-                switch (_font) {
-                case VisualFont::DVSans:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\DejaVuSans.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_dvsansData, vf_dvsansEnd);
-                    break;
-                }
-                case VisualFont::DVSansItalic:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\DejaVuSans-Oblique.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_dvsansitData, vf_dvsansitEnd);
-                    break;
-                }
-                case VisualFont::DVSansBold:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\DejaVuSans-Bold.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_dvsansbdData, vf_dvsansbdEnd);
-                    break;
-                }
-                case VisualFont::DVSansBoldItalic:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\DejaVuSans-BoldOblique.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_dvsansbiData, vf_dvsansbiEnd);
-                    break;
-                }
-                case VisualFont::Vera:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\Vera.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_veraData, vf_veraEnd);
-                    break;
-                }
-                case VisualFont::VeraItalic:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\VeraIt.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_veraitData, vf_veraitEnd);
-                    break;
-                }
-                case VisualFont::VeraBold:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\VeraBd.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_verabdData, vf_verabdEnd);
-                    break;
-                }
-                case VisualFont::VeraBoldItalic:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\VeraBI.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_verabiData, vf_verabiEnd);
-                    break;
-                }
-                case VisualFont::VeraMono:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\VeraMono.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_veramonoData, vf_veramonoEnd);
-                    break;
-                }
-                case VisualFont::VeraMonoBold:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\VeraMoBd.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_veramobdData, vf_veramobdEnd);
-                    break;
-                }
-                case VisualFont::VeraMonoItalic:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\VeraMoIt.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_veramoitData, vf_veramoitEnd);
-                    break;
+            //! Copy the w by h image src (whose rows are pitch bytes apart) into the atlas at pos and upload it
+            void atlas_add (const unsigned char* src, const int pitch, const int w, const int h,
+                            const sm::vec<int, 2>& pos, const bool grew)
+            {
+                for (int r = 0; r < h; ++r) {
+                    const unsigned char* row = src + r * pitch;
+                    std::copy (row, row + w, this->atlas_pixels.data() + (pos.y() + r) * this->atlas_w + pos.x());
                 }
-                case VisualFont::VeraMonoBoldItalic:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\VeraMoBI.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_veramobiData, vf_veramobiEnd);
-                    break;
+                this->upload_atlas (grew || this->atlas_texture == 0, pos.x(), pos.y(), w, h);
+            }
+
+            //! Scratch space for make_sdf
+            std::vector<float> sdf_in;
+            std::vector<float> sdf_out;
+            std::vector<float> edt_f;
+            std::vector<float> edt_d;
+            std::vector<float> edt_z;
+            std::vector<int> edt_v;
+            std::vector<unsigned char> sdf_pixels;
+
+            /*!
+             * One dimensional squared Euclidean distance transform of the n samples in f (Felzenszwalb
+             * & Huttenlocher, 2012). Writes into d. v and z are workspace of size n and n+1.
+             */
+            static void edt_1d (const float* f, float* d, int* v, float* z, const int n)
+            {
+                constexpr float inf = 1e20f;
+                int k = 0;
+                v[0] = 0;
+                z[0] = -inf;
+                z[1] = inf;
+                // The intersection of the parabolas rooted at q and p
+                auto intersect = [f](const int q, const int p) {
+                    return ((f[q] + static_cast<float>(q * q)) - (f[p] + static_cast<float>(p * p))) / static_cast<float>(2 * (q - p));
+                };
+                for (int q = 1; q < n; ++q) {
+                    float s = intersect (q, v[k]);
+                    while (s <= z[k]) { // terminates at k == 0, as z[0] is -inf
+                        --k;
+                        s = intersect (q, v[k]);
+                    }
+                    ++k;
+                    v[k] = q;
+                    z[k] = s;
+                    z[k + 1] = inf;
                 }
-                case VisualFont::VeraSerif:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\VeraSe.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_veraseData, vf_veraseEnd);
-                    break;
+                k = 0;
+                for (int q = 0; q < n; ++q) {
+                    while (z[k + 1] < static_cast<float>(q)) { ++k; }
+                    const float dq = static_cast<float>(q - v[k]);
+                    d[q] = dq * dq + f[v[k]];
                 }
-                case VisualFont::VeraSerifBold:
-                {
-                    fontpath = uppath + "\\AppData\\Local\\Temp\\VeraSeBd.ttf";
-                    this->makeTempFontFile<const unsigned char> (fontpath, vf_verasebdData, vf_verasebdEnd);
-                    break;
+            }
+
+            //! In-place 2D squared Euclidean distance transform of the w by h grid g
+            void edt_2d (std::vector<float>& g, const int w, const int h)
+            {
+                const int n = std::max (w, h);
+                this->edt_f.resize (n);
+                this->edt_d.resize (n);
+                this->edt_v.resize (n);
+                this->edt_z.resize (n + 1);
+                for (int x = 0; x < w; ++x) {
+                    for (int y = 0; y < h; ++y) { this->edt_f[y] = g[y * w + x]; }
+                    edt_1d (this->edt_f.data(), this->edt_d.data(), this->edt_v.data(), this->edt_z.data(), h);
+                    for (int y = 0; y < h; ++y) { g[y * w + x] = this->edt_d[y]; }
+                }
+                for (int y = 0; y < h; ++y) {
+                    std::copy (g.begin() + y * w, g.begin() + (y + 1) * w, this->edt_f.begin());
+                    edt_1d (this->edt_f.data(), g.data() + y * w, this->edt_v.data(), this->edt_z.data(), w);
                 }
-                default:
-                {
-                    std::cout << "ERROR::Unsupported mplot font\n";
-                    break;
+            }
+
+            /*!
+             * Convert the w by h coverage bitmap src into a signed distance field with a margin of
+             * sdf_spread on each side, in this->sdf_pixels. Texels a long way from the edge get their
+             * distance from an exact distance transform of the thresholded bitmap; texels next to
+             * the edge use the coverage value, which is more accurate there.
+             */
+            void make_sdf (const unsigned char* src, const int pitch, const int w, const int h)
+            {
+                constexpr float inf = 1e20f;
+                constexpr int sp = sdf_spread;
+                const int sw = w + 2 * sp;
+                const int sh = h + 2 * sp;
+                const std::size_t n = static_cast<std::size_t>(sw) * sh;
+                this->sdf_pixels.assign (n, 0);
+                // Coverage into the centre of sdf_pixels, for now
+                for (int r = 0; r < h; ++r) {
+                    std::copy (src + r * pitch, src + r * pitch + w, this->sdf_pixels.data() + (r + sp) * sw + sp);
+                }
+                this->sdf_in.resize (n);  // squared distance to the nearest inside texel
+                this->sdf_out.resize (n); // squared distance to the nearest outside texel
+                for (std::size_t i = 0; i < n; ++i) {
+                    const bool inside = this->sdf_pixels[i] >= 128;
+                    this->sdf_in[i] = inside ? 0.0f : inf;
+                    this->sdf_out[i] = inside ? inf : 0.0f;
+                }
+                this->edt_2d (this->sdf_in, sw, sh);
+                this->edt_2d (this->sdf_out, sw, sh);
+                for (std::size_t i = 0; i < n; ++i) {
+                    const float a = this->sdf_pixels[i] / 255.0f;
+                    float sd = 0.0f; // texels, positive inside
+                    if (a >= 128.0f / 255.0f) {
+                        sd = this->sdf_out[i] <= 1.0f ? a - 0.5f : std::sqrt (this->sdf_out[i]) - 0.5f;
+                    } else {
+                        sd = this->sdf_in[i] <= 1.0f ? a - 0.5f : 0.5f - std::sqrt (this->sdf_in[i]);
+                    }
+                    const float v = std::clamp (0.5f + sd / (2.0f * sp), 0.0f, 1.0f);
+                    this->sdf_pixels[i] = static_cast<unsigned char>(std::lround (v * 255.0f));
                 }
+            }
+
+            //! Rasterise the glyph for c, pack it into the atlas and add it to bmp_pages or glchars
+            const mplot::visgl::CharInfo& load_glyph (const char32_t c)
+            {
+                mplot::visgl::CharInfo glchar = { this->atlas_texture, {0, 0}, {0, 0}, 0, {0, 0} };
+                // Check glyph index first, if it's 0 it's a blank
+                if (this->face != nullptr && FT_Get_Char_Index (this->face, c) != 0) {
+                    if (FT_Load_Char (this->face, c, FT_LOAD_RENDER)) {
+                        std::cout << "ERROR::FREETYPE: Failed to load Glyph for Unicode 0x"
+                                  << std::hex << static_cast<unsigned int>(c) << std::dec << std::endl;
+                    } else {
+                        const FT_Bitmap& bm = this->face->glyph->bitmap;
+                        int w = static_cast<int>(bm.width);
+                        int h = static_cast<int>(bm.rows);
+                        sm::vec<int, 2> bearing = { this->face->glyph->bitmap_left, this->face->glyph->bitmap_top };
+                        // Rows run downwards from src, pitch bytes apart
+                        const unsigned char* src = bm.pitch >= 0 ? bm.buffer : bm.buffer + (h - 1) * -bm.pitch;
+                        int pitch = bm.pitch;
+                        if (this->sdf && w > 0 && h > 0) {
+                            this->make_sdf (src, pitch, w, h);
+                            src = this->sdf_pixels.data();
+                            w += 2 * sdf_spread;
+                            h += 2 * sdf_spread;
+                            pitch = w;
+                            bearing = { bearing.x() - sdf_spread, bearing.y() + sdf_spread };
+                        }
+                        sm::vec<int, 2> pos = { 0, 0 };
+                        bool grew = false;
+                        if (w > 0 && h > 0) {
+                            if (this->atlas_pack (w, h, pos, grew)) {
+                                this->atlas_add (src, pitch, w, h, pos, grew);
+                            } else {
+                                std::cout << "ERROR: No room in the glyph atlas for Unicode 0x"
+                                          << std::hex << static_cast<unsigned int>(c) << std::dec << std::endl;
+                                // Draw nothing for the glyph, but keep its advance, so it renders as a space
+                                w = 0;
+                                h = 0;
+                            }
+                        }
+                        glchar = {
+                            this->atlas_texture,
+                            {w, h},                                                  // size
+                            bearing,                                                 // bearing
+                            static_cast<unsigned int>(this->face->glyph->advance.x), // advance
+                            pos                                                      // atlas_pos
+                        };
+                    }
                 }
-#else	 // Non-windows:
+                if constexpr (debug_visualface == true) {
+                    std::cout << "Inserting character into this->glchars with info: ID:" << glchar.textureID
+                              << ", Size:" << glchar.size << ", Bearing:" << glchar.bearing
+                              << ", Advance:" << glchar.advance << std::endl;
+                }
+                if (c < 0x10000) {
+                    std::unique_ptr<glyph_page>& page = this->bmp_pages[c >> 8];
+                    if (page == nullptr) { page = std::make_unique<glyph_page>(); }
+                    page->info[c & 0xff] = glchar;
+                    page->loaded.set (c & 0xff);
+                    return page->info[c & 0xff];
+                }
+                return this->glchars.emplace (c, glchar).first->second;
+            }
+
+            //! Rasterise the printable ASCII characters, if prewarm_ascii is set
+            void prewarm()
+            {
+                if (!prewarm_ascii) { return; }
+                for (char32_t c = 0x20; c < 0x7f; ++c) { this->glyph (c); }
+            }
+
+            /*!
+             * The font file that is embedded in the binary for _font, as a pointer to its first
+             * byte and its size. The pointer is null if _font is not one of the embedded fonts.
+             */
+            static std::pair<const FT_Byte*, FT_Long> embedded_font (const mplot::VisualFont _font)
+            {
+#ifdef _MSC_VER
+# define MPLOT_EMBEDDED_FONT(name) { reinterpret_cast<const FT_Byte*>(vf_##name##Data), static_cast<FT_Long>(vf_##name##End - vf_##name##Data) }
+#else
+# define MPLOT_EMBEDDED_FONT(name) { reinterpret_cast<const FT_Byte*>(__start_##name##_ttf), static_cast<FT_Long>(__stop_##name##_ttf - __start_##name##_ttf) }
+#endif
                 switch (_font) {
-                case VisualFont::DVSans:
-                {
-                    fontpath = "/tmp/DejaVuSans.ttf";
-                    this->makeTempFontFile (fontpath, __start_dvsans_ttf, __stop_dvsans_ttf);
-                    break;
-                }
-                case VisualFont::DVSansItalic:
-                {
-                    fontpath = "/tmp/DejaVuSans-Oblique.ttf";
-                    this->makeTempFontFile (fontpath, __start_dvsansit_ttf, __stop_dvsansit_ttf);
-                    break;
-                }
-                case VisualFont::DVSansBold:
-                {
-                    fontpath = "/tmp/DejaVuSans-Bold.ttf";
-                    this->makeTempFontFile (fontpath, __start_dvsansbd_ttf, __stop_dvsansbd_ttf);
-                    break;
-                }
-                case VisualFont::DVSansBoldItalic:
-                {
-                    fontpath = "/tmp/DejaVuSans-BoldOblique.ttf";
-                    this->makeTempFontFile (fontpath, __start_dvsansbi_ttf, __stop_dvsansbi_ttf);
-                    break;
-                }
-                case VisualFont::Vera:
-                {
-                    fontpath = "/tmp/Vera.ttf";
-                    this->makeTempFontFile (fontpath, __start_vera_ttf, __stop_vera_ttf);
-                    break;
-                }
-                case VisualFont::VeraItalic:
-                {
-                    fontpath = "/tmp/VeraIt.ttf";
-                    this->makeTempFontFile (fontpath, __start_verait_ttf, __stop_verait_ttf);
-                    break;
-                }
-                case VisualFont::VeraBold:
-                {
-                    fontpath = "/tmp/VeraBd.ttf";
-                    this->makeTempFontFile (fontpath, __start_verabd_ttf, __stop_verabd_ttf);
-                    break;
-                }
-                case VisualFont::VeraBoldItalic:
-                {
-                    fontpath = "/tmp/VeraBI.ttf";
-                    this->makeTempFontFile (fontpath, __start_verabi_ttf, __stop_verabi_ttf);
-                    break;
-                }
-                case VisualFont::VeraMono:
-                {
-                    fontpath = "/tmp/VeraMono.ttf";
-                    this->makeTempFontFile (fontpath, __start_veramono_ttf, __stop_veramono_ttf);
-                    break;
-                }
-                case VisualFont::VeraMonoBold:
-                {
-                    fontpath = "/tmp/VeraMoBd.ttf";
-                    this->makeTempFontFile (fontpath, __start_veramobd_ttf, __stop_veramobd_ttf);
-                    break;
-                }
-                case VisualFont::VeraMonoItalic:
-                {
-                    fontpath = "/tmp/VeraMoIt.ttf";
-                    this->makeTempFontFile (fontpath, __start_veramoit_ttf, __stop_veramoit_ttf);
-                    break;
-                }
-                case VisualFont::VeraMonoBoldItalic:
-                {
-                    fontpath = "/tmp/VeraMoBI.ttf";
-                    this->makeTempFontFile (fontpath, __start_veramobi_ttf, __stop_veramobi_ttf);
-                    break;
-                }
-                case VisualFont::VeraSerif:
-                {
-                    fontpath = "/tmp/VeraSe.ttf";
-                    this->makeTempFontFile (fontpath, __start_verase_ttf, __stop_verase_ttf);
-                    break;
-                }
-                case VisualFont::VeraSerifBold:
-                {
-                    fontpath = "/tmp/VeraSeBd.ttf";
-                    this->makeTempFontFile (fontpath, __start_verasebd_ttf, __stop_verasebd_ttf);
-                    break;
-                }
-                default:
-                {
+                case VisualFont::DVSans: { return MPLOT_EMBEDDED_FONT(dvsans); }
+                case VisualFont::DVSansItalic: { return MPLOT_EMBEDDED_FONT(dvsansit); }
+                case VisualFont::DVSansBold: { return MPLOT_EMBEDDED_FONT(dvsansbd); }
+                case VisualFont::DVSansBoldItalic: { return MPLOT_EMBEDDED_FONT(dvsansbi); }
+                case VisualFont::Vera: { return MPLOT_EMBEDDED_FONT(vera); }
+                case VisualFont::VeraItalic: { return MPLOT_EMBEDDED_FONT(verait); }
+                case VisualFont::VeraBold: { return MPLOT_EMBEDDED_FONT(verabd); }
+                case VisualFont::VeraBoldItalic: { return MPLOT_EMBEDDED_FONT(verabi); }
+                case VisualFont::VeraMono: { return MPLOT_EMBEDDED_FONT(veramono); }
+                case VisualFont::VeraMonoBold: { return MPLOT_EMBEDDED_FONT(veramobd); }
+                case VisualFont::VeraMonoItalic: { return MPLOT_EMBEDDED_FONT(veramoit); }
+                case VisualFont::VeraMonoBoldItalic: { return MPLOT_EMBEDDED_FONT(veramobi); }
+                case VisualFont::VeraSerif: { return MPLOT_EMBEDDED_FONT(verase); }
+                case VisualFont::VeraSerifBold: { return MPLOT_EMBEDDED_FONT(verasebd); }
+                default: { return { nullptr, 0 }; }
+                }
+#undef MPLOT_EMBEDDED_FONT
+            }
+
+            void init_common (const mplot::VisualFont _font, unsigned int fontpixels, FT_Library& ft_freetype,
+                              const bool _sdf = false)
+            {
+                this->sdf = _sdf;
+
+                // The embedded font data lives as long as the program, so FreeType can read it in
+                // place. No font file is written or opened.
+                const auto [font_data, font_size] = embedded_font (_font);
+                if (font_data == nullptr) {
                     std::cout << "ERROR::Unsupported mplot font\n";
-                    break;
-                }
+                    this->face = nullptr;
+                    return;
                 }
-#endif // Windows/Non-windows
 
                 // Keep the face as a mplot::Visual owned resource, shared by VisTextModels?
                 if constexpr (debug_visualface == true) {
-                    std::cout << "FT_New_Face (ft_freetype, " << fontpath << ", 0, &this->face);\n";
+                    std::cout << "FT_New_Memory_Face (ft_freetype, " << static_cast<const void*>(font_data)
+                              << ", " << font_size << ", 0, &this->face);\n";
                 }
-                if (FT_New_Face (ft_freetype, fontpath.c_str(), 0, &this->face)) {
-                    std::cout << "ERROR::FREETYPE: Failed to load font (font file may be invalid)" << std::endl;
+                if (FT_New_Memory_Face (ft_freetype, font_data, font_size, 0, &this->face)) {
+                    std::cout << "ERROR::FREETYPE: Failed to load font (font data may be invalid)" << std::endl;
+                    this->face = nullptr;
+                    return;
                 }
 
                 FT_Set_Pixel_Sizes (this->face, 0, fontpixels);
+                this->init_atlas (fontpixels);
 
                 // Can I check this->face for how many glyphs it has? Yes:
                 // std::cout << "This face has " << this->face->num_glyphs << " glyphs.\n";
             }
-
-            //! Create a temporary font file at fontpath, using the embedded data
-            //! starting from filestart and extending to filenend
-            template <typename T = const char>
-            void makeTempFontFile (const std::string& fontpath, T* file_start, T* file_stop)
-            {
-                T* p;
-                if (!mplot::tools::fileExists (fontpath)) {
-                    std::ofstream fout;
-                    fout.open (fontpath.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
-                    if (fout.is_open()) {
-                        for (p = file_start; p < file_stop; p++) { fout << *p; }
-                        fout.close();
-                    } else {
-                        std::cout << "WARNING: Failed to open " << fontpath << "!!\n";
-                    }
-                } else {
-                    if constexpr (debug_visualface == true) {
-                        std::cout << "INFO: " << fontpath << " already exists, no need to re-create it\n";
-                    }
-                }
-            }
         };
     } // namespace gl
 } // namespace mplot
@@ -2,7 +2,7 @@
  * \file
  *
  * Declares a VisualFace class to hold the information about a (Freetype-managed) font face and the
- * GL-textures that will reproduce it.
+ * GL-texture atlas that will reproduce it.
  *
  * This class is derived from VisualFaceBase and adds multi-context-safe GLAD-arranged GL function
  * calls.
@@ -39,69 +39,64 @@ namespace mplot {
              * VisualResources holds a map of VisualFace instances, to avoid many copies
              * of font textures for separate VisualTextModel instances which might have
              * the same pixel size.
+             *
+             * If \a _sdf is true, the glyphs are rendered as signed distance fields, which the
+             * text shader can draw sharply at any size.
              */
             VisualFaceMX (const mplot::VisualFont _font, unsigned int fontpixels, FT_Library& ft_freetype,
-                          GladGLContext* glfn = nullptr)
+                          GladGLContext* _glfn = nullptr, const bool _sdf = false)
             {
-                this->init_common (_font, fontpixels, ft_freetype);
+                if (_glfn == nullptr) { throw std::runtime_error ("glfn problem"); }
+                this->glfn = _glfn;
+                GLint max_tex = 0;
+                this->glfn->GetIntegerv (GL_MAX_TEXTURE_SIZE, &max_tex);
+                if (max_tex > 0) { this->atlas_max = max_tex; }
+                this->init_common (_font, fontpixels, ft_freetype, _sdf);
+                this->upload_atlas (true, 0, 0, 0, 0); // create the (empty) atlas texture
+                this->prewarm();
+            }
 
-                // How far to loop. In principle, up to 21 bits worth - that's 2097151 possible characters!
-                for (char32_t c = 0; c < 2097151; c++) {
-                    // Check glyph index first, if it's 0 it's a blank so skip.
-                    if (FT_Get_Char_Index (this->face, c) == 0) { continue; }
+            ~VisualFaceMX()
+            {
+                // Delete the glyph atlas. The GL context of the face's Visual should be current.
+                if (this->atlas_texture != 0) { this->glfn->DeleteTextures (1, &this->atlas_texture); }
+            }
 
-                    // load character glyph
-                    if (FT_Load_Char (this->face, c, FT_LOAD_RENDER)) {
-                        std::cout << "ERROR::FREETYPE: Failed to load Glyph for Unicode 0x"
-                                  << std::hex << static_cast<unsigned int>(c) << std::dec << std::endl;
-                        continue;
-                    }
+            //! Use another GL function context, in the same share group, for later atlas uploads
+            void set_glfn (GladGLContext* _glfn) { this->glfn = _glfn; }
 
-                    // generate texture
-                    unsigned int texture = 0;
+        protected:
+            //! The GL function context in which the glyph textures are created
+            GladGLContext* glfn = nullptr;
 
-                    if (glfn == nullptr) { throw std::runtime_error ("glfn problem"); }
-                    glfn->GenTextures (1, &texture);
-                    glfn->BindTexture (GL_TEXTURE_2D, texture);
-                    glfn->TexImage2D(
-                        GL_TEXTURE_2D,
-                        0,
-                        GL_RED,
-                        this->face->glyph->bitmap.width,
-                        this->face->glyph->bitmap.rows,
-                        0,
-                        GL_RED,
-                        GL_UNSIGNED_BYTE,
-                        this->face->glyph->bitmap.buffer
-                        );
+            //! Upload some or all of atlas_pixels to the atlas texture
+            void upload_atlas (const bool realloc, const int x, const int y, const int w, const int h) final
+            {
+                this->glfn->PixelStorei (GL_UNPACK_ALIGNMENT, 1); // atlas rows are byte-aligned
+                if (this->atlas_texture == 0) {
+                    this->glfn->GenTextures (1, &this->atlas_texture);
+                    this->glfn->BindTexture (GL_TEXTURE_2D, this->atlas_texture);
                     // set texture options
-                    glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                    glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                    glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                    glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); // Could be GL_NEAREST, but doesn't look as good.
-
-                    // now store character for later use
-                    mplot::visgl::CharInfo glchar = {
-                        texture,
-                        {static_cast<int>(this->face->glyph->bitmap.width), static_cast<int>(this->face->glyph->bitmap.rows)}, // size
-                        {this->face->glyph->bitmap_left, this->face->glyph->bitmap_top}, // bearing
-                        static_cast<unsigned int>(this->face->glyph->advance.x)          // advance
-                    };
-
-                    if constexpr (debug_visualface == true) {
-                        std::cout << "Inserting character into this->glchars with info: ID:" << glchar.textureID
-                                  << ", Size:" << glchar.size << ", Bearing:" << glchar.bearing
-                                  << ", Advance:" << glchar.advance << std::endl;
-                    }
-                    this->glchars.insert (std::pair<char32_t, mplot::visgl::CharInfo>(c, glchar));
+                    this->glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                    this->glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                    this->glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                    this->glfn->TexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); // Could be GL_NEAREST, but doesn't look as good.
+                } else {
+                    this->glfn->BindTexture (GL_TEXTURE_2D, this->atlas_texture);
                 }
-                glfn->BindTexture(GL_TEXTURE_2D, 0);
-
-                // At this point could FT_Done_Face() etc, I think. as we no longer do anything Freetypey with it.
-                FT_Done_Face (this->face);
+                if (realloc) {
+                    // Respecify the whole texture. The texture name is unchanged, and as texture
+                    // coordinates are given in texels, existing text remains valid.
+                    this->glfn->TexImage2D (GL_TEXTURE_2D, 0, GL_RED, this->atlas_w, this->atlas_h, 0,
+                                  GL_RED, GL_UNSIGNED_BYTE, this->atlas_pixels.data());
+                } else if (w > 0 && h > 0) {
+                    this->glfn->PixelStorei (GL_UNPACK_ROW_LENGTH, this->atlas_w);
+                    this->glfn->TexSubImage2D (GL_TEXTURE_2D, 0, x, y, w, h, GL_RED, GL_UNSIGNED_BYTE,
+                                     this->atlas_pixels.data() + y * this->atlas_w + x);
+                    this->glfn->PixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+                }
+                this->glfn->BindTexture (GL_TEXTURE_2D, 0);
             }
-
-            ~VisualFaceMX() {}
         };
     } // namespace gl
 } // namespace mplot
@@ -38,68 +38,56 @@ namespace mplot {
              * VisualResources holds a map of VisualFace instances, to avoid many copies
              * of font textures for separate VisualTextModel instances which might have
              * the same pixel size.
+             *
+             * If \a _sdf is true, the glyphs are rendered as signed distance fields, which the
+             * text shader can draw sharply at any size.
              */
-            VisualFaceNoMX (const mplot::VisualFont _font, unsigned int fontpixels, FT_Library& ft_freetype)
+            VisualFaceNoMX (const mplot::VisualFont _font, unsigned int fontpixels, FT_Library& ft_freetype,
+                            const bool _sdf = false)
             {
-                this->init_common (_font, fontpixels, ft_freetype);
-
-                // How far to loop. In principle, up to 21 bits worth - that's 2097151 possible characters!
-                for (char32_t c = 0; c < 2097151; c++) {
-                    // Check glyph index first, if it's 0 it's a blank so skip.
-                    if (FT_Get_Char_Index (this->face, c) == 0) { continue; }
-
-                    // load character glyph
-                    if (FT_Load_Char (this->face, c, FT_LOAD_RENDER)) {
-                        std::cout << "ERROR::FREETYPE: Failed to load Glyph for Unicode 0x"
-                                  << std::hex << static_cast<unsigned int>(c) << std::dec << std::endl;
-                        continue;
-                    }
+                GLint max_tex = 0;
+                glGetIntegerv (GL_MAX_TEXTURE_SIZE, &max_tex);
+                if (max_tex > 0) { this->atlas_max = max_tex; }
+                this->init_common (_font, fontpixels, ft_freetype, _sdf);
+                this->upload_atlas (true, 0, 0, 0, 0); // create the (empty) atlas texture
+                this->prewarm();
+            }
 
-                    // generate texture
-                    unsigned int texture = 0;
+            ~VisualFaceNoMX()
+            {
+                // Delete the glyph atlas. The GL context of the face's Visual should be current.
+                if (this->atlas_texture != 0) { glDeleteTextures (1, &this->atlas_texture); }
+            }
 
-                    glGenTextures (1, &texture);
-                    glBindTexture (GL_TEXTURE_2D, texture);
-                    glTexImage2D(
-                        GL_TEXTURE_2D,
-                        0,
-                        GL_RED,
-                        this->face->glyph->bitmap.width,
-                        this->face->glyph->bitmap.rows,
-                        0,
-                        GL_RED,
-                        GL_UNSIGNED_BYTE,
-                        this->face->glyph->bitmap.buffer
-                        );
+        protected:
+            //! Upload some or all of atlas_pixels to the atlas texture
+            void upload_atlas (const bool realloc, const int x, const int y, const int w, const int h) final
+            {
+                glPixelStorei (GL_UNPACK_ALIGNMENT, 1); // atlas rows are byte-aligned
+                if (this->atlas_texture == 0) {
+                    glGenTextures (1, &this->atlas_texture);
+                    glBindTexture (GL_TEXTURE_2D, this->atlas_texture);
                     // set texture options
                     glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
                     glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
                     glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
                     glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR); // Could be GL_NEAREST, but doesn't look as good.
-
-                    // now store character for later use
-                    mplot::visgl::CharInfo glchar = {
-                        texture,
-                        {static_cast<int>(this->face->glyph->bitmap.width), static_cast<int>(this->face->glyph->bitmap.rows)}, // size
-                        {this->face->glyph->bitmap_left, this->face->glyph->bitmap_top}, // bearing
-                        static_cast<unsigned int>(this->face->glyph->advance.x)          // advance
-                    };
-
-                    if constexpr (debug_visualface == true) {
-                        std::cout << "Inserting character into this->glchars with info: ID:" << glchar.textureID
-                                  << ", Size:" << glchar.size << ", Bearing:" << glchar.bearing
-                                  << ", Advance:" << glchar.advance << std::endl;
-                    }
-                    this->glchars.insert (std::pair<char32_t, mplot::visgl::CharInfo>(c, glchar));
+                } else {
+                    glBindTexture (GL_TEXTURE_2D, this->atlas_texture);
                 }
-
-                glBindTexture(GL_TEXTURE_2D, 0);
-
-                // At this point could FT_Done_Face() etc, I think. as we no longer do anything Freetypey with it.
-                FT_Done_Face (this->face);
+                if (realloc) {
+                    // Respecify the whole texture. The texture name is unchanged, and as texture
+                    // coordinates are given in texels, existing text remains valid.
+                    glTexImage2D (GL_TEXTURE_2D, 0, GL_RED, this->atlas_w, this->atlas_h, 0,
+                                  GL_RED, GL_UNSIGNED_BYTE, this->atlas_pixels.data());
+                } else if (w > 0 && h > 0) {
+                    glPixelStorei (GL_UNPACK_ROW_LENGTH, this->atlas_w);
+                    glTexSubImage2D (GL_TEXTURE_2D, 0, x, y, w, h, GL_RED, GL_UNSIGNED_BYTE,
+                                     this->atlas_pixels.data() + y * this->atlas_w + x);
+                    glPixelStorei (GL_UNPACK_ROW_LENGTH, 0);
+                }
+                glBindTexture (GL_TEXTURE_2D, 0);
             }
-
-            ~VisualFaceNoMX() {}
         };
     } // namespace gl
 } // namespace mplot
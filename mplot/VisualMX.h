@@ -23,6 +23,7 @@
 #endif // _glfw3_h_
 
 #include <mutex>
+#include <set>
 #include <chrono>
 
 namespace mplot {
@@ -79,6 +80,7 @@ namespace mplot {
         ~VisualMX()
         {
             this->setContext();
+            shared_windows.erase (this->window);
             glfwDestroyWindow (this->window);
             this->deconstructCommon();
         }
@@ -233,11 +235,15 @@ namespace mplot {
 
         void init_window()
         {
-            this->window = glfwCreateWindow (this->window_w, this->window_h, this->title.c_str(), NULL, NULL);
+            // A sharing Visual shares GL objects (such as the glyph atlases) with the others
+            GLFWwindow* share = nullptr;
+            if (this->shares_resources && !shared_windows.empty()) { share = *shared_windows.begin(); }
+            this->window = glfwCreateWindow (this->window_w, this->window_h, this->title.c_str(), NULL, share);
             if (!this->window) {
                 // Window or OpenGL context creation failed
                 throw std::runtime_error("GLFW window creation failed!");
             }
+            if (this->shares_resources) { shared_windows.insert (this->window); }
             // now associate "this" object with mWindow object
             glfwSetWindowUserPointer (this->window, this);
 
@@ -255,6 +261,9 @@ namespace mplot {
         }
 
     private:
+        //! The windows of the sharing Visuals (see VisualBase::share_gl_resources)
+        static inline std::set<GLFWwindow*> shared_windows;
+
         //! Context mutex to prevent contexts being acquired in a non-threadsafe manner.
         std::mutex context_mutex;
 
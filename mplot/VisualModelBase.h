@@ -19,6 +19,8 @@
 #endif
 
 #include <iostream>
+#include <fstream>
+#include <filesystem>
 #include <vector>
 #include <array>
 #include <algorithm>
@@ -28,6 +30,9 @@
 #include <functional>
 #include <cstddef>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <bit>
 #include <bitset>
 
 #include <mplot/gl/version.h>
@@ -43,6 +48,7 @@
 
 #include <mplot/VisualCommon.h>
 #include <mplot/colour.h>
+#include <mplot/vertexcache.h>
 
 namespace mplot {
 
@@ -116,8 +122,55 @@ namespace mplot {
         //! reinit ONLY vertexColors buffer
         virtual void reinit_colour_buffer() = 0;
 
+        /*!
+         * Re-upload parts of the position, normal and/or colour buffers after some vertices have
+         * been rewritten in place. Each element of vranges is a [first, last) range of vertex
+         * indices. The buffers are not reallocated, so the number of vertices must not change.
+         */
+        virtual void reinit_buffer_ranges (const std::vector<std::array<std::size_t, 2>>& vranges,
+                                           const bool positions, const bool normals, const bool colours) = 0;
+
+        /*!
+         * Upload vertices and indices that have been appended since the buffers were last
+         * uploaded, from vertex first_vertex and index first_index onwards. When the new data fit
+         * in the buffers' spare capacity, only the new data are uploaded. Otherwise, the buffers
+         * are reallocated at twice the size needed, so that a sequence of appends costs amortised
+         * O(1) per appended vertex.
+         */
+        virtual void reinit_appended_buffers (const std::size_t first_vertex, const std::size_t first_index) = 0;
+
+        /*!
+         * Sort and merge element indices into [first, last) ranges of vertices for
+         * reinit_buffer_ranges, in a model in which element i owns the nv vertices from
+         * v0 + nv * i. Ranges less than 64 vertices apart are merged, as uploading a few unchanged
+         * vertices costs less than another BufferSubData call.
+         */
+        template <typename R>
+        static std::vector<std::array<std::size_t, 2>> vertex_ranges (const R& indices, const std::size_t nv,
+                                                                      const std::size_t v0 = 0)
+        {
+            constexpr std::size_t merge_gap = 64;
+            std::vector<std::size_t> sorted;
+            sorted.reserve (std::size (indices));
+            for (auto i : indices) { sorted.push_back (static_cast<std::size_t>(i)); }
+            std::sort (sorted.begin(), sorted.end());
+            std::vector<std::array<std::size_t, 2>> vranges;
+            for (auto i : sorted) {
+                const std::size_t first = v0 + nv * i;
+                if (!vranges.empty() && first <= vranges.back()[1] + merge_gap) {
+                    vranges.back()[1] = std::max (vranges.back()[1], first + nv);
+                } else {
+                    vranges.push_back ({ first, first + nv });
+                }
+            }
+            return vranges;
+        }
+
         virtual void clearTexts() = 0;
 
+        //! Remove all the polylines, freeing their GL buffers
+        virtual void clearPolylines() = 0;
+
         //! Clear out the model, *including text models*
         void clear()
         {
@@ -125,6 +178,7 @@ namespace mplot {
             this->vertexNormals.clear();
             this->vertexColors.clear();
             this->indices.clear();
+            this->clearPolylines();
             this->clearTexts();
             this->idx = 0u;
             this->reinit_buffers();
@@ -139,6 +193,7 @@ namespace mplot {
             this->vertexNormals.clear();
             this->vertexColors.clear();
             this->indices.clear();
+            this->clearPolylines();
             // NB: Do NOT call clearTexts() here! We're only updating the model itself.
             this->idx = 0u;
             this->initializeVertices();
@@ -157,6 +212,7 @@ namespace mplot {
             this->vertexNormals.clear();
             this->vertexColors.clear();
             this->indices.clear();
+            this->clearPolylines();
             this->clearTexts();
             this->idx = 0u;
             this->initializeVertices();
@@ -178,13 +234,129 @@ namespace mplot {
         void finalize()
         {
             if (this->setContext != nullptr) { this->setContext (this->parentVis); }
-            this->initializeVertices();
+            if (this->load_vertex_cache() == false) {
+                this->initializeVertices();
+                this->save_vertex_cache();
+            }
             this->postVertexInitRequired = true;
             // Release context after creating and finalizing this VisualModel. On Visual::render(),
             // context will be re-acquired.
             if (this->releaseContext != nullptr) { this->releaseContext (this->parentVis); }
         }
 
+        /*
+         * Vertex caching. Models whose geometry is expensive to compute (HealpixVisual,
+         * GeodesicVisual, VoronoiVisual) can save their finalised vertices to disk and reload them
+         * on later runs. Set vertex_cache_dir before calling finalize() to enable this.
+         */
+
+        //! Directory for vertex cache files. If empty (the default), vertices are never cached.
+        std::filesystem::path vertex_cache_dir;
+
+        /*!
+         * The most disk space that the vertex cache files in vertex_cache_dir may take up. After a
+         * model writes its cache file, the least recently used files are removed to keep within
+         * this size. 0 means no limit.
+         */
+        std::uintmax_t vertex_cache_max_bytes = std::uintmax_t{256} << 20;
+
+        /*!
+         * Return a content hash of all the inputs that determine the vertices made by
+         * initializeVertices(). Return 0 (the default) if the model can't be cached, for example
+         * because initializeVertices() also creates text labels.
+         */
+        virtual uint64_t vertex_cache_key() { return 0u; }
+
+        //! Save any extra state that initializeVertices() computes (other than the vertices)
+        virtual void vertex_cache_save_extra ([[maybe_unused]] std::ostream& os) {}
+        //! Restore the extra state saved by vertex_cache_save_extra. Return false on failure.
+        virtual bool vertex_cache_load_extra ([[maybe_unused]] std::istream& is) { return true; }
+
+        //! Write a vector with its size to a vertex cache stream
+        template <typename T>
+        static void vertex_cache_write (std::ostream& os, const std::vector<T>& v)
+        {
+            uint64_t n = v.size();
+            os.write (reinterpret_cast<const char*>(&n), sizeof (n));
+            os.write (reinterpret_cast<const char*>(v.data()), n * sizeof (T));
+        }
+
+        //! Read a vector written by vertex_cache_write in one read call
+        template <typename T>
+        static bool vertex_cache_read (std::istream& is, std::vector<T>& v)
+        {
+            uint64_t n = 0u;
+            if (!is.read (reinterpret_cast<char*>(&n), sizeof (n))) { return false; }
+            v.resize (n);
+            return static_cast<bool>(is.read (reinterpret_cast<char*>(v.data()), n * sizeof (T)));
+        }
+
+        //! If caching is enabled, write the vertices to the cache file. Failure to write is not an error.
+        void save_vertex_cache()
+        {
+            if (this->vertex_cache_dir.empty()) { return; }
+            const uint64_t key = this->vertex_cache_key();
+            if (key == 0u) { return; }
+            std::filesystem::path fp = this->vertex_cache_dir / mplot::vertexcache::filename (key);
+            // Write to a temporary file, then rename, so that a half written cache is never read
+            std::filesystem::path tmp = mplot::cachetools::tmp_path (fp);
+            std::ofstream os (tmp, std::ios::out | std::ios::trunc | std::ios::binary);
+            if (!os.is_open()) { return; }
+            const uint32_t hdr[2] = { mplot::vertexcache::magic, mplot::vertexcache::format_version };
+            os.write (reinterpret_cast<const char*>(hdr), sizeof (hdr));
+            os.write (reinterpret_cast<const char*>(&key), sizeof (key));
+            os.write (reinterpret_cast<const char*>(&this->idx), sizeof (this->idx));
+            vertex_cache_write (os, this->indices);
+            vertex_cache_write (os, this->vertexPositions);
+            vertex_cache_write (os, this->vertexNormals);
+            vertex_cache_write (os, this->vertexColors);
+            this->vertex_cache_save_extra (os);
+            os.close();
+            std::error_code ec;
+            if (os) { std::filesystem::rename (tmp, fp, ec); }
+            if (!os || ec) { std::filesystem::remove (tmp, ec); }
+            if (this->vertex_cache_max_bytes > 0u) {
+                mplot::cachetools::prune (this->vertex_cache_dir, mplot::vertexcache::file_prefix,
+                                          this->vertex_cache_max_bytes);
+            }
+        }
+
+        //! If caching is enabled and a cache file matching vertex_cache_key() exists, load the
+        //! vertices from it and return true.
+        bool load_vertex_cache()
+        {
+            if (this->vertex_cache_dir.empty()) { return false; }
+            const uint64_t key = this->vertex_cache_key();
+            if (key == 0u) { return false; }
+            const std::filesystem::path fp = this->vertex_cache_dir / mplot::vertexcache::filename (key);
+            std::ifstream is (fp, std::ios::in | std::ios::binary);
+            if (!is.is_open()) { return false; }
+            uint32_t hdr[2] = { 0u, 0u };
+            uint64_t filekey = 0u;
+            GLuint _idx = 0u;
+            is.read (reinterpret_cast<char*>(hdr), sizeof (hdr));
+            is.read (reinterpret_cast<char*>(&filekey), sizeof (filekey));
+            is.read (reinterpret_cast<char*>(&_idx), sizeof (_idx));
+            if (!is || hdr[0] != mplot::vertexcache::magic
+                || hdr[1] != mplot::vertexcache::format_version || filekey != key) { return false; }
+            if (vertex_cache_read (is, this->indices)
+                && vertex_cache_read (is, this->vertexPositions)
+                && vertex_cache_read (is, this->vertexNormals)
+                && vertex_cache_read (is, this->vertexColors)
+                && this->vertex_cache_load_extra (is)) {
+                this->idx = _idx;
+                is.close();
+                mplot::cachetools::touch (fp);
+                return true;
+            }
+            // A corrupt cache. Clear anything that was read, so the vertices can be built afresh
+            this->indices.clear();
+            this->vertexPositions.clear();
+            this->vertexNormals.clear();
+            this->vertexColors.clear();
+            return false;
+        }
+
         //! Render the VisualModel. Note that it is assumed that the OpenGL context has been
         //! obtained by the parent Visual::render call.
         virtual void render() = 0;
@@ -356,6 +528,16 @@ namespace mplot {
          */
         void computeVertexMaxMins()
         {
+            // Reset, in case the vertices have changed since the last call
+            this->idx_max = 0u;
+            this->idx_min = std::numeric_limits<GLuint>::max();
+            this->vpos_maxes.set_from (_low);
+            this->vpos_mins.set_from (_max);
+            this->vcol_maxes.set_from (_low);
+            this->vcol_mins.set_from (_max);
+            this->vnorm_maxes.set_from (_low);
+            this->vnorm_mins.set_from (_max);
+
             // Compute index maxmins
             for (std::size_t i = 0u; i < this->indices.size(); ++i) {
                 idx_max = this->indices[i] > idx_max ? this->indices[i] : idx_max;
@@ -447,6 +629,158 @@ namespace mplot {
         }
         // end Visual::savegltf() methods
 
+        /*
+         * Methods used by Visual::saveglb(). These stream the vertex data straight out of the
+         * vertex vectors into the binary chunk of a .glb file, without intermediate copies of the
+         * whole model. Quantised variants convert a few thousand elements at a time.
+         */
+
+        //! The number of elements converted per write when streaming converted data
+        static constexpr std::size_t glb_chunk = 4096u;
+
+        //! Write the elements of v to os as little endian bytes (as glTF requires)
+        template <typename T>
+        static void write_le (std::ostream& os, const std::vector<T>& v)
+        {
+            if constexpr (std::endian::native == std::endian::little) {
+                os.write (reinterpret_cast<const char*>(v.data()), v.size() * sizeof (T));
+            } else {
+                std::array<char, glb_chunk * sizeof (T)> buf;
+                for (std::size_t i = 0u; i < v.size(); i += glb_chunk) {
+                    std::size_t n = std::min (glb_chunk, v.size() - i);
+                    for (std::size_t j = 0u; j < n; ++j) {
+                        const char* e = reinterpret_cast<const char*>(&v[i + j]);
+                        std::reverse_copy (e, e + sizeof (T), buf.data() + j * sizeof (T));
+                    }
+                    os.write (buf.data(), n * sizeof (T));
+                }
+            }
+        }
+
+        //! Write zero bytes to os to pad nbytes up to a multiple of 4
+        static void write_pad4 (std::ostream& os, std::size_t nbytes)
+        {
+            static constexpr char zeros[4] = { 0, 0, 0, 0 };
+            if (nbytes % 4u) { os.write (zeros, 4u - nbytes % 4u); }
+        }
+
+        //! Can indices be written as unsigned shorts? Requires computeVertexMaxMins() first.
+        bool indices_fit_u16() const { return this->indices.empty() || this->idx_max < 65536u; }
+
+        //! Write indices as unsigned int or (if short_indices) unsigned short, padded to 4 bytes.
+        //! Returns the number of bytes written, excluding padding.
+        std::size_t write_indices_glb (std::ostream& os, const bool short_indices) const
+        {
+            if (!short_indices) {
+                write_le (os, this->indices);
+                return this->indices.size() * sizeof (GLuint);
+            }
+            std::array<uint8_t, glb_chunk * 2u> buf;
+            for (std::size_t i = 0u; i < this->indices.size(); i += glb_chunk) {
+                std::size_t n = std::min (glb_chunk, this->indices.size() - i);
+                for (std::size_t j = 0u; j < n; ++j) {
+                    buf[2u * j] = this->indices[i + j] & 0xff;
+                    buf[2u * j + 1u] = this->indices[i + j] >> 8 & 0xff;
+                }
+                os.write (reinterpret_cast<const char*>(buf.data()), n * 2u);
+            }
+            std::size_t nbytes = this->indices.size() * 2u;
+            write_pad4 (os, nbytes);
+            return nbytes;
+        }
+
+        //! Write vertexPositions, vertexColors and vertexNormals as floats
+        void write_vpos_glb (std::ostream& os) const { write_le (os, this->vertexPositions); }
+        void write_vcol_glb (std::ostream& os) const { write_le (os, this->vertexColors); }
+        void write_vnorm_glb (std::ostream& os) const { write_le (os, this->vertexNormals); }
+
+        /*!
+         * Quantisation of positions (KHR_mesh_quantization): Each position p is stored as a
+         * normalized short q, with p = centre + halfwidth * q / 32767. The centre and halfwidth
+         * are applied as the node translation and scale. Requires computeVertexMaxMins() first.
+         */
+        sm::vec<float, 3> vpos_quant_centre() const { return (this->vpos_maxes + this->vpos_mins) / 2.0f; }
+        sm::vec<float, 3> vpos_quant_halfwidth() const
+        {
+            sm::vec<float, 3> hw = (this->vpos_maxes - this->vpos_mins) / 2.0f;
+            for (auto& h : hw) { h = h > 0.0f ? h : 1.0f; }
+            return hw;
+        }
+
+        //! The quantised value of vpos_maxes. It's 32767, or 0 in a dimension in which the model is flat.
+        sm::vec<int, 3> vpos_quant_max() const
+        {
+            sm::vec<int, 3> qm = {};
+            for (unsigned int k = 0; k < 3; ++k) { qm[k] = this->vpos_maxes[k] > this->vpos_mins[k] ? 32767 : 0; }
+            return qm;
+        }
+
+        //! Write vertexPositions as normalized shorts, in 8 byte (4-aligned) elements
+        void write_vpos_quantised_glb (std::ostream& os) const
+        {
+            const sm::vec<float, 3> c = this->vpos_quant_centre();
+            const sm::vec<float, 3> hw = this->vpos_quant_halfwidth();
+            std::array<uint8_t, glb_chunk * 8u> buf = {};
+            const std::size_t nv = this->vertexPositions.size() / 3u;
+            for (std::size_t i = 0u; i < nv; i += glb_chunk) {
+                std::size_t n = std::min (glb_chunk, nv - i);
+                for (std::size_t j = 0u; j < n; ++j) {
+                    for (std::size_t k = 0u; k < 3u; ++k) {
+                        float q = std::round ((this->vertexPositions[3u * (i + j) + k] - c[k]) / hw[k] * 32767.0f);
+                        auto s = static_cast<uint16_t>(static_cast<int16_t>(std::clamp (q, -32767.0f, 32767.0f)));
+                        buf[8u * j + 2u * k] = s & 0xff;
+                        buf[8u * j + 2u * k + 1u] = s >> 8 & 0xff;
+                    }
+                }
+                os.write (reinterpret_cast<const char*>(buf.data()), n * 8u);
+            }
+        }
+
+        //! Write vertexColors as normalized unsigned bytes, in 4 byte elements
+        void write_vcol_quantised_glb (std::ostream& os) const
+        {
+            std::array<uint8_t, glb_chunk * 4u> buf = {};
+            const std::size_t nv = this->vertexColors.size() / 3u;
+            for (std::size_t i = 0u; i < nv; i += glb_chunk) {
+                std::size_t n = std::min (glb_chunk, nv - i);
+                for (std::size_t j = 0u; j < n; ++j) {
+                    for (std::size_t k = 0u; k < 3u; ++k) {
+                        float c = std::clamp (this->vertexColors[3u * (i + j) + k], 0.0f, 1.0f);
+                        buf[4u * j + k] = static_cast<uint8_t>(std::round (c * 255.0f));
+                    }
+                }
+                os.write (reinterpret_cast<const char*>(buf.data()), n * 4u);
+            }
+        }
+
+        /*!
+         * Write vertexNormals as normalized signed bytes, in 4 byte elements. Viewers transform
+         * normals by the inverse-transpose of the node transform, which divides each component
+         * by the node scale (vpos_quant_halfwidth). To undo that, each normal is multiplied by
+         * the halfwidth and renormalised before it is quantised.
+         */
+        void write_vnorm_quantised_glb (std::ostream& os) const
+        {
+            const sm::vec<float, 3> hw = this->vpos_quant_halfwidth();
+            std::array<uint8_t, glb_chunk * 4u> buf = {};
+            const std::size_t nv = this->vertexNormals.size() / 3u;
+            for (std::size_t i = 0u; i < nv; i += glb_chunk) {
+                std::size_t n = std::min (glb_chunk, nv - i);
+                for (std::size_t j = 0u; j < n; ++j) {
+                    sm::vec<float, 3> nrm = {};
+                    for (std::size_t k = 0u; k < 3u; ++k) { nrm[k] = this->vertexNormals[3u * (i + j) + k] * hw[k]; }
+                    const float len = nrm.length();
+                    if (len > 0.0f) { nrm /= len; }
+                    for (std::size_t k = 0u; k < 3u; ++k) {
+                        float q = std::round (std::clamp (nrm[k], -1.0f, 1.0f) * 127.0f);
+                        buf[4u * j + k] = static_cast<uint8_t>(static_cast<int8_t>(q));
+                    }
+                }
+                os.write (reinterpret_cast<const char*>(buf.data()), n * 4u);
+            }
+        }
+        // end Visual::saveglb() methods
+
         //! If true, then this VisualModel should always be viewed in a plane - it's a 2D model
         bool twodimensional = false;
 
@@ -479,6 +813,8 @@ namespace mplot {
         std::function<GLuint(mplot::VisualBase<glver>*)> get_gprog;
         //! Get the text shader prog id
         std::function<GLuint(mplot::VisualBase<glver>*)> get_tprog;
+        //! Get the line shader prog id
+        std::function<GLuint(mplot::VisualBase<glver>*)> get_lprog;
 
         //! Set OpenGL context. Should call parentVis->setContext().
         std::function<void(mplot::VisualBase<glver>*)> setContext;
@@ -501,6 +837,15 @@ namespace mplot {
         //! An additional scaling applied to viewmatrix to scale the size of the model [see render()]
         sm::mat44<float> model_scaling = {};
 
+        /*!
+         * The elements from indices[scroll_first_index] onwards are drawn with the model
+         * translated by scroll_offset (in model coordinates). GraphVisual places the vertices of
+         * its scrolling datasets there, so that they can be scrolled by changing scroll_offset
+         * rather than by moving every vertex.
+         */
+        std::size_t scroll_first_index = std::numeric_limits<std::size_t>::max();
+        sm::vec<float> scroll_offset = { 0.0f, 0.0f, 0.0f };
+
         /*!
          * The spatial offset of this VisualModel within the mplot::Visual 'scene
          * view'. Note that this is not incorporated into the computation of the
@@ -537,6 +882,10 @@ namespace mplot {
 
         //! Vertex Buffer Objects stored in an array
         std::unique_ptr<GLuint[]> vbos;
+        //! The number of vertices (and of indices) that the GL buffers have room for. Buffers are
+        //! allocated to fit by reinit_buffers, but with room to spare by reinit_appended_buffers.
+        std::size_t buffer_vertex_capacity = 0;
+        std::size_t buffer_index_capacity = 0;
 
         //! CPU-side data for indices
         std::vector<GLuint> indices = {};
@@ -547,6 +896,13 @@ namespace mplot {
         //! CPU-side data for vertex colours
         std::vector<float> vertexColors = {};
 
+        /*!
+         * Lines that are drawn by the line shader program, after the triangles. Only their points
+         * are uploaded (when render() finds that points have been added), so changes to a
+         * polyline's width, colour or dashes take effect on the next render.
+         */
+        std::vector<mplot::visgl::polyline> polylines;
+
         static constexpr float _max = std::numeric_limits<float>::max();
         static constexpr float _low = std::numeric_limits<float>::lowest();
 
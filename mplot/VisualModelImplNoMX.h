@@ -42,6 +42,7 @@ namespace mplot {
         {
             // Explicitly clear owned VisualTextModels
             this->texts.clear();
+            this->clearPolylines();
             if (this->vbos != nullptr) {
                 glDeleteBuffers (this->numVBO, this->vbos.get());
                 glDeleteVertexArrays (1, &this->vao);
@@ -98,6 +99,8 @@ namespace mplot {
             glBindVertexArray(0); // carefully unbind and rebind
             mplot::gl::Util::checkError (__FILE__, __LINE__);
 
+            this->buffer_vertex_capacity = this->vertexPositions.size() / 3;
+            this->buffer_index_capacity = this->indices.size();
             this->postVertexInitRequired = false;
         }
 
@@ -121,6 +124,8 @@ namespace mplot {
             this->setupVBO (this->vbos[this->posnVBO], this->vertexPositions, visgl::posnLoc);
             this->setupVBO (this->vbos[this->normVBO], this->vertexNormals, visgl::normLoc);
             this->setupVBO (this->vbos[this->colVBO], this->vertexColors, visgl::colLoc);
+            this->buffer_vertex_capacity = this->vertexPositions.size() / 3;
+            this->buffer_index_capacity = this->indices.size();
 
             glBindVertexArray(0);                               // carefully unbind and rebind
             mplot::gl::Util::checkError (__FILE__, __LINE__);   // carefully unbind and rebind
@@ -134,12 +139,181 @@ namespace mplot {
             // Now re-set up the VBOs
             glBindVertexArray (this->vao);  // carefully unbind and rebind
             this->setupVBO (this->vbos[this->colVBO], this->vertexColors, visgl::colLoc);
+            // The colour buffer now fits vertexColors exactly
+            this->buffer_vertex_capacity = std::min (this->buffer_vertex_capacity, this->vertexColors.size() / 3);
             glBindVertexArray(0);  // carefully unbind and rebind
             mplot::gl::Util::checkError (__FILE__, __LINE__);
         }
 
+        //! Re-upload the vertices in vranges of the chosen buffers with BufferSubData
+        void reinit_buffer_ranges (const std::vector<std::array<std::size_t, 2>>& vranges,
+                                   const bool positions, const bool normals, const bool colours) final
+        {
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            // If the buffers have yet to be created, postVertexInit uploads everything
+            if (this->postVertexInitRequired == true || this->vbos == nullptr) {
+                this->postVertexInit();
+                return;
+            }
+            auto upload = [&vranges](GLuint buf, const std::vector<float>& dat)
+            {
+                glBindBuffer (GL_ARRAY_BUFFER, buf);
+                for (const auto& vr : vranges) {
+                    const GLintptr offset = static_cast<GLintptr>(3 * vr[0] * sizeof(float));
+                    const GLsizeiptr sz = static_cast<GLsizeiptr>(3 * (vr[1] - vr[0]) * sizeof(float));
+                    glBufferSubData (GL_ARRAY_BUFFER, offset, sz, dat.data() + 3 * vr[0]);
+                }
+            };
+            if (positions) { upload (this->vbos[this->posnVBO], this->vertexPositions); }
+            if (normals) { upload (this->vbos[this->normVBO], this->vertexNormals); }
+            if (colours) { upload (this->vbos[this->colVBO], this->vertexColors); }
+            glBindBuffer (GL_ARRAY_BUFFER, 0);
+            mplot::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
+        //! Upload the vertices and indices appended since first_vertex and first_index
+        void reinit_appended_buffers (const std::size_t first_vertex, const std::size_t first_index) final
+        {
+            if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+            if (this->postVertexInitRequired == true || this->vbos == nullptr) {
+                this->postVertexInit();
+                return;
+            }
+            const std::size_t nverts = this->vertexPositions.size() / 3;
+            const std::size_t ninds = this->indices.size();
+            glBindVertexArray (this->vao);
+            if (nverts > this->buffer_vertex_capacity || ninds > this->buffer_index_capacity) {
+                // Out of room. Reallocate with room to spare, then upload everything.
+                this->buffer_vertex_capacity = 2 * nverts;
+                this->buffer_index_capacity = 2 * ninds;
+                auto realloc = [](GLenum target, GLuint buf, const void* dat, std::size_t sz, std::size_t cap)
+                {
+                    glBindBuffer (target, buf);
+                    glBufferData (target, static_cast<GLsizeiptr>(cap), nullptr, GL_DYNAMIC_DRAW);
+                    glBufferSubData (target, 0, static_cast<GLsizeiptr>(sz), dat);
+                };
+                const std::size_t vcap = 3 * this->buffer_vertex_capacity * sizeof(float);
+                realloc (GL_ARRAY_BUFFER, this->vbos[this->posnVBO], this->vertexPositions.data(), this->vertexPositions.size() * sizeof(float), vcap);
+                realloc (GL_ARRAY_BUFFER, this->vbos[this->normVBO], this->vertexNormals.data(), this->vertexNormals.size() * sizeof(float), vcap);
+                realloc (GL_ARRAY_BUFFER, this->vbos[this->colVBO], this->vertexColors.data(), this->vertexColors.size() * sizeof(float), vcap);
+                realloc (GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO], this->indices.data(), ninds * sizeof(GLuint),
+                         this->buffer_index_capacity * sizeof(GLuint));
+            } else {
+                // Upload only the new data into the spare capacity
+                auto upload = [](GLenum target, GLuint buf, const void* dat, std::size_t offset, std::size_t sz)
+                {
+                    if (sz == 0) { return; }
+                    glBindBuffer (target, buf);
+                    glBufferSubData (target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(sz), dat);
+                };
+                const std::size_t voff = 3 * first_vertex;
+                const std::size_t vsz = (this->vertexPositions.size() - voff) * sizeof(float);
+                upload (GL_ARRAY_BUFFER, this->vbos[this->posnVBO], this->vertexPositions.data() + voff, voff * sizeof(float), vsz);
+                upload (GL_ARRAY_BUFFER, this->vbos[this->normVBO], this->vertexNormals.data() + voff, voff * sizeof(float), vsz);
+                upload (GL_ARRAY_BUFFER, this->vbos[this->colVBO], this->vertexColors.data() + voff, voff * sizeof(float), vsz);
+                upload (GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO], this->indices.data() + first_index,
+                        first_index * sizeof(GLuint), (ninds - first_index) * sizeof(GLuint));
+            }
+            glBindVertexArray (0);
+            glBindBuffer (GL_ARRAY_BUFFER, 0);
+            mplot::gl::Util::checkError (__FILE__, __LINE__);
+        }
+
         void clearTexts() { this->texts.clear(); }
 
+        void clearPolylines() final
+        {
+            bool context_set = false;
+            for (auto& pl : this->polylines) {
+                if (pl.vao == 0) { continue; }
+                if (!context_set) {
+                    // clear() and reinit() call this before reinit_buffers sets the context
+                    if (this->setContext != nullptr) { this->setContext (this->parentVis); }
+                    context_set = true;
+                }
+                glDeleteBuffers (1, &pl.vbo);
+                glDeleteVertexArrays (1, &pl.vao);
+            }
+            this->polylines.clear();
+        }
+
+        /*!
+         * Upload the points of pl that have been added since it was last uploaded. The buffer
+         * grows as reinit_appended_buffers' buffers do, so that a polyline that is drawn as it is
+         * appended to costs amortised O(1) per point.
+         */
+        void upload_polyline (mplot::visgl::polyline& pl)
+        {
+            const std::size_t n_slots = pl.points.size() / 3;
+            if (pl.vao == 0) {
+                glGenVertexArrays (1, &pl.vao);
+                glGenBuffers (1, &pl.vbo);
+                glBindVertexArray (pl.vao);
+                glBindBuffer (GL_ARRAY_BUFFER, pl.vbo);
+                // Each instance (segment) reads 4 consecutive points, from linePrevLoc to
+                // lineNextLoc, and advances by one point
+                constexpr GLsizei stride = 3 * sizeof(float);
+                for (GLuint l = visgl::linePrevLoc; l <= visgl::lineNextLoc; ++l) {
+                    glVertexAttribPointer (l, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(std::size_t{l} * 3 * sizeof(float)));
+                    glEnableVertexAttribArray (l);
+                    glVertexAttribDivisor (l, 1);
+                }
+                glBindVertexArray (0);
+                pl.buffer_capacity = 0;
+                pl.n_uploaded = 0;
+            }
+            if (pl.n_uploaded == n_slots) { return; }
+            glBindBuffer (GL_ARRAY_BUFFER, pl.vbo);
+            if (n_slots > pl.buffer_capacity) {
+                pl.buffer_capacity = 2 * n_slots;
+                glBufferData (GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(3 * pl.buffer_capacity * sizeof(float)), nullptr, GL_DYNAMIC_DRAW);
+                pl.n_uploaded = 0;
+            }
+            const std::size_t off = 3 * pl.n_uploaded;
+            glBufferSubData (GL_ARRAY_BUFFER, static_cast<GLintptr>(off * sizeof(float)),
+                             static_cast<GLsizeiptr>((pl.points.size() - off) * sizeof(float)), pl.points.data() + off);
+            glBindBuffer (GL_ARRAY_BUFFER, 0);
+            pl.n_uploaded = n_slots;
+        }
+
+        //! Draw the polylines with the line shader program, which makes two triangles per segment
+        void render_polylines()
+        {
+            const GLuint lprog = this->get_lprog (this->parentVis);
+            if (lprog == 0) { return; }
+            glUseProgram (lprog);
+            auto uniform = [lprog](const char* name) { return glGetUniformLocation (lprog, static_cast<const GLchar*>(name)); };
+
+            GLint loc = uniform ("v_matrix");
+            if (loc != -1) { glUniformMatrix4fv (loc, 1, GL_FALSE, this->scenematrix.mat.data()); }
+            loc = uniform ("m_matrix");
+            if (loc != -1) { glUniformMatrix4fv (loc, 1, GL_FALSE, (this->model_scaling * this->viewmatrix).mat.data()); }
+            loc = uniform ("alpha");
+            if (loc != -1) { glUniform1f (loc, this->alpha); }
+
+            const GLint loc_col = uniform ("linecolour");
+            const GLint loc_w = uniform ("linewidth");
+            const GLint loc_z = uniform ("linez");
+            const GLint loc_rnd = uniform ("lineround");
+            const GLint loc_dash = uniform ("dash");
+            const GLint loc_dashgap = uniform ("dashgap");
+            const GLint loc_shorten = uniform ("shorten");
+            for (auto& pl : this->polylines) {
+                if (pl.segments() == 0) { continue; }
+                this->upload_polyline (pl);
+                if (loc_col != -1) { glUniform3fv (loc_col, 1, pl.colour.data()); }
+                if (loc_w != -1) { glUniform1f (loc_w, pl.width); }
+                if (loc_z != -1) { glUniform1f (loc_z, pl.z); }
+                if (loc_rnd != -1) { glUniform1i (loc_rnd, pl.round ? 1 : 0); }
+                if (loc_dash != -1) { glUniform1f (loc_dash, pl.dash); }
+                if (loc_dashgap != -1) { glUniform1f (loc_dashgap, pl.dashgap); }
+                if (loc_shorten != -1) { glUniform1f (loc_shorten, pl.shorten); }
+                glBindVertexArray (pl.vao);
+                glDrawArraysInstanced (GL_TRIANGLES, 0, 6, static_cast<GLsizei>(pl.segments()));
+            }
+            glBindVertexArray (0);
+        }
+
         static constexpr bool debug_render = false;
         //! Render the VisualModel. Note that it is assumed that the OpenGL context has been
         //! obtained by the parent Visual::render call.
@@ -178,13 +352,28 @@ namespace mplot {
                 }
 
                 // Draw the triangles
-                glDrawElements (GL_TRIANGLES, static_cast<unsigned int>(this->indices.size()), GL_UNSIGNED_INT, 0);
+                const std::size_t n_unscrolled = std::min (this->indices.size(), this->scroll_first_index);
+                glDrawElements (GL_TRIANGLES, static_cast<unsigned int>(n_unscrolled), GL_UNSIGNED_INT, 0);
+
+                // Draw any scrolled elements with the scroll offset applied to the model matrix
+                if (n_unscrolled < this->indices.size()) {
+                    sm::mat44<float> scroll_tr;
+                    scroll_tr.translate (this->scroll_offset);
+                    if (loc_m != -1) {
+                        glUniformMatrix4fv (loc_m, 1, GL_FALSE, (this->model_scaling * this->viewmatrix * scroll_tr).mat.data());
+                    }
+                    glDrawElements (GL_TRIANGLES, static_cast<unsigned int>(this->indices.size() - n_unscrolled), GL_UNSIGNED_INT,
+                                    reinterpret_cast<const void*>(n_unscrolled * sizeof(GLuint)));
+                }
 
                 // Unbind the VAO
                 glBindVertexArray(0);
             }
             mplot::gl::Util::checkError (__FILE__, __LINE__);
 
+            // Draw any polylines, which use their own shader program
+            if (!this->polylines.empty() && this->get_lprog) { this->render_polylines(); }
+
             // Now render any VisualTextModels
             auto ti = this->texts.begin();
             while (ti != this->texts.end()) { (*ti)->render(); ti++; }
@@ -80,19 +80,35 @@ namespace mplot {
             this->textModel.reset(nullptr);
             for (auto& t : this->texts) { t.reset(nullptr); }
 
-            if (this->shaders.gprog) {
-                this->glfn->DeleteProgram (this->shaders.gprog);
-                this->shaders.gprog = 0;
-                this->active_gprog = mplot::visgl::graphics_shader_type::none;
+            if (this->gprog_proj2d) {
+                this->glfn->DeleteProgram (this->gprog_proj2d);
+                this->gprog_proj2d = 0;
             }
+            if (this->gprog_cyl) {
+                this->glfn->DeleteProgram (this->gprog_cyl);
+                this->gprog_cyl = 0;
+            }
+            this->shaders.gprog = 0;
+            this->active_gprog = mplot::visgl::graphics_shader_type::none;
+            if (this->text_batch_vao) {
+                this->glfn->DeleteBuffers (4, this->text_batch_vbos.data());
+                this->glfn->DeleteVertexArrays (1, &this->text_batch_vao);
+                this->text_batch_vao = 0;
+            }
+            this->text_batches.clear();
             if (this->shaders.tprog) {
                 this->glfn->DeleteProgram (this->shaders.tprog);
                 this->shaders.tprog = 0;
             }
-            this->free_gladgl_context (this->glfn);
-
-            // Free up the Fonts associated with this mplot::Visual
+            if (this->shaders.lprog) {
+                this->glfn->DeleteProgram (this->shaders.lprog);
+                this->shaders.lprog = 0;
+            }
+            // Free up the Fonts associated with this mplot::Visual. This deletes the atlas textures
+            // with glfn, so do it before glfn is freed.
             mplot::VisualResourcesMX<glver>::i().freetype_deinit (this);
+
+            this->free_gladgl_context (this->glfn);
         }
 
     protected:
@@ -154,11 +170,11 @@ namespace mplot {
                     }
                 }
             }
-            unsigned int error = lodepng::encode (img_filename, rbits.get(), dims[0], dims[1]);
-            if (error) {
-                std::cerr << "encoder error " << error << ": " << lodepng_error_text (error) << std::endl;
+            try {
+                mplot::savepng (img_filename, rbits.get(), dims[0], dims[1], this->png_options);
+            } catch (const std::exception& e) {
+                std::cerr << "encoder error: " << e.what() << std::endl;
                 dims.set_from (-1);
-                return dims;
             }
             return dims;
         }
@@ -170,14 +186,15 @@ namespace mplot {
 
             if (this->ptype == perspective_type::orthographic || this->ptype == perspective_type::perspective) {
                 if (this->active_gprog != mplot::visgl::graphics_shader_type::projection2d) {
-                    if (this->shaders.gprog) { this->glfn->DeleteProgram (this->shaders.gprog); }
-                    this->shaders.gprog = mplot::gl::LoadShadersMX (this->proj2d_shader_progs, this->glfn);
+                    if (!this->gprog_proj2d) { this->gprog_proj2d = mplot::gl::LoadShadersMXCached (this->proj2d_shader_progs, this->glfn, this->shader_cache_dir); }
+                    this->shaders.gprog = this->gprog_proj2d;
                     this->active_gprog = mplot::visgl::graphics_shader_type::projection2d;
                 }
             } else if (this->ptype == perspective_type::cylindrical) {
                 if (this->active_gprog != mplot::visgl::graphics_shader_type::cylindrical) {
-                    if (this->shaders.gprog) { this->glfn->DeleteProgram (this->shaders.gprog); }
-                    this->shaders.gprog = mplot::gl::LoadShadersMX (this->cyl_shader_progs, this->glfn);
+                    // The cylindrical program is linked on first use, then kept
+                    if (!this->gprog_cyl) { this->gprog_cyl = mplot::gl::LoadShadersMXCached (this->cyl_shader_progs, this->glfn, this->shader_cache_dir); }
+                    this->shaders.gprog = this->gprog_cyl;
                     this->active_gprog = mplot::visgl::graphics_shader_type::cylindrical;
                 }
             }
@@ -238,6 +255,13 @@ namespace mplot {
             GLint loc_p = this->glfn->GetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("p_matrix"));
             if (loc_p != -1) { this->glfn->UniformMatrix4fv (loc_p, 1, GL_FALSE, this->projection.mat.data()); }
 
+            // And the line shader program, if any model has drawn polylines
+            if (this->shaders.lprog) {
+                this->glfn->UseProgram (this->shaders.lprog);
+                loc_p = this->glfn->GetUniformLocation (this->shaders.lprog, static_cast<const GLchar*>("p_matrix"));
+                if (loc_p != -1) { this->glfn->UniformMatrix4fv (loc_p, 1, GL_FALSE, this->projection.mat.data()); }
+            }
+
             // Switch back to the regular shader prog and render the VisualModels.
             this->glfn->UseProgram (this->shaders.gprog);
 
@@ -290,6 +314,8 @@ namespace mplot {
                 ++ti;
             }
 
+            this->render_text_batches();
+
             if (this->options.test (visual_options::renderSwapsBuffers) == true) {
                 this->swapBuffers();
             }
@@ -337,6 +363,7 @@ namespace mplot {
             model->get_shaderprogs = &mplot::VisualBase<glver>::get_shaderprogs;
             model->get_gprog = &mplot::VisualBase<glver>::get_gprog;
             model->get_tprog = &mplot::VisualBase<glver>::get_tprog;
+            if constexpr (requires { model->get_lprog; }) { model->get_lprog = &mplot::VisualBase<glver>::get_lprog; }
             model->get_glfn = &mplot::VisualOwnableMX<glver>::get_glfn;
         }
 
@@ -391,6 +418,69 @@ namespace mplot {
         }
 
     protected:
+        //! Draw the text collected in text_batches, one draw call per glyph atlas and alpha, then empty the batches
+        void render_text_batches()
+        {
+            bool have_text = false;
+            for (auto& b : this->text_batches) { have_text = have_text || !b.indices.empty(); }
+            if (!have_text) { return; }
+
+            if (this->text_batch_vao == 0) {
+                this->glfn->GenVertexArrays (1, &this->text_batch_vao);
+                this->glfn->GenBuffers (4, this->text_batch_vbos.data());
+            }
+
+            // Vertex positions have already been transformed into eye space, and the colour of each
+            // vertex is the text colour, so the model/view matrices are identity and textColor white.
+            this->glfn->UseProgram (this->shaders.tprog);
+            const sm::mat44<float> identity;
+            GLint loc_v = this->glfn->GetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { this->glfn->UniformMatrix4fv (loc_v, 1, GL_FALSE, identity.mat.data()); }
+            GLint loc_m = this->glfn->GetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { this->glfn->UniformMatrix4fv (loc_m, 1, GL_FALSE, identity.mat.data()); }
+            GLint loc_tc = this->glfn->GetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("textColor"));
+            if (loc_tc != -1) { this->glfn->Uniform3f (loc_tc, 1.0f, 1.0f, 1.0f); }
+            GLint loc_sdf = this->glfn->GetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("sdf"));
+            GLint loc_a = this->glfn->GetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("alpha"));
+
+            this->glfn->ActiveTexture (GL_TEXTURE0);
+            this->glfn->BindVertexArray (this->text_batch_vao);
+
+            auto upload = [this](const GLuint buf, const std::vector<float>& dat, const GLuint attrib)
+            {
+                this->glfn->BindBuffer (GL_ARRAY_BUFFER, buf);
+                this->glfn->BufferData (GL_ARRAY_BUFFER, dat.size() * sizeof(float), dat.data(), GL_DYNAMIC_DRAW);
+                this->glfn->VertexAttribPointer (attrib, 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+                this->glfn->EnableVertexAttribArray (attrib);
+            };
+
+            for (auto& b : this->text_batches) {
+                if (b.indices.empty()) { continue; }
+                upload (this->text_batch_vbos[0], b.positions, visgl::posnLoc);
+                upload (this->text_batch_vbos[1], b.colours, visgl::colLoc);
+                upload (this->text_batch_vbos[2], b.uvs, visgl::textureLoc);
+                this->glfn->BindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->text_batch_vbos[3]);
+                this->glfn->BufferData (GL_ELEMENT_ARRAY_BUFFER, b.indices.size() * sizeof(unsigned int), b.indices.data(), GL_DYNAMIC_DRAW);
+                if (loc_sdf != -1) { this->glfn->Uniform1i (loc_sdf, b.sdf ? 1 : 0); }
+                if (loc_a != -1) { this->glfn->Uniform1f (loc_a, b.alpha); }
+                this->glfn->BindTexture (GL_TEXTURE_2D, b.texture);
+                this->glfn->DrawElements (GL_TRIANGLES, static_cast<GLsizei>(b.indices.size()), GL_UNSIGNED_INT, 0);
+                b.clear();
+            }
+
+            this->glfn->BindVertexArray (0);
+            this->glfn->UseProgram (this->shaders.gprog);
+        }
+
+        void load_line_program() final
+        {
+            this->shaders.lprog = mplot::gl::LoadShadersMXCached (this->line_shader_progs, this->glfn, this->shader_cache_dir);
+            if (!this->shaders.lprog) { return; }
+            this->glfn->UseProgram (this->shaders.lprog);
+            GLint loc_p = this->glfn->GetUniformLocation (this->shaders.lprog, static_cast<const GLchar*>("p_matrix"));
+            if (loc_p != -1) { this->glfn->UniformMatrix4fv (loc_p, 1, GL_FALSE, this->projection.mat.data()); }
+        }
+
         // Initialize OpenGL shaders, set some flags (Alpha, Anti-aliasing), read in any external
         // state from json, and set up the coordinate arrows and any VisualTextModels that will be
         // required to render the Visual.
@@ -412,10 +502,11 @@ namespace mplot {
                 {GL_VERTEX_SHADER, "Visual.vert.glsl", mplot::getDefaultVtxShader(glver), 0 },
                 {GL_FRAGMENT_SHADER, "Visual.frag.glsl", mplot::getDefaultFragShader(glver), 0 }
             };
-            this->shaders.gprog = mplot::gl::LoadShadersMX (this->proj2d_shader_progs, this->glfn);
+            this->gprog_proj2d = mplot::gl::LoadShadersMXCached (this->proj2d_shader_progs, this->glfn, this->shader_cache_dir);
+            this->shaders.gprog = this->gprog_proj2d;
             this->active_gprog = mplot::visgl::graphics_shader_type::projection2d;
 
-            // Alternative cylindrical shader for possible later use. (NB: not loaded immediately)
+            // Alternative cylindrical shader for possible later use. (NB: not linked until first used)
             this->cyl_shader_progs = {
                 {GL_VERTEX_SHADER, "VisCyl.vert.glsl", mplot::getDefaultCylVtxShader(glver), 0 },
                 {GL_FRAGMENT_SHADER, "Visual.frag.glsl", mplot::getDefaultFragShader(glver), 0 }
@@ -426,7 +517,14 @@ namespace mplot {
                 {GL_VERTEX_SHADER, "VisText.vert.glsl", mplot::getDefaultTextVtxShader(glver), 0 },
                 {GL_FRAGMENT_SHADER, "VisText.frag.glsl" , mplot::getDefaultTextFragShader(glver), 0 }
             };
-            this->shaders.tprog = mplot::gl::LoadShadersMX (this->text_shader_progs, this->glfn);
+            this->shaders.tprog = mplot::gl::LoadShadersMXCached (this->text_shader_progs, this->glfn, this->shader_cache_dir);
+
+            // The line shader expands the segments of VisualModels' polylines into quads. It is
+            // only linked if a VisualModel draws polylines (see load_line_program).
+            this->line_shader_progs = {
+                {GL_VERTEX_SHADER, "VisLine.vert.glsl", mplot::getDefaultLineVtxShader(glver), 0 },
+                {GL_FRAGMENT_SHADER, "VisLine.frag.glsl", mplot::getDefaultLineFragShader(glver), 0 }
+            };
 
             // OpenGL options
             this->glfn->Enable (GL_DEPTH_TEST);
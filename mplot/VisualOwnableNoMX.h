@@ -79,15 +79,30 @@ namespace mplot {
             this->textModel.reset(nullptr);
             for (auto& t : this->texts) { t.reset(nullptr); }
 
-            if (this->shaders.gprog) {
-                glDeleteProgram (this->shaders.gprog);
-                this->shaders.gprog = 0;
-                this->active_gprog = mplot::visgl::graphics_shader_type::none;
+            if (this->gprog_proj2d) {
+                glDeleteProgram (this->gprog_proj2d);
+                this->gprog_proj2d = 0;
             }
+            if (this->gprog_cyl) {
+                glDeleteProgram (this->gprog_cyl);
+                this->gprog_cyl = 0;
+            }
+            this->shaders.gprog = 0;
+            this->active_gprog = mplot::visgl::graphics_shader_type::none;
+            if (this->text_batch_vao) {
+                glDeleteBuffers (4, this->text_batch_vbos.data());
+                glDeleteVertexArrays (1, &this->text_batch_vao);
+                this->text_batch_vao = 0;
+            }
+            this->text_batches.clear();
             if (this->shaders.tprog) {
                 glDeleteProgram (this->shaders.tprog);
                 this->shaders.tprog = 0;
             }
+            if (this->shaders.lprog) {
+                glDeleteProgram (this->shaders.lprog);
+                this->shaders.lprog = 0;
+            }
             // Free up the Fonts associated with this mplot::Visual
             mplot::VisualResourcesNoMX<glver>::i().freetype_deinit (this);
         }
@@ -148,11 +163,11 @@ namespace mplot {
                     }
                 }
             }
-            unsigned int error = lodepng::encode (img_filename, rbits.get(), dims[0], dims[1]);
-            if (error) {
-                std::cerr << "encoder error " << error << ": " << lodepng_error_text (error) << std::endl;
+            try {
+                mplot::savepng (img_filename, rbits.get(), dims[0], dims[1], this->png_options);
+            } catch (const std::exception& e) {
+                std::cerr << "encoder error: " << e.what() << std::endl;
                 dims.set_from (-1);
-                return dims;
             }
             return dims;
         }
@@ -164,14 +179,15 @@ namespace mplot {
 
             if (this->ptype == perspective_type::orthographic || this->ptype == perspective_type::perspective) {
                 if (this->active_gprog != mplot::visgl::graphics_shader_type::projection2d) {
-                    if (this->shaders.gprog) { glDeleteProgram (this->shaders.gprog); }
-                    this->shaders.gprog = mplot::gl::LoadShaders (this->proj2d_shader_progs);
+                    if (!this->gprog_proj2d) { this->gprog_proj2d = mplot::gl::LoadShadersCached (this->proj2d_shader_progs, this->shader_cache_dir); }
+                    this->shaders.gprog = this->gprog_proj2d;
                     this->active_gprog = mplot::visgl::graphics_shader_type::projection2d;
                 }
             } else if (this->ptype == perspective_type::cylindrical) {
                 if (this->active_gprog != mplot::visgl::graphics_shader_type::cylindrical) {
-                    if (this->shaders.gprog) { glDeleteProgram (this->shaders.gprog); }
-                    this->shaders.gprog = mplot::gl::LoadShaders (this->cyl_shader_progs);
+                    // The cylindrical program is linked on first use, then kept
+                    if (!this->gprog_cyl) { this->gprog_cyl = mplot::gl::LoadShadersCached (this->cyl_shader_progs, this->shader_cache_dir); }
+                    this->shaders.gprog = this->gprog_cyl;
                     this->active_gprog = mplot::visgl::graphics_shader_type::cylindrical;
                 }
             }
@@ -232,6 +248,13 @@ namespace mplot {
             GLint loc_p = glGetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("p_matrix"));
             if (loc_p != -1) { glUniformMatrix4fv (loc_p, 1, GL_FALSE, this->projection.mat.data()); }
 
+            // And the line shader program, if any model has drawn polylines
+            if (this->shaders.lprog) {
+                glUseProgram (this->shaders.lprog);
+                loc_p = glGetUniformLocation (this->shaders.lprog, static_cast<const GLchar*>("p_matrix"));
+                if (loc_p != -1) { glUniformMatrix4fv (loc_p, 1, GL_FALSE, this->projection.mat.data()); }
+            }
+
             // Switch back to the regular shader prog and render the VisualModels.
             glUseProgram (this->shaders.gprog);
 
@@ -284,6 +307,8 @@ namespace mplot {
                 ++ti;
             }
 
+            this->render_text_batches();
+
             if (this->options.test (visual_options::renderSwapsBuffers) == true) {
                 this->swapBuffers();
             }
@@ -351,6 +376,69 @@ namespace mplot {
         }
 
     protected:
+        //! Draw the text collected in text_batches, one draw call per glyph atlas and alpha, then empty the batches
+        void render_text_batches()
+        {
+            bool have_text = false;
+            for (auto& b : this->text_batches) { have_text = have_text || !b.indices.empty(); }
+            if (!have_text) { return; }
+
+            if (this->text_batch_vao == 0) {
+                glGenVertexArrays (1, &this->text_batch_vao);
+                glGenBuffers (4, this->text_batch_vbos.data());
+            }
+
+            // Vertex positions have already been transformed into eye space, and the colour of each
+            // vertex is the text colour, so the model/view matrices are identity and textColor white.
+            glUseProgram (this->shaders.tprog);
+            const sm::mat44<float> identity;
+            GLint loc_v = glGetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("v_matrix"));
+            if (loc_v != -1) { glUniformMatrix4fv (loc_v, 1, GL_FALSE, identity.mat.data()); }
+            GLint loc_m = glGetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("m_matrix"));
+            if (loc_m != -1) { glUniformMatrix4fv (loc_m, 1, GL_FALSE, identity.mat.data()); }
+            GLint loc_tc = glGetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("textColor"));
+            if (loc_tc != -1) { glUniform3f (loc_tc, 1.0f, 1.0f, 1.0f); }
+            GLint loc_sdf = glGetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("sdf"));
+            GLint loc_a = glGetUniformLocation (this->shaders.tprog, static_cast<const GLchar*>("alpha"));
+
+            glActiveTexture (GL_TEXTURE0);
+            glBindVertexArray (this->text_batch_vao);
+
+            auto upload = [](const GLuint buf, const std::vector<float>& dat, const GLuint attrib)
+            {
+                glBindBuffer (GL_ARRAY_BUFFER, buf);
+                glBufferData (GL_ARRAY_BUFFER, dat.size() * sizeof(float), dat.data(), GL_DYNAMIC_DRAW);
+                glVertexAttribPointer (attrib, 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
+                glEnableVertexAttribArray (attrib);
+            };
+
+            for (auto& b : this->text_batches) {
+                if (b.indices.empty()) { continue; }
+                upload (this->text_batch_vbos[0], b.positions, visgl::posnLoc);
+                upload (this->text_batch_vbos[1], b.colours, visgl::colLoc);
+                upload (this->text_batch_vbos[2], b.uvs, visgl::textureLoc);
+                glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, this->text_batch_vbos[3]);
+                glBufferData (GL_ELEMENT_ARRAY_BUFFER, b.indices.size() * sizeof(unsigned int), b.indices.data(), GL_DYNAMIC_DRAW);
+                if (loc_sdf != -1) { glUniform1i (loc_sdf, b.sdf ? 1 : 0); }
+                if (loc_a != -1) { glUniform1f (loc_a, b.alpha); }
+                glBindTexture (GL_TEXTURE_2D, b.texture);
+                glDrawElements (GL_TRIANGLES, static_cast<GLsizei>(b.indices.size()), GL_UNSIGNED_INT, 0);
+                b.clear();
+            }
+
+            glBindVertexArray (0);
+            glUseProgram (this->shaders.gprog);
+        }
+
+        void load_line_program() final
+        {
+            this->shaders.lprog = mplot::gl::LoadShadersCached (this->line_shader_progs, this->shader_cache_dir);
+            if (!this->shaders.lprog) { return; }
+            glUseProgram (this->shaders.lprog);
+            GLint loc_p = glGetUniformLocation (this->shaders.lprog, static_cast<const GLchar*>("p_matrix"));
+            if (loc_p != -1) { glUniformMatrix4fv (loc_p, 1, GL_FALSE, this->projection.mat.data()); }
+        }
+
         // Initialize OpenGL shaders, set some flags (Alpha, Anti-aliasing), read in any external
         // state from json, and set up the coordinate arrows and any VisualTextModels that will be
         // required to render the Visual.
@@ -372,10 +460,11 @@ namespace mplot {
                 {GL_VERTEX_SHADER, "Visual.vert.glsl", mplot::getDefaultVtxShader(glver), 0 },
                 {GL_FRAGMENT_SHADER, "Visual.frag.glsl", mplot::getDefaultFragShader(glver), 0 }
             };
-            this->shaders.gprog = mplot::gl::LoadShaders (this->proj2d_shader_progs);
+            this->gprog_proj2d = mplot::gl::LoadShadersCached (this->proj2d_shader_progs, this->shader_cache_dir);
+            this->shaders.gprog = this->gprog_proj2d;
             this->active_gprog = mplot::visgl::graphics_shader_type::projection2d;
 
-            // Alternative cylindrical shader for possible later use. (NB: not loaded immediately)
+            // Alternative cylindrical shader for possible later use. (NB: not linked until first used)
             this->cyl_shader_progs = {
                 {GL_VERTEX_SHADER, "VisCyl.vert.glsl", mplot::getDefaultCylVtxShader(glver), 0 },
                 {GL_FRAGMENT_SHADER, "Visual.frag.glsl", mplot::getDefaultFragShader(glver), 0 }
@@ -386,7 +475,14 @@ namespace mplot {
                 {GL_VERTEX_SHADER, "VisText.vert.glsl", mplot::getDefaultTextVtxShader(glver), 0 },
                 {GL_FRAGMENT_SHADER, "VisText.frag.glsl" , mplot::getDefaultTextFragShader(glver), 0 }
             };
-            this->shaders.tprog = mplot::gl::LoadShaders (this->text_shader_progs);
+            this->shaders.tprog = mplot::gl::LoadShadersCached (this->text_shader_progs, this->shader_cache_dir);
+
+            // The line shader expands the segments of VisualModels' polylines into quads. It is
+            // only linked if a VisualModel draws polylines (see load_line_program).
+            this->line_shader_progs = {
+                {GL_VERTEX_SHADER, "VisLine.vert.glsl", mplot::getDefaultLineVtxShader(glver), 0 },
+                {GL_FRAGMENT_SHADER, "VisLine.frag.glsl", mplot::getDefaultLineFragShader(glver), 0 }
+            };
 
             // OpenGL options
             glEnable (GL_DEPTH_TEST);
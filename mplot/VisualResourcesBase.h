@@ -13,6 +13,7 @@
 #include <iostream>
 #include <tuple>
 #include <set>
+#include <map>
 #include <stdexcept>
 #include <memory>
 #include <mplot/gl/version.h>
@@ -42,9 +43,21 @@ namespace mplot {
             for (auto& ft : this->freetypes) { FT_Done_FreeType (ft.second); }
         }
 
-        //! FreeType library object
+        //! FreeType library objects, keyed by resource_key()
         std::map<mplot::VisualBase<glver>*, FT_Library> freetypes;
 
+        //! The Visuals that use the shared FT_Library and faces (see VisualBase::share_gl_resources)
+        std::set<mplot::VisualBase<glver>*> sharing;
+
+        //! The key for a Visual's FT_Library and faces. All sharing Visuals use the key nullptr.
+        static mplot::VisualBase<glver>* resource_key (mplot::VisualBase<glver>* _vis)
+        {
+            return _vis->shares_resources ? nullptr : _vis;
+        }
+
+        //! Called when a sharing Visual is deinitialized, after it has been removed from sharing
+        virtual void shared_visual_leaving (mplot::VisualBase<glver>*) {}
+
     public:
         VisualResourcesBase(const VisualResourcesBase<glver>&) = delete;
         VisualResourcesBase& operator=(const VisualResourcesBase<glver> &) = delete;
@@ -61,17 +74,25 @@ namespace mplot {
         //! deinitialized.
         void freetype_deinit (mplot::VisualBase<glver>* _vis)
         {
+            if (_vis->shares_resources) {
+                this->sharing.erase (_vis);
+                this->shared_visual_leaving (_vis);
+                // The shared resources live until the last sharing Visual goes
+                if (!this->sharing.empty()) { return; }
+            }
+            mplot::VisualBase<glver>* key = resource_key (_vis);
             // First clear the faces associated with VisualBase<>* _vis
-            this->clearVisualFaces (_vis);
+            this->clearVisualFaces (key);
             // Second, clean up the FreeType library instance and erase from this->freetypes
-            auto freetype = this->freetypes.find (_vis);
+            auto freetype = this->freetypes.find (key);
             if (freetype != this->freetypes.end()) {
                 FT_Done_FreeType (freetype->second);
                 this->freetypes.erase (freetype);
             }
         }
 
-        // Note: get/clearVisualFace functions are in derived classes
+        // Note: get/clearVisualFace functions are in derived classes. clearVisualFaces is passed a
+        // resource_key().
         virtual void clearVisualFaces (mplot::VisualBase<glver>* _vis) = 0;
     };
 
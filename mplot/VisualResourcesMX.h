@@ -29,9 +29,9 @@ namespace mplot {
         ~VisualResourcesMX() { this->faces.clear(); }
 
         //! The collection of VisualFaces generated for this instance of the
-        //! application. Create one VisualFace for each unique combination of VisualFont
-        //! and fontpixels (the texture resolution)
-        std::map<std::tuple<mplot::VisualFont, unsigned int, mplot::VisualBase<glver>*>,
+        //! application. Create one VisualFace for each unique combination of VisualFont,
+        //! fontpixels (the texture resolution) and glyph type (bitmap or signed distance field)
+        std::map<std::tuple<mplot::VisualFont, unsigned int, bool, mplot::VisualBase<glver>*>,
                  std::unique_ptr<mplot::visgl::VisualFaceMX>> faces;
     public:
         VisualResourcesMX(const VisualResourcesMX<glver>&) = delete;
@@ -47,19 +47,26 @@ namespace mplot {
         //! assumption that I'd only need one FT_Library.
         void freetype_init (mplot::VisualBase<glver>* _vis, GladGLContext* glfn = nullptr)
         {
+            // Use of gl calls here may make it neat to set up GL here in VisualResources? This is
+            // per-context state, so it is set for every Visual, shared or not.
+            glfn->PixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
+            mplot::gl::Util::checkError (__FILE__, __LINE__, glfn);
+
+            if (_vis->shares_resources) {
+                this->sharing.insert (_vis);
+                this->shared_glfns[_vis] = glfn;
+            }
+            mplot::VisualBase<glver>* rkey = this->resource_key (_vis);
+
             FT_Library freetype = nullptr;
             try {
-                freetype = this->freetypes.at (_vis);
+                freetype = this->freetypes.at (rkey);
             } catch (const std::out_of_range&) {
-                // Use of gl calls here may make it neat to set up GL here in VisualResources?
-                glfn->PixelStorei(GL_UNPACK_ALIGNMENT, 1); // disable byte-alignment restriction
-                mplot::gl::Util::checkError (__FILE__, __LINE__, glfn);
-
                 if (FT_Init_FreeType (&freetype)) {
                     std::cout << "ERROR::FREETYPE: Could not init FreeType Library" << std::endl;
                 } else {
                     // Successfully initialized freetype
-                    this->freetypes[_vis] = freetype;
+                    this->freetypes[rkey] = freetype;
                 }
             }
         }
@@ -76,28 +83,47 @@ namespace mplot {
         void create() final {}
 
         //! Return a pointer to a VisualFace for the given \a font at the given texture
-        //! resolution, \a fontpixels and the given window (i.e. OpenGL context) \a _win.
+        //! resolution, \a fontpixels and the given window (i.e. OpenGL context) \a _win. Sharing
+        //! Visuals all get the same face.
         mplot::visgl::VisualFaceMX* getVisualFace (mplot::VisualFont font, unsigned int fontpixels,
-                                                   mplot::VisualBase<glver>* _vis, GladGLContext* glfn)
+                                                   mplot::VisualBase<glver>* _vis, GladGLContext* glfn,
+                                                   const bool sdf = false)
         {
             mplot::visgl::VisualFaceMX* rtn = nullptr;
-            auto key = std::make_tuple(font, fontpixels, _vis);
+            mplot::VisualBase<glver>* rkey = this->resource_key (_vis);
+            auto key = std::make_tuple(font, fontpixels, sdf, rkey);
             try {
                 rtn = this->faces.at(key).get();
             } catch (const std::out_of_range&) {
-                this->faces[key] = std::make_unique<mplot::visgl::VisualFaceMX> (font, fontpixels, this->freetypes.at(_vis), glfn);
+                this->faces[key] = std::make_unique<mplot::visgl::VisualFaceMX> (font, fontpixels, this->freetypes.at(rkey), glfn, sdf);
                 rtn = this->faces.at(key).get();
             }
             return rtn;
         }
 
+        //! Get the face for tf. All signed distance field text in a font shares one face.
         mplot::visgl::VisualFaceMX* getVisualFace (const mplot::TextFeatures& tf,
                                                    mplot::VisualBase<glver>* _vis, GladGLContext* glfn)
         {
-            return this->getVisualFace (tf.font, tf.fontres, _vis, glfn);
+            return this->getVisualFace (tf.font, tf.texture_res(), _vis, glfn, tf.sdf);
+        }
+
+        //! The GL function contexts of the sharing Visuals
+        std::map<mplot::VisualBase<glver>*, GladGLContext*> shared_glfns;
+
+        //! Move the shared faces onto the GL function context of a remaining sharing Visual
+        void shared_visual_leaving (mplot::VisualBase<glver>* _vis) final
+        {
+            this->shared_glfns.erase (_vis);
+            if (this->shared_glfns.empty()) { return; }
+            GladGLContext* remaining = this->shared_glfns.begin()->second;
+            for (auto& f : this->faces) {
+                if (std::get<mplot::VisualBase<glver>*>(f.first) == nullptr) { f.second->set_glfn (remaining); }
+            }
         }
 
-        //! Loop through this->faces clearing out those associated with the given mplot::Visual
+        //! Loop through this->faces clearing out those associated with the given resource key
+        //! (an mplot::Visual, or nullptr for the shared faces)
         void clearVisualFaces (mplot::VisualBase<glver>* _vis) final
         {
             auto f = this->faces.begin();
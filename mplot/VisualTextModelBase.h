@@ -16,6 +16,7 @@
 #include <map>
 #include <limits>
 #include <memory>
+#include <algorithm>
 
 #include <mplot/gl/version.h>
 
@@ -45,7 +46,7 @@ namespace mplot {
         VisualTextModelBase (mplot::TextFeatures _tfeatures)
         {
             this->tfeatures = _tfeatures;
-            this->fontscale = tfeatures.fontsize / static_cast<float>(tfeatures.fontres);
+            this->fontscale = tfeatures.fontsize / static_cast<float>(tfeatures.texture_res());
         }
 
         virtual ~VisualTextModelBase() {}
@@ -172,61 +173,114 @@ namespace mplot {
         static constexpr bool debug_textquads = false;
 
         //! Initialize the vertices that will represent the Quads.
-        void initializeVertices() {
-
-            unsigned int nquads = static_cast<unsigned int>(this->quads.size());
-
-            for (unsigned int qi = 0; qi < nquads; ++qi) {
-
-                std::array<float, 12> quad = this->quads[qi];
-
+        void initializeVertices()
+        {
+            const std::size_t nquads = this->quads.size();
+            this->resize_vertices (nquads);
+            for (std::size_t qi = 0; qi < nquads; ++qi) {
                 if constexpr (debug_textquads == true) {
+                    const std::array<float, 12>& quad = this->quads[qi];
                     std::cout << "Quad box from (" << quad[0] << "," << quad[1] << "," << quad[2]
                               << ") to (" << quad[3] << "," << quad[4] << "," << quad[5]
                               << ") to (" << quad[6] << "," << quad[7] << "," << quad[8]
                               << ") to (" << quad[9] << "," << quad[10] << "," << quad[11] << ")" << std::endl;
                 }
+                this->write_quad (qi);
+            }
+        }
 
-                this->vertex_push (quad[0], quad[1],  quad[2],  this->vertexPositions); //1
-                this->vertex_push (quad[3], quad[4],  quad[5],  this->vertexPositions); //2
-                this->vertex_push (quad[6], quad[7],  quad[8],  this->vertexPositions); //3
-                this->vertex_push (quad[9], quad[10], quad[11], this->vertexPositions); //4
-
-                // Add the info for drawing the textures on the quads
-                this->vertex_push (0.0f, 1.0f, 0.0f, this->vertexTextures);
-                this->vertex_push (0.0f, 0.0f, 0.0f, this->vertexTextures);
-                this->vertex_push (1.0f, 0.0f, 0.0f, this->vertexTextures);
-                this->vertex_push (1.0f, 1.0f, 0.0f, this->vertexTextures);
-
-                // All same colours
-                this->vertex_push (this->clr_backing, this->vertexColors);
-                this->vertex_push (this->clr_backing, this->vertexColors);
-                this->vertex_push (this->clr_backing, this->vertexColors);
-                this->vertex_push (this->clr_backing, this->vertexColors);
-
-                // All same normals
-                this->vertex_push (0.0f, 0.0f, 1.0f, this->vertexNormals);
-                this->vertex_push (0.0f, 0.0f, 1.0f, this->vertexNormals);
-                this->vertex_push (0.0f, 0.0f, 1.0f, this->vertexNormals);
-                this->vertex_push (0.0f, 0.0f, 1.0f, this->vertexNormals);
-
-                // Two triangles per quad
-                // qi * 4 + 1, 2 3 or 4
-                GLuint ib = (GLuint)qi*4;
-                this->indices.push_back (ib++); // 0
-                this->indices.push_back (ib++); // 1
-                this->indices.push_back (ib);   // 2
-
-                this->indices.push_back (ib++); // 2
-                this->indices.push_back (ib);   // 3
-                ib -= 3;
-                this->indices.push_back (ib);   // 0
+        /*!
+         * Resize the vertex vectors to hold nquads quads. The colours, normals and indices of any
+         * new quads are filled in (they are the same for every text); their positions and texture
+         * coordinates are zero until write_quad() is called.
+         */
+        void resize_vertices (const std::size_t nquads)
+        {
+            const std::size_t nquads_old = this->indices.size() / 6;
+            this->vertexPositions.resize (nquads * 12, 0.0f);
+            this->vertexTextures.resize (nquads * 12, 0.0f);
+            this->vertexColors.resize (nquads * 12, 0.0f);
+            this->vertexNormals.resize (nquads * 12, 0.0f);
+            this->indices.resize (nquads * 6, 0u);
+            for (std::size_t qi = nquads_old; qi < nquads; ++qi) {
+                for (std::size_t v = 0; v < 4; ++v) {
+                    // All same colours
+                    std::copy (this->clr_backing.begin(), this->clr_backing.end(), this->vertexColors.begin() + qi * 12 + v * 3);
+                    // All same normals
+                    this->vertexNormals[qi * 12 + v * 3 + 2] = 1.0f;
+                }
+                // Two triangles per quad: vertices 0, 1, 2 and 2, 3, 0
+                const GLuint ib = static_cast<GLuint>(qi * 4);
+                GLuint* idx = this->indices.data() + qi * 6;
+                idx[0] = ib;
+                idx[1] = ib + 1;
+                idx[2] = ib + 2;
+                idx[3] = ib + 2;
+                idx[4] = ib + 3;
+                idx[5] = ib;
             }
         }
 
+        //! Write the positions and atlas texture coordinates of quad qi into the vertex vectors
+        void write_quad (const std::size_t qi)
+        {
+            // The order of the vertices is bottom left, top left, top right, bottom right
+            std::copy (this->quads[qi].begin(), this->quads[qi].end(), this->vertexPositions.begin() + qi * 12);
+            // The glyph's corners in the face's atlas, in texels
+            const std::array<float, 4>& uv = this->quad_uvs[qi];
+            const std::array<float, 12> tex = { uv[0], uv[3], 0.0f,
+                                                uv[0], uv[1], 0.0f,
+                                                uv[2], uv[1], 0.0f,
+                                                uv[2], uv[3], 0.0f };
+            std::copy (tex.begin(), tex.end(), this->vertexTextures.begin() + qi * 12);
+        }
+
         //! Common code to call after the vertices have been set up.
         virtual void postVertexInit() = 0;
 
+        /*!
+         * Append this text's quads to the batch b, transforming their vertices by the text's scene
+         * and view matrices and giving them the text colour.
+         */
+        void append_to_batch (mplot::visgl::text_batch& b) const
+        {
+            const sm::mat44<float> mv = this->scenematrix * this->viewmatrix;
+            const unsigned int base = static_cast<unsigned int>(b.positions.size() / 3);
+            const std::size_t nverts = this->vertexPositions.size() / 3;
+            for (std::size_t i = 0; i < nverts; ++i) {
+                const float* vp = this->vertexPositions.data() + 3 * i;
+                sm::vec<float, 4> p = mv * sm::vec<float, 4>{ vp[0], vp[1], vp[2], 1.0f };
+                b.positions.insert (b.positions.end(), { p[0], p[1], p[2] });
+                b.colours.insert (b.colours.end(), this->clr_text.begin(), this->clr_text.end());
+                b.uvs.insert (b.uvs.end(), this->vertexTextures.begin() + 3 * i, this->vertexTextures.begin() + 3 * i + 3);
+            }
+            for (auto idx : this->indices) { b.indices.push_back (base + idx); }
+        }
+
+        /*!
+         * If the parent Visual batches text, add this text's quads to the Visual's batch for the
+         * given atlas and this text's alpha and return true. The text is then drawn by the Visual at the end of its
+         * render() rather than here. (parentVis is accessed directly, rather than via a callback;
+         * VisualBase is complete by the time this is instantiated.)
+         */
+        bool submit_to_batch (const unsigned int atlas_texture, const bool sdf)
+        {
+            if (this->parentVis == nullptr || this->parentVis->batch_text == false) { return false; }
+            auto& batches = this->parentVis->text_batches;
+            const float a = this->alpha;
+            auto bi = std::find_if (batches.begin(), batches.end(),
+                                    [atlas_texture, a](const mplot::visgl::text_batch& b) { return b.texture == atlas_texture && b.alpha == a; });
+            if (bi == batches.end()) {
+                batches.emplace_back();
+                bi = batches.end() - 1;
+                bi->texture = atlas_texture;
+                bi->sdf = sdf;
+                bi->alpha = a;
+            }
+            this->append_to_batch (*bi);
+            return true;
+        }
+
     public:
         //! The colour of the text
         std::array<float, 3> clr_text = {0.0f, 0.0f, 0.0f};
@@ -235,6 +289,15 @@ namespace mplot {
         //! Parent Visual
         mplot::VisualBase<glver>* parentVis = nullptr;
 
+        /*!
+         * The number of glyphs to reserve space for in the GL buffers. A text that changes often
+         * (a frame counter, say) should reserve enough glyphs for its longest string and be changed
+         * with updateText(). Then only the glyphs that differ are uploaded and the buffers are
+         * never reallocated. A change takes effect the next time the buffers are allocated, which
+         * updateText() does if the text is too long for them.
+         */
+        std::size_t reserved_glyphs = 0;
+
         /*!
          * Callbacks are analogous to those in VisualModel
          */
@@ -262,11 +325,12 @@ namespace mplot {
 
         // face is in derived class
 
-        //! The colour of the backing quad's vertices. Doesn't have any effect.
-        std::array<float, 3> clr_backing = {1.0f, 1.0f, 0.0f};
+        //! The colour of the backing quad's vertices. The shader multiplies this by clr_text, so
+        //! leave it white.
+        std::array<float, 3> clr_backing = {1.0f, 1.0f, 1.0f};
 
         //! A scaling factor based on the desired width of an 'm'
-        float fontscale = 1.0f; //  fontscale = tfeatures.fontsize/(float)tfeatures.fontres;
+        float fontscale = 1.0f; //  fontscale = tfeatures.fontsize/(float)tfeatures.texture_res();
 
         //! model-view offset within the scene. Any model-view offset of the parent
         //! object should be incorporated into this offset. That is, if this
@@ -302,8 +366,8 @@ namespace mplot {
         //! VisualTextModel. setupText should modify these as it sets up quads. Order of
         //! numbers is left, right, bottom, top
         sm::vec<float, 4> extents = { 1e7, -1e7, 1e7, -1e7 };
-        //! The texture ID for each quad - so that we draw the right texture image over each quad.
-        std::vector<unsigned int> quad_ids = {};
+        //! The atlas texture coordinates (left, top, right, bottom, in texels) for each quad
+        std::vector<std::array<float, 4>> quad_uvs = {};
         //! Position within vertex buffer object (if I use an array of VBO)
         enum VBOPos { posnVBO, normVBO, colVBO, idxVBO, textureVBO, numVBO };
         //! The OpenGL Vertex Array Object
@@ -312,6 +376,9 @@ namespace mplot {
         GLuint vbo = 0;
         //! Vertex Buffer Objects stored in an array
         std::unique_ptr<GLuint[]> vbos;
+        //! The number of quads that the GL buffers have room for (the larger of the number of
+        //! quads and reserved_glyphs when they were last allocated)
+        std::size_t buffer_quads = 0;
         //! CPU-side data for indices
         std::vector<GLuint> indices = {};
         //! CPU-side data for quad vertex positions
@@ -327,6 +394,9 @@ namespace mplot {
         //! If true, then calls to VisualModel::render should return
         bool hide = false;
 
+        //! Texts that reserve glyphs are expected to be rewritten with updateText()
+        GLenum buffer_usage() const { return this->reserved_glyphs > 0 ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW; }
+
         //! Set up a vertex buffer object - bind, buffer and set vertex array object attribute
         virtual void setupVBO (GLuint& buf, std::vector<float>& dat, unsigned int bufferAttribPosition) = 0;
 
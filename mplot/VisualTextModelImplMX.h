@@ -52,6 +52,10 @@ namespace mplot {
         {
             if (this->hide == true) { return; }
 
+            // With batching, the parent Visual draws this text along with all the others that
+            // share its glyph atlas
+            if (this->face != nullptr && this->submit_to_batch (this->face->atlas_texture, this->face->sdf)) { return; }
+
             GLint prev_shader;
             GLuint tshaderprog = this->get_tprog (this->parentVis);
 
@@ -71,22 +75,18 @@ namespace mplot {
             if (loc_v != -1) { _glfn->UniformMatrix4fv (loc_v, 1, GL_FALSE, this->scenematrix.mat.data()); }
             GLint loc_m = _glfn->GetUniformLocation (tshaderprog, static_cast<const GLchar*>("m_matrix"));
             if (loc_m != -1) { _glfn->UniformMatrix4fv (loc_m, 1, GL_FALSE, this->viewmatrix.mat.data()); }
+            GLint loc_sdf = _glfn->GetUniformLocation (tshaderprog, static_cast<const GLchar*>("sdf"));
+            if (loc_sdf != -1) { _glfn->Uniform1i (loc_sdf, (this->face != nullptr && this->face->sdf) ? 1 : 0); }
 
             _glfn->ActiveTexture (GL_TEXTURE0);
 
             // It is only necessary to bind the vertex array object before rendering
             _glfn->BindVertexArray (this->vao);
 
-            // We have a max of (2^32)-1 characters. Should be enough.
-            for (unsigned int i = 0U; i < this->quads.size(); ++i) {
-                // Bind the right texture for the quad.
-                _glfn->BindTexture (GL_TEXTURE_2D, this->quad_ids[i]);
-                // This is 'draw a subset of the elements from the vertex array
-                // object'. You say how many indices to draw and which base *vertex* you
-                // start from. In my scheme, I have 4 vertices for each two triangles
-                // that are constructed. Thus, I draw 6 indices, but increment the base
-                // vertex by 4 for each letter.
-                _glfn->DrawElementsBaseVertex (GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, 4*i);
+            // All the glyphs are in the face's atlas, so the whole text is drawn in one call
+            if (this->face != nullptr && !this->indices.empty()) {
+                _glfn->BindTexture (GL_TEXTURE_2D, this->face->atlas_texture);
+                _glfn->DrawElements (GL_TRIANGLES, static_cast<GLsizei>(this->indices.size()), GL_UNSIGNED_INT, 0);
             }
 
             _glfn->BindVertexArray(0);
@@ -109,7 +109,7 @@ namespace mplot {
             // First convert string from ASCII/UTF-8 into Unicode.
             std::basic_string<char32_t> utxt = mplot::unicode::fromUtf8(_txt);
             for (std::basic_string<char32_t>::const_iterator c = utxt.begin(); c != utxt.end(); c++) {
-                mplot::visgl::CharInfo ci = this->face->glchars[*c];
+                mplot::visgl::CharInfo ci = this->face->glyph (*c);
                 float drop = (ci.size.y() - ci.bearing.y()) * this->fontscale;
                 geom.max_drop = (drop > geom.max_drop) ? drop : geom.max_drop;
                 float bearingy = ci.bearing.y() * this->fontscale;
@@ -131,7 +131,7 @@ namespace mplot {
             }
 
             for (std::basic_string<char32_t>::const_iterator c = this->txt.begin(); c != this->txt.end(); c++) {
-                mplot::visgl::CharInfo ci = this->face->glchars[*c];
+                mplot::visgl::CharInfo ci = this->face->glyph (*c);
                 float drop = (ci.size.y() - ci.bearing.y()) * this->fontscale;
                 geom.max_drop = (drop > geom.max_drop) ? drop : geom.max_drop;
                 float bearingy = ci.bearing.y() * this->fontscale;
@@ -184,9 +184,110 @@ namespace mplot {
             }
 
             this->txt = _txt;
-            // With glyph information from txt, set up this->quads.
-            this->quads.clear();
-            this->quad_ids.clear();
+            this->layout();
+
+            // Ensure we've cleared out vertex info
+            this->vertexPositions.clear();
+            this->vertexNormals.clear();
+            this->vertexColors.clear();
+            this->vertexTextures.clear();
+            this->indices.clear();
+
+            this->initializeVertices();
+
+            this->postVertexInit();
+        }
+
+        //! Change the text, rewriting only the glyphs that differ (see reserved_glyphs)
+        void updateText (const std::string& _txt)
+        {
+            this->updateText (mplot::unicode::fromUtf8 (_txt));
+        }
+
+        /*!
+         * Change the text in place. If the new text fits in the GL buffers (see reserved_glyphs),
+         * then only the quads that changed are rewritten and uploaded with BufferSubData and no
+         * buffers are reallocated. Otherwise this falls back to setupText(). Unlike setupText(),
+         * the extents are those of the new text alone.
+         */
+        void updateText (const std::basic_string<char32_t>& _txt)
+        {
+            if (this->face == nullptr || this->vbos == nullptr) {
+                this->setupText (_txt);
+                return;
+            }
+
+            std::vector<std::array<float, 12>> prev_quads;
+            std::vector<std::array<float, 4>> prev_uvs;
+            prev_quads.swap (this->quads);
+            prev_uvs.swap (this->quad_uvs);
+
+            this->txt = _txt;
+            this->extents = { 1e7, -1e7, 1e7, -1e7 };
+            this->layout();
+
+            const std::size_t nquads = this->quads.size();
+            if (nquads > this->buffer_quads) {
+                // Too long for the buffers; reallocate
+                this->vertexPositions.clear();
+                this->vertexNormals.clear();
+                this->vertexColors.clear();
+                this->vertexTextures.clear();
+                this->indices.clear();
+                this->initializeVertices();
+                this->postVertexInit();
+                return;
+            }
+
+            // Find the range of quads that changed
+            std::size_t first = nquads;
+            std::size_t last = 0;
+            for (std::size_t qi = 0; qi < nquads; ++qi) {
+                if (qi >= prev_quads.size() || this->quads[qi] != prev_quads[qi] || this->quad_uvs[qi] != prev_uvs[qi]) {
+                    first = std::min (first, qi);
+                    last = qi + 1;
+                }
+            }
+
+            // The buffers already hold colours, normals and indices for buffer_quads quads, so
+            // only positions and texture coordinates need rewriting
+            this->resize_vertices (nquads);
+            if (first >= last) { return; }
+            for (std::size_t qi = first; qi < last; ++qi) { this->write_quad (qi); }
+
+            auto _glfn = this->get_glfn (this->parentVis);
+            const GLintptr offset = static_cast<GLintptr>(first * 12 * sizeof(float));
+            const GLsizeiptr sz = static_cast<GLsizeiptr>((last - first) * 12 * sizeof(float));
+            _glfn->BindBuffer (GL_ARRAY_BUFFER, this->vbos[this->posnVBO]);
+            _glfn->BufferSubData (GL_ARRAY_BUFFER, offset, sz, this->vertexPositions.data() + first * 12);
+            _glfn->BindBuffer (GL_ARRAY_BUFFER, this->vbos[this->textureVBO]);
+            _glfn->BufferSubData (GL_ARRAY_BUFFER, offset, sz, this->vertexTextures.data() + first * 12);
+            _glfn->BindBuffer (GL_ARRAY_BUFFER, 0);
+        }
+
+    protected:
+        /*!
+         * Lay out this->txt, setting this->quads and this->quad_uvs and widening this->extents. The
+         * layout is looked up in the face's cache first, so identical labels are laid out once.
+         */
+        void layout()
+        {
+            const mplot::text_layout_cache::key k = { this->txt, this->fontscale, this->line_spacing };
+            const mplot::text_layout* tl = this->face->layouts.find (k);
+            if (tl == nullptr) { tl = &this->face->layouts.insert (k, this->layout_glyphs()); }
+
+            this->quads = tl->quads;
+            this->quad_uvs = tl->quad_uvs;
+            this->extents[0] = std::min (this->extents[0], tl->extents[0]);
+            this->extents[1] = std::max (this->extents[1], tl->extents[1]);
+            this->extents[2] = std::min (this->extents[2], tl->extents[2]);
+            this->extents[3] = std::max (this->extents[3], tl->extents[3]);
+        }
+
+        //! Lay out this->txt glyph by glyph
+        mplot::text_layout layout_glyphs()
+        {
+            mplot::text_layout tl;
             // Our string of letters starts at this location
             float letter_pos = 0.0f;
             float letter_y = 0.0f;
@@ -196,13 +297,13 @@ namespace mplot {
                 if (*c == '\n') {
                     // Skip newline, but add a y offset and reset letter_pos
                     letter_pos = 0.0f;
-                    mplot::visgl::CharInfo ch = this->face->glchars['h'];
+                    mplot::visgl::CharInfo ch = this->face->glyph ('h');
                     letter_y += this->line_spacing * -ch.size.y() * this->fontscale;
                     continue;
                 }
 
-                // Add a quad to this->quads
-                mplot::visgl::CharInfo ci = this->face->glchars[*c];
+                // Add a quad to tl.quads
+                mplot::visgl::CharInfo ci = this->face->glyph (*c);
 
                 float xpos = letter_pos + ci.bearing.x() * this->fontscale;
                 float ypos = letter_y /*this->mv_offset[1]*/ - (ci.size.y() - ci.bearing.y()) * this->fontscale;
@@ -210,10 +311,10 @@ namespace mplot {
                 float h = ci.size.y() * this->fontscale;
 
                 // Update extents
-                if (xpos < this->extents[0]) { this->extents[0] = xpos; } // left
-                if (xpos+w > this->extents[1]) { this->extents[1] = xpos+w; } // right
-                if (ypos < this->extents[2]) { this->extents[2] = ypos; } // bottom
-                if (ypos+h > this->extents[3]) { this->extents[3] = ypos+h; } // top
+                if (xpos < tl.extents[0]) { tl.extents[0] = xpos; } // left
+                if (xpos+w > tl.extents[1]) { tl.extents[1] = xpos+w; } // right
+                if (ypos < tl.extents[2]) { tl.extents[2] = ypos; } // bottom
+                if (ypos+h > tl.extents[3]) { tl.extents[3] = ypos+h; } // top
 
                 // What's the order of the vertices for the quads? It is:
                 // Bottom left, Top left, top right, bottom right.
@@ -229,30 +330,21 @@ namespace mplot {
                               << ") to (" << tbox[6] << "," << tbox[7] << "," << tbox[8]
                               << ") to (" << tbox[9] << "," << tbox[10] << "," << tbox[11]
                               << "). w="<<w<<", h="<<h<<"\n";
-                    std::cout << "Texture ID for that character is: " << ci.textureID << std::endl;
+                    std::cout << "Atlas position for that character is: " << ci.atlas_pos << std::endl;
                 }
-                this->quads.push_back (tbox);
-                this->quad_ids.push_back (ci.textureID);
+                tl.quads.push_back (tbox);
+                tl.quad_uvs.push_back ({ static_cast<float>(ci.atlas_pos.x()),
+                                            static_cast<float>(ci.atlas_pos.y()),
+                                            static_cast<float>(ci.atlas_pos.x() + ci.size.x()),
+                                            static_cast<float>(ci.atlas_pos.y() + ci.size.y()) });
 
                 // The value in ci.advance has to be divided by 64 to bring it into the
                 // same units as the ci.size and ci.bearing values.
                 letter_pos += ((ci.advance>>6)*this->fontscale);
             }
-
-            // Ensure we've cleared out vertex info
-            this->vertexPositions.clear();
-            this->vertexNormals.clear();
-            this->vertexColors.clear();
-            this->vertexTextures.clear();
-            this->indices.clear();
-
-            this->initializeVertices();
-
-            this->postVertexInit();
+            return tl;
         }
 
-    protected:
-
         //! Common code to call after the vertices have been set up.
         void postVertexInit() final
         {
@@ -270,12 +362,18 @@ namespace mplot {
                 _glfn->GenBuffers (this->numVBO, this->vbos.get()); // OpenGL 4.4- safe
             }
 
+            // Make room in the buffers for reserved_glyphs quads, so that updateText() can rewrite
+            // them in place. The spare quads are uploaded with zero size and are not drawn.
+            const std::size_t nquads = this->indices.size() / 6;
+            this->buffer_quads = std::max (nquads, this->reserved_glyphs);
+            this->resize_vertices (this->buffer_quads);
+
             // Set up the indices buffer - bind and buffer the data in this->indices
             _glfn->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->vbos[this->idxVBO]);
 
             //std::cout << "indices.size(): " << this->indices.size() << std::endl;
             std::size_t sz = this->indices.size() * sizeof(GLuint);
-            _glfn->BufferData(GL_ELEMENT_ARRAY_BUFFER, sz, this->indices.data(), GL_STATIC_DRAW);
+            _glfn->BufferData(GL_ELEMENT_ARRAY_BUFFER, sz, this->indices.data(), this->buffer_usage());
 
             // Binds data from the "C++ world" to the OpenGL shader world for
             // "position", "normalin" and "color"
@@ -285,6 +383,8 @@ namespace mplot {
             this->setupVBO (this->vbos[this->colVBO], this->vertexColors, visgl::colLoc);
             this->setupVBO (this->vbos[this->textureVBO], this->vertexTextures, visgl::textureLoc);
 
+            this->resize_vertices (nquads);
+
             // Possibly release (unbind) the vertex buffers, but have to unbind vertex
             // array object first.
             _glfn->BindVertexArray(0); // carefully unbind
@@ -304,7 +404,7 @@ namespace mplot {
             std::size_t sz = dat.size() * sizeof(float);
             auto _glfn = this->get_glfn (this->parentVis);
             _glfn->BindBuffer (GL_ARRAY_BUFFER, buf);
-            _glfn->BufferData (GL_ARRAY_BUFFER, sz, dat.data(), GL_STATIC_DRAW);
+            _glfn->BufferData (GL_ARRAY_BUFFER, sz, dat.data(), this->buffer_usage());
             _glfn->VertexAttribPointer (bufferAttribPosition, 3, GL_FLOAT, GL_FALSE, 0, (void*)(0));
             _glfn->EnableVertexAttribArray (bufferAttribPosition);
         }
@@ -240,7 +240,7 @@ namespace mplot {
                         t0 = rqinv * site->p;
                         t1 = rqinv * e->pos[0];
                         t2 = rqinv * e->pos[1];
-                        this->computeTriangle (t0, t1, t2, this->setColour(site->index));
+                        this->computeTriangle (t0, t1, t2, this->colourAt (site->index));
                         ++site_triangles;
                         e = e->next;
                     }
@@ -255,7 +255,7 @@ namespace mplot {
                     const jcv_graphedge* e = site->edges;
                     unsigned int site_triangles = 0;
                     while (e) {
-                        this->computeTriangle (site->p, e->pos[0], e->pos[1], this->setColour(site->index));
+                        this->computeTriangle (site->p, e->pos[0], e->pos[1], this->colourAt (site->index));
                         ++site_triangles;
                         e = e->next;
                     }
@@ -345,6 +345,56 @@ namespace mplot {
             jcv_diagram_free (&diagram);
         }
 
+        //! Increment whenever the vertices made by initializeVertices() change
+        static constexpr uint32_t vertex_generator_version = 1u;
+
+        //! The Voronoi surface depends on the coordinates, the data and all the display options
+        uint64_t vertex_cache_key() override
+        {
+            if (this->dataCoords == nullptr || (this->scalarData == nullptr && this->vectorData == nullptr)) { return 0u; }
+            mplot::vertexcache::hasher hh;
+            hh.add_generator ("VoronoiVisual", vertex_generator_version);
+            hh.add (sizeof (F));
+            hh.add (n_epsilons);
+            hh.add (*this->dataCoords);
+            if (this->scalarData != nullptr) { hh.add (*this->scalarData); }
+            if (this->vectorData != nullptr) { hh.add (*this->vectorData); }
+            hh.add_scale (this->zScale);
+            hh.add_scale (this->colourScale);
+            hh.add_scale (this->colourScale2);
+            hh.add_scale (this->colourScale3);
+            hh.add_colourmap (this->cm);
+            hh.add (this->zoom);
+            hh.add (this->debug_edges);
+            hh.add (this->show_voronoi2d);
+            hh.add (this->voronoi_grid_thickness);
+            hh.add (this->debug_dataCoords);
+            hh.add (this->dataCoord_sphere_size);
+            hh.add (this->data_z_direction);
+            hh.add (this->border_width);
+            return hh.value();
+        }
+
+        //! reinitColours() needs the per-cell triangle counts
+        void vertex_cache_save_extra (std::ostream& os) override
+        {
+            this->vertex_cache_write (os, this->triangle_counts);
+            this->vertex_cache_write (os, this->site_indices);
+            os.write (reinterpret_cast<const char*>(&this->triangle_count_sum), sizeof (this->triangle_count_sum));
+        }
+
+        bool vertex_cache_load_extra (std::istream& is) override
+        {
+            if (!this->vertex_cache_read (is, this->triangle_counts)
+                || !this->vertex_cache_read (is, this->site_indices)) { return false; }
+            is.read (reinterpret_cast<char*>(&this->triangle_count_sum), sizeof (this->triangle_count_sum));
+            if (!is) { return false; }
+            // Size and fill dcopy/dcolour, as initializeVertices() would have done
+            this->determine_datasize();
+            this->setupScaling();
+            return true;
+        }
+
         void reinitColoursScalar()
         {
             if (this->colourScale.do_autoscale == true) { this->colourScale.reset(); }
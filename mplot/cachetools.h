@@ -0,0 +1,119 @@
+/*!
+ * \file
+ *
+ * Helpers for mplot's on-disk caches (the vertex cache of vertexcache.h and the GL program cache
+ * of gl/program_cache.h): a content hash for cache keys, safe writing of cache files and the
+ * removal of the least recently used files.
+ *
+ * \author Seb James
+ * \date October 2026
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <type_traits>
+#include <random>
+#include <filesystem>
+#include <algorithm>
+#include <system_error>
+
+namespace mplot::cachetools {
+
+    //! A 64 bit FNV-1a hash, for the keys of cache files
+    struct hasher
+    {
+        uint64_t h = 0xcbf29ce484222325ull;
+
+        void add_bytes (const void* p, std::size_t n)
+        {
+            const unsigned char* b = static_cast<const unsigned char*>(p);
+            for (std::size_t i = 0; i < n; ++i) {
+                this->h ^= b[i];
+                this->h *= 0x100000001b3ull;
+            }
+        }
+
+        //! Add a value of trivially copyable type (a number, a std::array, an sm::vec...)
+        template <typename T> requires std::is_trivially_copyable_v<T>
+        void add (const T& v) { this->add_bytes (&v, sizeof (T)); }
+
+        //! Add the size and content of a vector (or sm::vvec)
+        template <typename T> requires std::is_trivially_copyable_v<T>
+        void add (const std::vector<T>& v)
+        {
+            this->add (v.size());
+            this->add_bytes (v.data(), v.size() * sizeof (T));
+        }
+
+        void add (const std::string& s)
+        {
+            this->add (s.size());
+            this->add_bytes (s.data(), s.size());
+        }
+
+        //! The hash. Never 0, which is reserved to mean 'do not cache'.
+        uint64_t value() const { return this->h == 0u ? 1u : this->h; }
+    };
+
+    /*!
+     * A temporary file name alongside the cache file fp. Cache files are written to a temporary
+     * file and then renamed into place. The random suffix stops two processes that write the same
+     * entry at once from writing into the same temporary file.
+     */
+    inline std::filesystem::path tmp_path (const std::filesystem::path& fp)
+    {
+        std::random_device rd;
+        std::stringstream ss;
+        ss << ".tmp" << std::hex << rd() << rd();
+        std::filesystem::path tmp = fp;
+        tmp += ss.str();
+        return tmp;
+    }
+
+    /*!
+     * Mark the cache file fp as just used, by setting its modification time to now. prune()
+     * removes the files that were least recently used.
+     */
+    inline void touch (const std::filesystem::path& fp)
+    {
+        std::error_code ec;
+        std::filesystem::last_write_time (fp, std::filesystem::file_time_type::clock::now(), ec);
+    }
+
+    /*!
+     * Remove the least recently used files in dir whose names begin with prefix until the rest
+     * total no more than max_bytes. Errors are ignored, as another process may be pruning the
+     * same directory.
+     */
+    inline void prune (const std::filesystem::path& dir, const std::string& prefix, const std::uintmax_t max_bytes)
+    {
+        struct entry
+        {
+            std::filesystem::file_time_type t;
+            std::uintmax_t bytes;
+            std::filesystem::path p;
+        };
+        std::vector<entry> entries;
+        std::uintmax_t total = 0;
+        std::error_code ec;
+        for (auto it = std::filesystem::directory_iterator (dir, ec); !ec && it != std::filesystem::directory_iterator(); it.increment (ec)) {
+            const std::string name = it->path().filename().string();
+            if (name.rfind (prefix, 0) != 0 || !it->is_regular_file (ec)) { continue; }
+            entry e = { it->last_write_time (ec), it->file_size (ec), it->path() };
+            if (ec) { ec.clear(); continue; }
+            total += e.bytes;
+            entries.push_back (e);
+        }
+        if (total <= max_bytes) { return; }
+        std::sort (entries.begin(), entries.end(), [](const entry& a, const entry& b) { return a.t < b.t; });
+        for (const entry& e : entries) {
+            if (total <= max_bytes) { break; }
+            if (std::filesystem::remove (e.p, ec)) { total -= e.bytes; }
+        }
+    }
+
+} // namespace mplot::cachetools
@@ -0,0 +1,287 @@
+/*
+ * This file contains functions in the mplot::decimate namespace that choose a few of the points
+ * of a large dataset to stand for the rest when it is drawn. GraphVisual uses them so that the
+ * number of vertices in a graph is bounded by the graph's resolution, not by the size of the data.
+ *
+ * Each function takes a container of 2D points (anything with p[0] (x) and p[1] (y), such as
+ * sm::vec<float>) and returns the indices of the points to keep, in ascending order. For datasets
+ * that are decimated again and again (as a graph is zoomed, panned or appended to), a
+ * minmax_pyramid gives the same M4 decimation in time that grows only with log of the size.
+ *
+ * Seb James
+ * October 2026
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+namespace mplot::decimate {
+
+    //! Which of ncols columns across [x0, x1) x lies in: -1 left of x0 and ncols right of x1
+    struct column_of
+    {
+        column_of (const double _x0, const double x1, const std::size_t _ncols)
+            : x0 (_x0), cols_per_x (static_cast<double>(_ncols) / (x1 - _x0)), ncols (_ncols) {}
+
+        std::ptrdiff_t operator() (const double x) const
+        {
+            const double c = std::floor ((x - this->x0) * this->cols_per_x);
+            return static_cast<std::ptrdiff_t>(std::clamp (c, -1.0, static_cast<double>(this->ncols)));
+        }
+
+        double x0 = 0.0;
+        double cols_per_x = 1.0;
+        std::size_t ncols = 1;
+    };
+
+    //! Append the indices first, lo, hi and last (a column's M4 points) to keep, in order, without repeats
+    static void keep_m4 (std::vector<std::size_t>& keep, const std::size_t first, const std::size_t lo,
+                         const std::size_t hi, const std::size_t last)
+    {
+        std::size_t four[4] = { first, lo, hi, last };
+        std::sort (four, four + 4);
+        for (std::size_t j = 0; j < 4; ++j) {
+            if (keep.empty() || keep.back() != four[j]) { keep.push_back (four[j]); }
+        }
+    }
+
+    /*!
+     * M4 decimation for drawing a line through pts, which must be sorted by x. The range [x0, x1)
+     * is divided into ncols columns (think of them as the columns of pixels that the graph will
+     * cover). In each column, the first, last, lowest and highest points are kept. A line drawn
+     * through the kept points covers the same pixels as a line through all of the points, so
+     * the decimation can't be seen at (or below) a resolution of ncols columns. Points left of x0
+     * or right of x1 are decimated as if they were in one column each.
+     *
+     * At most 4 * (ncols + 2) indices are returned.
+     */
+    template <typename C>
+    static std::vector<std::size_t> m4 (const C& pts, const double x0, const double x1, const std::size_t ncols)
+    {
+        std::vector<std::size_t> keep;
+        const std::size_t n = pts.size();
+        if (n == 0 || ncols == 0 || !(x1 > x0)) { return keep; }
+
+        const column_of column (x0, x1, ncols);
+        std::size_t first = 0;
+        std::size_t lo = 0;
+        std::size_t hi = 0;
+        std::ptrdiff_t col = column (static_cast<double>(pts[0][0]));
+        for (std::size_t i = 1; i < n; ++i) {
+            const std::ptrdiff_t c = column (static_cast<double>(pts[i][0]));
+            if (c != col) {
+                keep_m4 (keep, first, lo, hi, i - 1);
+                first = i;
+                lo = i;
+                hi = i;
+                col = c;
+            } else {
+                if (pts[i][1] < pts[lo][1]) { lo = i; }
+                if (pts[i][1] > pts[hi][1]) { hi = i; }
+            }
+        }
+        keep_m4 (keep, first, lo, hi, n - 1);
+        return keep;
+    }
+
+    /*!
+     * Largest-Triangle-Three-Buckets decimation of pts (sorted by x) to n_out points, for drawing
+     * markers. The first and last points are kept. The others are divided into n_out - 2 buckets
+     * and from each bucket the point that makes the largest triangle with the point kept from
+     * the previous bucket and the mean of the next bucket is kept. This keeps the points that
+     * give the data its shape (peaks, troughs and turns). If pts has no more than n_out points,
+     * all are kept. n_out is at least 3.
+     */
+    template <typename C>
+    static std::vector<std::size_t> lttb (const C& pts, const std::size_t _n_out)
+    {
+        const std::size_t n = pts.size();
+        const std::size_t n_out = std::max (_n_out, std::size_t{3});
+        std::vector<std::size_t> keep;
+        if (n <= n_out) {
+            keep.resize (n);
+            for (std::size_t i = 0; i < n; ++i) { keep[i] = i; }
+            return keep;
+        }
+
+        keep.reserve (n_out);
+        keep.push_back (0);
+        const double bucket = static_cast<double>(n - 2) / static_cast<double>(n_out - 2);
+        std::size_t a = 0; // The point kept from the previous bucket
+        for (std::size_t b = 0; b < n_out - 2; ++b) {
+            // This bucket is [b0, b1) (never empty, as bucket > 1); the next is [b1, b2), or just
+            // the last point
+            const std::size_t b0 = 1 + static_cast<std::size_t>(std::floor (static_cast<double>(b) * bucket));
+            const std::size_t b1 = std::min (1 + static_cast<std::size_t>(std::floor (static_cast<double>(b + 1) * bucket)), n - 1);
+            const std::size_t b2 = std::min (1 + static_cast<std::size_t>(std::floor (static_cast<double>(b + 2) * bucket)), n - 1);
+
+            double mx = 0.0;
+            double my = 0.0;
+            if (b2 > b1) {
+                for (std::size_t i = b1; i < b2; ++i) {
+                    mx += static_cast<double>(pts[i][0]);
+                    my += static_cast<double>(pts[i][1]);
+                }
+                mx /= static_cast<double>(b2 - b1);
+                my /= static_cast<double>(b2 - b1);
+            } else {
+                mx = static_cast<double>(pts[n - 1][0]);
+                my = static_cast<double>(pts[n - 1][1]);
+            }
+
+            const double ax = static_cast<double>(pts[a][0]);
+            const double ay = static_cast<double>(pts[a][1]);
+            double max_area = -1.0;
+            std::size_t chosen = b0;
+            for (std::size_t i = b0; i < b1; ++i) {
+                // Twice the area of the triangle (a, i, mean of next bucket)
+                const double area = std::abs ((ax - mx) * (static_cast<double>(pts[i][1]) - ay)
+                                              - (ax - static_cast<double>(pts[i][0])) * (my - ay));
+                if (area > max_area) {
+                    max_area = area;
+                    chosen = i;
+                }
+            }
+            keep.push_back (chosen);
+            a = chosen;
+        }
+        keep.push_back (n - 1);
+        return keep;
+    }
+
+    /*!
+     * A pyramid of the positions of the minimum and maximum y in blocks of a dataset's points,
+     * for the M4 decimation of large datasets (of 10^8 points, say) in O(ncols log n) time,
+     * rather than O(n). Level 0 of the pyramid holds the extremes of each block of leaf points,
+     * level 1 those of each block of 2 * leaf points, and so on. The extremes of any range of
+     * points are found from O(log n) blocks (plus up to 2 * leaf single points at the ends).
+     *
+     * The pyramid holds indices, not values, so it is given the points whenever it is used, and
+     * they must not have changed since the pyramid was made (extend() takes account of points
+     * that have been appended). Because a linear scaling of x or y moves no point past
+     * another, the pyramid stays valid if the points are rescaled, as when the axes of a graph
+     * are changed.
+     */
+    class minmax_pyramid
+    {
+    public:
+        //! The number of points in a level 0 block
+        static constexpr std::size_t leaf = 16;
+
+        //! Make the pyramid for pts
+        template <typename C>
+        void assign (const C& pts)
+        {
+            this->clear();
+            this->extend (pts);
+        }
+
+        //! Add the points that have been appended to pts since the pyramid was last made or extended
+        template <typename C>
+        void extend (const C& pts)
+        {
+            const std::size_t n_new = pts.size();
+            for (std::size_t i = std::max (this->n, std::size_t{1}); i < n_new; ++i) {
+                if (pts[i][0] < pts[i - 1][0]) { this->sorted = false; }
+            }
+            if (this->levels.empty()) { this->levels.resize (1); }
+            for (std::size_t b = this->levels[0].size(); (b + 1) * leaf <= n_new; ++b) {
+                // A new leaf block
+                std::array<std::size_t, 2> mm = { b * leaf, b * leaf };
+                for (std::size_t i = b * leaf + 1; i < (b + 1) * leaf; ++i) { merge (pts, mm, { i, i }); }
+                this->levels[0].push_back (mm);
+                // Complete any blocks above it
+                for (std::size_t l = 0; this->levels[l].size() % 2 == 0; ++l) {
+                    if (this->levels.size() == l + 1) { this->levels.emplace_back(); }
+                    std::array<std::size_t, 2> up = this->levels[l][this->levels[l].size() - 2];
+                    merge (pts, up, this->levels[l].back());
+                    this->levels[l + 1].push_back (up);
+                }
+            }
+            this->n = n_new;
+        }
+
+        void clear()
+        {
+            this->levels.clear();
+            this->n = 0;
+            this->sorted = true;
+        }
+
+        //! The number of points that the pyramid covers
+        std::size_t size() const { return this->n; }
+        //! True if the points' x values never decrease, which M4 decimation requires
+        bool sorted_x() const { return this->sorted; }
+
+        //! The indices of the lowest and the highest of the points from a to b - 1 (the first of
+        //! each, if there are ties)
+        template <typename C>
+        std::array<std::size_t, 2> minmax (const C& pts, std::size_t a, const std::size_t b) const
+        {
+            std::array<std::size_t, 2> mm = { a, a };
+            while (a < b) {
+                if (a % leaf != 0 || a + leaf > b) {
+                    merge (pts, mm, { a, a });
+                    ++a;
+                    continue;
+                }
+                // The biggest block that starts at a and ends by b
+                std::size_t l = 0;
+                std::size_t blk = leaf;
+                while (l + 1 < this->levels.size() && a % (2 * blk) == 0 && a + 2 * blk <= b
+                       && a / (2 * blk) < this->levels[l + 1].size()) {
+                    ++l;
+                    blk *= 2;
+                }
+                merge (pts, mm, this->levels[l][a / blk]);
+                a += blk;
+            }
+            return mm;
+        }
+
+        //! The same as mplot::decimate::m4 (pts, x0, x1, ncols), but found in O(ncols log n) time
+        template <typename C>
+        std::vector<std::size_t> m4 (const C& pts, const double x0, const double x1, const std::size_t ncols) const
+        {
+            std::vector<std::size_t> keep;
+            if (this->n == 0 || ncols == 0 || !(x1 > x0)) { return keep; }
+            const column_of column (x0, x1, ncols);
+            std::size_t i = 0;
+            while (i < this->n) {
+                // The column's points are from i to j - 1. Find j by bisection.
+                const std::ptrdiff_t c = column (static_cast<double>(pts[i][0]));
+                std::size_t lo = i + 1;
+                std::size_t hi = this->n;
+                while (lo < hi) {
+                    const std::size_t mid = lo + (hi - lo) / 2;
+                    if (column (static_cast<double>(pts[mid][0])) == c) { lo = mid + 1; } else { hi = mid; }
+                }
+                const std::size_t j = lo;
+                const std::array<std::size_t, 2> mm = this->minmax (pts, i, j);
+                keep_m4 (keep, i, mm[0], mm[1], j - 1);
+                i = j;
+            }
+            return keep;
+        }
+
+    private:
+        //! Update the extremes mm with those of another block, b. Ties go to mm, the earlier block.
+        template <typename C>
+        static void merge (const C& pts, std::array<std::size_t, 2>& mm, const std::array<std::size_t, 2>& b)
+        {
+            if (pts[b[0]][1] < pts[mm[0]][1]) { mm[0] = b[0]; }
+            if (pts[b[1]][1] > pts[mm[1]][1]) { mm[1] = b[1]; }
+        }
+
+        //! levels[l][k] holds the indices of the lowest and highest points in block k of level l
+        std::vector<std::vector<std::array<std::size_t, 2>>> levels;
+        std::size_t n = 0;
+        bool sorted = true;
+    };
+
+} // namespace mplot::decimate
@@ -5,19 +5,27 @@
 #pragma once
 
 #include <mplot/gl/shaders.h>
+#include <mplot/gl/program_cache.h>
 
 #include <mplot/tools.h>
 #include <vector>
 #include <iostream>
 #include <cstring>
 #include <memory>
+#include <string>
+#include <cstdint>
+#include <filesystem>
 
 namespace mplot {
 
     namespace gl {
 
-        //! Shader loading code.
-        GLuint LoadShadersMX (const std::vector<mplot::gl::ShaderInfo>& shader_info, GladGLContext* glfn)
+        /*!
+         * Shader loading code. If retrievable is true, the program is hinted as one whose binary
+         * will be retrieved with glGetProgramBinary (see LoadShadersMXCached).
+         */
+        GLuint LoadShadersMX (const std::vector<mplot::gl::ShaderInfo>& shader_info, GladGLContext* glfn,
+                              [[maybe_unused]] const bool retrievable = false)
         {
             if (shader_info.empty()) { return 0; }
 
@@ -102,6 +110,9 @@ namespace mplot {
             }
 
             GLint linked = 0;
+#ifdef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+            if (retrievable) { glfn->ProgramParameteri (program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE); }
+#endif
             glfn->LinkProgram (program);
             glfn->GetProgramiv (program, GL_LINK_STATUS, &linked);
             if (!linked) {
@@ -118,5 +129,81 @@ namespace mplot {
 
             return program;
         }
+
+        //! Are program binaries supported by the current context?
+        bool ProgramBinariesSupportedMX ([[maybe_unused]] GladGLContext* glfn)
+        {
+#ifdef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+            if (glfn->ProgramBinary == nullptr || glfn->GetProgramBinary == nullptr || glfn->ProgramParameteri == nullptr) {
+                return false;
+            }
+            GLint n_formats = 0;
+            glfn->GetIntegerv (GL_NUM_PROGRAM_BINARY_FORMATS, &n_formats);
+            return n_formats > 0;
+#else
+            return false;
+#endif
+        }
+
+        /*!
+         * As LoadShadersMX, but first try to create the program from a binary stored in the
+         * program cache in cache_dir (see program_cache.h). On a cache miss, the program is
+         * compiled and linked from source and its binary is written to the cache for next time. If
+         * cache_dir is empty, or the context doesn't support program binaries, this is just
+         * LoadShadersMX.
+         */
+        GLuint LoadShadersMXCached (const std::vector<mplot::gl::ShaderInfo>& shader_info, GladGLContext* glfn,
+                                    const std::filesystem::path& cache_dir)
+        {
+            if (shader_info.empty()) { return 0; }
+            if (cache_dir.empty() || !ProgramBinariesSupportedMX (glfn)) { return LoadShadersMX (shader_info, glfn); }
+#ifdef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+            std::string driver;
+            for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+                const GLubyte* str = glfn->GetString (name);
+                if (str != nullptr) { driver += reinterpret_cast<const char*>(str); }
+                driver += '\n';
+            }
+            const uint64_t key = mplot::gl::program_cache::key (shader_info, driver);
+
+            uint32_t binary_format = 0;
+            std::vector<char> binary;
+            if (mplot::gl::program_cache::read (cache_dir, key, binary_format, binary)) {
+                GLuint program = glfn->CreateProgram();
+                glfn->ProgramBinary (program, binary_format, binary.data(), static_cast<GLsizei>(binary.size()));
+                GLint linked = 0;
+                glfn->GetProgramiv (program, GL_LINK_STATUS, &linked);
+                // A rejected binary may leave an error (e.g. GL_INVALID_ENUM) that would trip up LoadShadersMX
+                for (int i = 0; i < 8 && glfn->GetError() != GL_NO_ERROR; ++i) {}
+                if (linked) {
+                    if constexpr (debug_shaders == true) { std::cout << "Program loaded from binary cache\n"; }
+                    return program;
+                }
+                // The driver rejected the binary; rebuild from source and replace the entry
+                glfn->DeleteProgram (program);
+                mplot::gl::program_cache::remove (cache_dir, key);
+            }
+
+            GLuint program = LoadShadersMX (shader_info, glfn, true);
+            if (program == 0) { return 0; }
+
+            GLint len = 0;
+            glfn->GetProgramiv (program, GL_PROGRAM_BINARY_LENGTH, &len);
+            if (len > 0) {
+                binary.resize (len);
+                GLsizei written = 0;
+                GLenum format = 0;
+                glfn->GetProgramBinary (program, len, &written, &format, binary.data());
+                if (written > 0) {
+                    binary.resize (written);
+                    mplot::gl::program_cache::write (cache_dir, key, format, binary);
+                }
+            }
+            for (int i = 0; i < 8 && glfn->GetError() != GL_NO_ERROR; ++i) {}
+            return program;
+#else
+            return LoadShadersMX (shader_info, glfn);
+#endif
+        }
     } // namespace gl
 } // namespace
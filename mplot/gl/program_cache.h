@@ -0,0 +1,159 @@
+/*
+ * An on-disk cache of linked GL program binaries (as returned by glGetProgramBinary). Entries are
+ * keyed by a hash of the GL vendor/renderer/version strings and the source of each shader in the
+ * program, so a driver update or an edited GLSL file simply results in a cache miss.
+ *
+ * The GL calls are made by LoadShadersMXCached (loadshaders_mx.h) and LoadShadersCached
+ * (loadshaders_nomx.h). This file contains the GL-independent parts.
+ *
+ * Note: You have to include a header like gl3.h or glext.h etc for the GL types BEFORE including
+ * this file.
+ */
+
+#pragma once
+
+#include <mplot/gl/shaders.h>
+#include <mplot/cachetools.h>
+#include <mplot/tools.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+
+namespace mplot::gl::program_cache {
+
+    //! Identifies a program cache file ("MPPC") and its format version
+    static constexpr uint32_t magic = 0x4350504du;
+    static constexpr uint32_t format_version = 1u;
+
+    /*!
+     * The standard directory for the program cache. This is $XDG_CACHE_HOME/mplot/shaders or
+     * ~/.cache/mplot/shaders (%LOCALAPPDATA%\mplot\shaders on Windows). If no suitable base
+     * directory is found, an empty path is returned, which disables the cache.
+     */
+    inline std::filesystem::path default_dir()
+    {
+#ifdef _MSC_VER
+        const char* base = std::getenv ("LOCALAPPDATA");
+        if (base != nullptr) { return std::filesystem::path (base) / "mplot" / "shaders"; }
+#else
+        const char* xdg = std::getenv ("XDG_CACHE_HOME");
+        if (xdg != nullptr && xdg[0] != '\0') { return std::filesystem::path (xdg) / "mplot" / "shaders"; }
+        const char* home = std::getenv ("HOME");
+        if (home != nullptr && home[0] != '\0') { return std::filesystem::path (home) / ".cache" / "mplot" / "shaders"; }
+#endif
+        return {};
+    }
+
+    /*!
+     * The cache is off unless the user opts in. This returns the directory given by the
+     * environment variable MPLOT_SHADER_CACHE, or default_dir() if it is set but empty. If
+     * MPLOT_SHADER_CACHE is not set, an empty path (no cache) is returned.
+     */
+    inline std::filesystem::path env_dir()
+    {
+        const char* d = std::getenv ("MPLOT_SHADER_CACHE");
+        if (d == nullptr) { return {}; }
+        if (d[0] == '\0') { return default_dir(); }
+        return std::filesystem::path (d);
+    }
+
+    /*!
+     * Compute the cache key for a program. driver should identify the GL implementation (vendor,
+     * renderer and version strings). The shader source used is the same one that LoadShaders
+     * would use (the file, if it exists, otherwise the compiled-in default).
+     */
+    inline uint64_t key (const std::vector<mplot::gl::ShaderInfo>& shader_info, const std::string& driver)
+    {
+        mplot::cachetools::hasher h;
+        h.add (format_version);
+        h.add (driver);
+        for (auto entry : shader_info) {
+            h.add (entry.type);
+            if (mplot::tools::fileExists (entry.filename)) {
+                std::unique_ptr<GLchar[]> source = mplot::gl::ReadShader (entry.filename);
+                if (source == nullptr) { return 0u; } // can't hash it, so don't cache it
+                h.add (std::string (source.get()));
+            } else {
+                h.add (entry.compiledIn);
+            }
+        }
+        return h.value();
+    }
+
+    //! The path of the cache file for key within dir
+    inline std::filesystem::path filepath (const std::filesystem::path& dir, const uint64_t key)
+    {
+        std::stringstream ss;
+        ss << "mplot_program_" << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+        return dir / ss.str();
+    }
+
+    //! Read a program binary and its format from the cache. Return false on a miss.
+    inline bool read (const std::filesystem::path& dir, const uint64_t key,
+                      uint32_t& binary_format, std::vector<char>& binary)
+    {
+        if (dir.empty() || key == 0u) { return false; }
+        std::ifstream fin (filepath (dir, key), std::ios::in | std::ios::binary);
+        if (!fin.is_open()) { return false; }
+        uint32_t hdr[2] = { 0u, 0u };
+        uint64_t k = 0u;
+        uint64_t len = 0u;
+        fin.read (reinterpret_cast<char*>(hdr), sizeof (hdr));
+        fin.read (reinterpret_cast<char*>(&k), sizeof (k));
+        fin.read (reinterpret_cast<char*>(&binary_format), sizeof (binary_format));
+        fin.read (reinterpret_cast<char*>(&len), sizeof (len));
+        if (!fin || hdr[0] != magic || hdr[1] != format_version || k != key || len == 0u || len > (1ull << 30)) {
+            return false;
+        }
+        binary.resize (len);
+        fin.read (binary.data(), static_cast<std::streamsize>(len));
+        return static_cast<bool>(fin);
+    }
+
+    //! Write a program binary to the cache. Failure is silent; the cache is only an optimisation.
+    inline void write (const std::filesystem::path& dir, const uint64_t key,
+                       const uint32_t binary_format, const std::vector<char>& binary)
+    {
+        if (dir.empty() || key == 0u || binary.empty()) { return; }
+        std::error_code ec;
+        std::filesystem::create_directories (dir, ec);
+        if (ec) { return; }
+        // Write to a temporary file, then rename, so that a concurrent reader never sees a partial file
+        std::filesystem::path fp = filepath (dir, key);
+        std::filesystem::path tmp = mplot::cachetools::tmp_path (fp);
+        {
+            std::ofstream fout (tmp, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!fout.is_open()) { return; }
+            const uint32_t hdr[2] = { magic, format_version };
+            const uint64_t len = binary.size();
+            fout.write (reinterpret_cast<const char*>(hdr), sizeof (hdr));
+            fout.write (reinterpret_cast<const char*>(&key), sizeof (key));
+            fout.write (reinterpret_cast<const char*>(&binary_format), sizeof (binary_format));
+            fout.write (reinterpret_cast<const char*>(&len), sizeof (len));
+            fout.write (binary.data(), static_cast<std::streamsize>(len));
+            if (!fout) {
+                fout.close();
+                std::filesystem::remove (tmp, ec);
+                return;
+            }
+        }
+        std::filesystem::rename (tmp, fp, ec);
+        if (ec) { std::filesystem::remove (tmp, ec); }
+    }
+
+    //! Remove a (stale or rejected) entry from the cache
+    inline void remove (const std::filesystem::path& dir, const uint64_t key)
+    {
+        if (dir.empty() || key == 0u) { return; }
+        std::error_code ec;
+        std::filesystem::remove (filepath (dir, key), ec);
+    }
+
+} // namespace mplot::gl::program_cache
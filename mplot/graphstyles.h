@@ -59,6 +59,14 @@ namespace mplot {
         numstyles
     };
 
+    //! How do the segments of a line meet? (Used by GraphVisual's GPU lines)
+    enum class linejoin
+    {
+        miter,      // segment edges are extended to meet (very sharp turns are left unjoined)
+        round,      // segments have round ends
+        numstyles
+    };
+
     enum class tickstyle
     {
         ticksin,
@@ -0,0 +1,271 @@
+/*!
+ * \file
+ *
+ * An incrementally updated record of the range and the approximate distribution of a set of
+ * values. When a few values change at a time, the minimum, maximum and percentiles can be kept up
+ * to date without re-reading all the values. VisualDataModel uses one to autoscale after sparse
+ * updates, and to autoscale to percentiles (clipping outliers) rather than to the extremes.
+ *
+ * \author Seb James
+ * \date October 2026
+ */
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+#include <mplot/strided_view.h>
+
+namespace mplot {
+
+    /*!
+     * Tracks the minimum, maximum and (approximate) percentiles of n values of type T.
+     *
+     * The tracker holds its own copy of the values, so that when value i is changed with set (i,
+     * x), the old value can be removed from the statistics. The minimum and maximum are exact. The
+     * number of values equal to each is counted, so the values only need to be scanned again when
+     * the last value at an extreme is overwritten. Percentiles come from a histogram of nbins
+     * bins spanning the range found at the last scan and are accurate to about one bin width.
+     * Values that fall outside that range are counted in an underflow or an overflow; when these
+     * hold more than 1/64 of the values, the histogram is rebuilt.
+     *
+     * NaN values are held, but are not counted in the statistics.
+     */
+    template <typename T>
+    class range_tracker
+    {
+    public:
+        range_tracker (const std::size_t _nbins = 1024) : nbins (std::max (_nbins, std::size_t{1})) {}
+
+        //! Replace all the values with those in v and scan them
+        void assign (const mplot::strided_view<T>& v)
+        {
+            this->vals.assign (v.begin(), v.end());
+            this->rescan();
+        }
+
+        //! Change value i to x
+        void set (const std::size_t i, const T x)
+        {
+            this->remove (this->vals[i]);
+            this->vals[i] = x;
+            this->add (x);
+        }
+
+        //! Append the value x
+        void push_back (const T x)
+        {
+            this->vals.push_back (x);
+            this->add (x);
+        }
+
+        //! Remove all the values
+        void clear()
+        {
+            this->vals.clear();
+            this->rescan();
+        }
+
+        //! The number of values (including NaNs)
+        std::size_t size() const { return this->vals.size(); }
+        //! True if there are no non-NaN values
+        bool empty() const { return this->n_valid == 0; }
+        //! Value i
+        T operator[] (const std::size_t i) const { return this->vals[i]; }
+
+        //! The smallest non-NaN value
+        T min()
+        {
+            if (this->stale) { this->rescan(); }
+            return this->lo;
+        }
+
+        //! The largest non-NaN value
+        T max()
+        {
+            if (this->stale) { this->rescan(); }
+            return this->hi;
+        }
+
+        //! The width of a histogram bin; the approximate precision of percentile()
+        double resolution()
+        {
+            if (this->stale) { this->rescan(); }
+            return this->bin_width;
+        }
+
+        /*!
+         * The approximate value below which pc percent of the non-NaN values lie. percentile(0) is
+         * min() and percentile(100) is max(). In between, the result is interpolated linearly
+         * within a histogram bin.
+         */
+        double percentile (const double pc)
+        {
+            if (this->stale) { this->rescan(); }
+            if (this->n_valid == 0) { return 0.0; }
+            if (pc <= 0.0) { return static_cast<double>(this->lo); }
+            if (pc >= 100.0) { return static_cast<double>(this->hi); }
+
+            const double target = 0.01 * pc * static_cast<double>(this->n_valid);
+            double cum = static_cast<double>(this->under);
+            if (target <= cum) {
+                // In the underflow, which lies between lo and the base of the histogram
+                return std::lerp (static_cast<double>(this->lo), this->hist_lo, target / cum);
+            }
+            for (std::size_t b = 0; b < this->nbins; ++b) {
+                const double c = static_cast<double>(this->hist[b]);
+                if (c > 0.0 && cum + c >= target) {
+                    const double x = this->hist_lo + (static_cast<double>(b) + (target - cum) / c) * this->bin_width;
+                    return std::clamp (x, static_cast<double>(this->lo), static_cast<double>(this->hi));
+                }
+                cum += c;
+            }
+            // In the overflow, between the top of the histogram and hi
+            const double ov = static_cast<double>(this->over);
+            return ov > 0.0 ? std::lerp (this->hist_hi, static_cast<double>(this->hi), std::min ((target - cum) / ov, 1.0))
+                            : static_cast<double>(this->hi);
+        }
+
+        //! The number of full scans of the values made so far
+        std::size_t scans() const { return this->n_scans; }
+
+    private:
+        static bool is_nan (const T x)
+        {
+            if constexpr (std::is_floating_point<std::decay_t<T>>::value == true) {
+                return std::isnan (x);
+            } else {
+                return false;
+            }
+        }
+
+        //! The histogram bin for x: -1 for the underflow, nbins for the overflow
+        std::ptrdiff_t slot (const T x) const
+        {
+            const double xd = static_cast<double>(x);
+            if (xd < this->hist_lo) { return -1; }
+            if (xd > this->hist_hi) { return static_cast<std::ptrdiff_t>(this->nbins); }
+            if (this->bin_width <= 0.0) { return 0; }
+            const std::size_t b = static_cast<std::size_t>((xd - this->hist_lo) / this->bin_width);
+            return static_cast<std::ptrdiff_t>(std::min (b, this->nbins - 1));
+        }
+
+        //! Add inc (1 or -1) to the count of x's histogram bin
+        void count (const T x, const int inc)
+        {
+            const std::ptrdiff_t b = this->slot (x);
+            std::size_t& c = b < 0 ? this->under
+                             : (b == static_cast<std::ptrdiff_t>(this->nbins) ? this->over : this->hist[static_cast<std::size_t>(b)]);
+            c = inc > 0 ? c + 1 : c - 1;
+        }
+
+        void add (const T x)
+        {
+            if (is_nan (x)) { return; }
+            ++this->n_valid;
+            if (this->stale) { return; } // all will be recounted by rescan()
+            if (this->n_valid == 1) {
+                this->rescan();
+                return;
+            }
+            if (x < this->lo) {
+                this->lo = x;
+                this->n_lo = 1;
+            } else if (x == this->lo) {
+                ++this->n_lo;
+            }
+            if (x > this->hi) {
+                this->hi = x;
+                this->n_hi = 1;
+            } else if (x == this->hi) {
+                ++this->n_hi;
+            }
+            this->count (x, 1);
+            if (64 * (this->under + this->over) > this->n_valid) { this->stale = true; }
+        }
+
+        void remove (const T x)
+        {
+            if (is_nan (x)) { return; }
+            --this->n_valid;
+            if (this->stale) { return; }
+            // Removing the last value at an extreme means the range must be found again
+            if (x == this->lo && --this->n_lo == 0) { this->stale = true; }
+            if (x == this->hi && --this->n_hi == 0) { this->stale = true; }
+            if (this->stale) { return; }
+            this->count (x, -1);
+        }
+
+        //! Find the range and rebuild the histogram from all the values
+        void rescan()
+        {
+            ++this->n_scans;
+            this->lo = std::numeric_limits<T>::max();
+            this->hi = std::numeric_limits<T>::lowest();
+            this->n_lo = 0;
+            this->n_hi = 0;
+            this->n_valid = 0;
+            for (const T x : this->vals) {
+                if (is_nan (x)) { continue; }
+                ++this->n_valid;
+                if (x < this->lo) {
+                    this->lo = x;
+                    this->n_lo = 1;
+                } else if (x == this->lo) {
+                    ++this->n_lo;
+                }
+                if (x > this->hi) {
+                    this->hi = x;
+                    this->n_hi = 1;
+                } else if (x == this->hi) {
+                    ++this->n_hi;
+                }
+            }
+
+            this->hist.assign (this->nbins, 0);
+            this->under = 0;
+            this->over = 0;
+            if (this->n_valid == 0) {
+                this->lo = T{0};
+                this->hi = T{0};
+                this->hist_lo = 0.0;
+                this->hist_hi = 0.0;
+                this->bin_width = 0.0;
+            } else {
+                this->hist_lo = static_cast<double>(this->lo);
+                this->hist_hi = static_cast<double>(this->hi);
+                this->bin_width = (this->hist_hi - this->hist_lo) / static_cast<double>(this->nbins);
+                for (const T x : this->vals) {
+                    if (!is_nan (x)) { this->count (x, 1); }
+                }
+            }
+            this->stale = false;
+        }
+
+        //! A copy of the values
+        std::vector<T> vals;
+        //! The number of non-NaN values
+        std::size_t n_valid = 0;
+        //! The extremes, and how many values are equal to each
+        T lo = T{0};
+        T hi = T{0};
+        std::size_t n_lo = 0;
+        std::size_t n_hi = 0;
+        //! The histogram: nbins bins of width bin_width from hist_lo to hist_hi, with under- and
+        //! overflows for values outside that range
+        std::size_t nbins = 1024;
+        std::vector<std::size_t> hist;
+        double hist_lo = 0.0;
+        double hist_hi = 0.0;
+        double bin_width = 0.0;
+        std::size_t under = 0;
+        std::size_t over = 0;
+        //! True if the statistics must be recomputed with rescan()
+        bool stale = true;
+        std::size_t n_scans = 0;
+    };
+
+} // namespace mplot
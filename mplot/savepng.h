@@ -0,0 +1,532 @@
+/*!
+ * \file
+ *
+ * A fast, multithreaded PNG encoder for saving screenshots from mplot::Visual.
+ *
+ * lodepng::encode gives very good compression, but it is single threaded and slow for large
+ * frames. This encoder trades some file size for speed. The image rows are split into blocks and
+ * each block is filtered and deflated on its own thread. The block outputs are byte aligned
+ * deflate streams which are concatenated into one zlib stream, with one IDAT chunk per block.
+ *
+ * Only 8 bit RGBA input is supported (which is what glReadPixels gives us).
+ *
+ * \author Seb James
+ * \date October 2026
+ */
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <mplot/lodepng.h>
+
+namespace mplot {
+
+    namespace png {
+
+        //! How hard should the encoder work to compress the image?
+        enum class compression
+        {
+            //! Filter type 'None' and deflate 'stored' blocks. Fastest, largest files.
+            store,
+            //! Adaptive row filtering and a greedy LZ77 with fixed Huffman codes
+            fast,
+            //! Hand over to lodepng::encode (single threaded, smallest files)
+            best
+        };
+
+        //! Options for mplot::savepng
+        struct encoder_options
+        {
+            compression level = compression::fast;
+            //! Number of threads to use. 0 means use std::thread::hardware_concurrency()
+            unsigned int threads = 0;
+            //! The minimum number of rows that one thread should be given to compress
+            unsigned int min_rows_per_block = 16;
+        };
+
+        // CRC-32 lookup table, as specified in the PNG standard
+        inline const std::array<uint32_t, 256>& crc_table()
+        {
+            static const std::array<uint32_t, 256> tbl = []() {
+                std::array<uint32_t, 256> t = {};
+                for (uint32_t n = 0; n < 256u; ++n) {
+                    uint32_t c = n;
+                    for (int k = 0; k < 8; ++k) { c = (c & 1u) ? 0xedb88320u ^ (c >> 1) : c >> 1; }
+                    t[n] = c;
+                }
+                return t;
+            }();
+            return tbl;
+        }
+
+        inline uint32_t crc32 (const unsigned char* buf, std::size_t len, uint32_t crc = 0u)
+        {
+            const std::array<uint32_t, 256>& t = crc_table();
+            uint32_t c = crc ^ 0xffffffffu;
+            for (std::size_t i = 0; i < len; ++i) { c = t[(c ^ buf[i]) & 0xffu] ^ (c >> 8); }
+            return c ^ 0xffffffffu;
+        }
+
+        static constexpr uint32_t adler_base = 65521u;
+
+        inline uint32_t adler32 (const unsigned char* buf, std::size_t len)
+        {
+            uint32_t s1 = 1u;
+            uint32_t s2 = 0u;
+            // 5552 is the largest n such that 255n(n+1)/2 + (n+1)(base-1) fits in 32 bits
+            while (len > 0) {
+                std::size_t n = std::min (len, std::size_t{5552});
+                len -= n;
+                for (std::size_t i = 0; i < n; ++i) {
+                    s1 += buf[i];
+                    s2 += s1;
+                }
+                buf += n;
+                s1 %= adler_base;
+                s2 %= adler_base;
+            }
+            return (s2 << 16) | s1;
+        }
+
+        //! Combine the Adler-32 checksums of two consecutive buffers (len2 is the length of the
+        //! second buffer). Follows zlib's adler32_combine.
+        inline uint32_t adler32_combine (uint32_t adler1, uint32_t adler2, std::size_t len2)
+        {
+            const uint64_t base = adler_base;
+            const uint64_t rem = len2 % base;
+            uint64_t sum1 = adler1 & 0xffffu;
+            uint64_t sum2 = (rem * sum1) % base;
+            sum1 += (adler2 & 0xffffu) + base - 1u;
+            sum2 += ((adler1 >> 16) & 0xffffu) + ((adler2 >> 16) & 0xffffu) + base - rem;
+            if (sum1 >= base) { sum1 -= base; }
+            if (sum1 >= base) { sum1 -= base; }
+            if (sum2 >= (base << 1)) { sum2 -= (base << 1); }
+            if (sum2 >= base) { sum2 -= base; }
+            return static_cast<uint32_t>(sum1 | (sum2 << 16));
+        }
+
+        //! Write bits LSB first into a byte vector, as deflate requires
+        struct bitwriter
+        {
+            std::vector<unsigned char>& out;
+            uint64_t acc = 0u;
+            unsigned int nbits = 0u;
+
+            bitwriter (std::vector<unsigned char>& _out) : out(_out) {}
+
+            void put (uint32_t bits, unsigned int n)
+            {
+                this->acc |= static_cast<uint64_t>(bits) << this->nbits;
+                this->nbits += n;
+                while (this->nbits >= 8u) {
+                    this->out.push_back (static_cast<unsigned char>(this->acc & 0xffu));
+                    this->acc >>= 8;
+                    this->nbits -= 8u;
+                }
+            }
+
+            //! Pad with zeros up to the next byte boundary
+            void align()
+            {
+                if (this->nbits > 0u) {
+                    this->out.push_back (static_cast<unsigned char>(this->acc & 0xffu));
+                    this->acc = 0u;
+                    this->nbits = 0u;
+                }
+            }
+        };
+
+        // Reverse the lowest n bits of code (Huffman codes are packed MSB first)
+        constexpr uint32_t reverse_bits (uint32_t code, unsigned int n)
+        {
+            uint32_t r = 0u;
+            for (unsigned int i = 0; i < n; ++i) { r = (r << 1) | ((code >> i) & 1u); }
+            return r;
+        }
+
+        //! The fixed Huffman code (RFC 1951 section 3.2.6) with pre-reversed bits
+        struct fixed_huffman
+        {
+            std::array<uint32_t, 288> litcode = {};
+            std::array<unsigned int, 288> litlen = {};
+            std::array<uint32_t, 30> distcode = {};
+            // Length symbol, number of extra bits and extra bit value for each match length 3-258
+            std::array<uint16_t, 259> lensym = {};
+            std::array<uint8_t, 259> lenextra_n = {};
+            std::array<uint16_t, 259> lenextra = {};
+
+            static constexpr std::array<uint16_t, 29> len_base = {
+                3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+            };
+            static constexpr std::array<uint8_t, 29> len_bits = {
+                0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+            };
+            static constexpr std::array<uint16_t, 30> dist_base = {
+                1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+                1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+            };
+            static constexpr std::array<uint8_t, 30> dist_bits = {
+                0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+            };
+
+            fixed_huffman()
+            {
+                for (uint32_t s = 0; s < 288u; ++s) {
+                    if (s < 144u) {
+                        this->litlen[s] = 8u;
+                        this->litcode[s] = reverse_bits (0x30u + s, 8u);
+                    } else if (s < 256u) {
+                        this->litlen[s] = 9u;
+                        this->litcode[s] = reverse_bits (0x190u + s - 144u, 9u);
+                    } else if (s < 280u) {
+                        this->litlen[s] = 7u;
+                        this->litcode[s] = reverse_bits (s - 256u, 7u);
+                    } else {
+                        this->litlen[s] = 8u;
+                        this->litcode[s] = reverse_bits (0xc0u + s - 280u, 8u);
+                    }
+                }
+                for (uint32_t d = 0; d < 30u; ++d) { this->distcode[d] = reverse_bits (d, 5u); }
+                for (unsigned int l = 3; l < 259u; ++l) {
+                    unsigned int i = 28;
+                    while (len_base[i] > l) { --i; }
+                    this->lensym[l] = static_cast<uint16_t>(257u + i);
+                    this->lenextra_n[l] = len_bits[i];
+                    this->lenextra[l] = static_cast<uint16_t>(l - len_base[i]);
+                }
+            }
+
+            static const fixed_huffman& get()
+            {
+                static const fixed_huffman fh;
+                return fh;
+            }
+
+            void literal (bitwriter& bw, unsigned int s) const { bw.put (this->litcode[s], this->litlen[s]); }
+
+            void match (bitwriter& bw, unsigned int len, unsigned int dist) const
+            {
+                this->literal (bw, this->lensym[len]);
+                if (this->lenextra_n[len]) { bw.put (this->lenextra[len], this->lenextra_n[len]); }
+                unsigned int d = 29;
+                while (dist_base[d] > dist) { --d; }
+                bw.put (this->distcode[d], 5u);
+                if (dist_bits[d]) { bw.put (dist - dist_base[d], dist_bits[d]); }
+            }
+        };
+
+        /*!
+         * Deflate len bytes from in, appending the output to out. If final is false, the output
+         * ends with an empty stored block so that it is byte aligned and can be concatenated with
+         * the output of the next call.
+         */
+        inline void deflate_stored (const unsigned char* in, std::size_t len, bool final, std::vector<unsigned char>& out)
+        {
+            bitwriter bw (out);
+            std::size_t pos = 0;
+            do {
+                std::size_t n = std::min (len - pos, std::size_t{65535});
+                bool last = final && (pos + n == len);
+                bw.put (last ? 1u : 0u, 3u); // BFINAL, BTYPE=00
+                bw.align();
+                out.push_back (static_cast<unsigned char>(n & 0xffu));
+                out.push_back (static_cast<unsigned char>((n >> 8) & 0xffu));
+                out.push_back (static_cast<unsigned char>(~n & 0xffu));
+                out.push_back (static_cast<unsigned char>((~n >> 8) & 0xffu));
+                out.insert (out.end(), in + pos, in + pos + n);
+                pos += n;
+            } while (pos < len);
+        }
+
+        //! Greedy LZ77 with a single-entry hash table, coded with the fixed Huffman tables
+        inline void deflate_fast (const unsigned char* in, std::size_t len, bool final, std::vector<unsigned char>& out)
+        {
+            constexpr unsigned int hash_bits = 15u;
+            constexpr std::size_t window = 32768u;
+            constexpr std::size_t max_match = 258u;
+            const fixed_huffman& fh = fixed_huffman::get();
+
+            // Positions are stored +1 so that 0 means 'empty'
+            std::vector<uint32_t> head (std::size_t{1} << hash_bits, 0u);
+            auto hash4 = [in](std::size_t i) {
+                uint32_t v = 0u;
+                std::memcpy (&v, in + i, 4);
+                return (v * 2654435761u) >> (32u - hash_bits);
+            };
+
+            bitwriter bw (out);
+            bw.put (final ? 3u : 2u, 3u); // BFINAL, BTYPE=01 (fixed Huffman)
+
+            std::size_t i = 0;
+            while (i + 4 <= len) {
+                uint32_t h = hash4 (i);
+                std::size_t cand = head[h];
+                head[h] = static_cast<uint32_t>(i + 1);
+                std::size_t mlen = 0;
+                if (cand > 0 && i - (cand - 1) <= window) {
+                    const unsigned char* a = in + cand - 1;
+                    const unsigned char* b = in + i;
+                    std::size_t maxl = std::min (max_match, len - i);
+                    while (mlen < maxl && a[mlen] == b[mlen]) { ++mlen; }
+                }
+                if (mlen >= 4) {
+                    fh.match (bw, static_cast<unsigned int>(mlen), static_cast<unsigned int>(i - (cand - 1)));
+                    // Insert a few of the skipped positions so that runs keep matching
+                    std::size_t stop = std::min (i + mlen, len - 3);
+                    for (std::size_t j = i + 1; j < stop && j < i + 4; ++j) {
+                        head[hash4 (j)] = static_cast<uint32_t>(j + 1);
+                    }
+                    i += mlen;
+                } else {
+                    fh.literal (bw, in[i]);
+                    ++i;
+                }
+            }
+            for (; i < len; ++i) { fh.literal (bw, in[i]); }
+            fh.literal (bw, 256u); // end of block
+
+            if (!final) {
+                // Empty stored block to byte align (as zlib's Z_SYNC_FLUSH)
+                bw.put (0u, 3u);
+                bw.align();
+                out.push_back (0x00); out.push_back (0x00);
+                out.push_back (0xff); out.push_back (0xff);
+            } else {
+                bw.align();
+            }
+        }
+
+        /*
+         * PNG row filters for 4 bytes per pixel. The loops have no dependencies between
+         * iterations, so that the compiler can vectorise them.
+         */
+        inline void filter_sub (const unsigned char* cur, std::size_t rowbytes, unsigned char* f)
+        {
+            for (std::size_t i = 0; i < 4 && i < rowbytes; ++i) { f[i] = cur[i]; }
+            for (std::size_t i = 4; i < rowbytes; ++i) { f[i] = static_cast<unsigned char>(cur[i] - cur[i - 4]); }
+        }
+
+        inline void filter_up (const unsigned char* cur, const unsigned char* prev, std::size_t rowbytes, unsigned char* f)
+        {
+            for (std::size_t i = 0; i < rowbytes; ++i) { f[i] = static_cast<unsigned char>(cur[i] - prev[i]); }
+        }
+
+        inline void filter_paeth (const unsigned char* cur, const unsigned char* prev, std::size_t rowbytes, unsigned char* f)
+        {
+            for (std::size_t i = 0; i < 4 && i < rowbytes; ++i) { f[i] = static_cast<unsigned char>(cur[i] - prev[i]); }
+            for (std::size_t i = 4; i < rowbytes; ++i) {
+                int a = cur[i - 4];
+                int b = prev[i];
+                int c = prev[i - 4];
+                int pa = std::abs (b - c);
+                int pb = std::abs (a - c);
+                int pc = std::abs (a + b - 2 * c);
+                int pred = (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+                f[i] = static_cast<unsigned char>(cur[i] - pred);
+            }
+        }
+
+        // The usual 'minimum sum of absolute differences' heuristic for choosing a filter
+        inline uint32_t filter_cost (const unsigned char* f, std::size_t rowbytes)
+        {
+            uint32_t s = 0u;
+            for (std::size_t i = 0; i < rowbytes; ++i) { s += f[i] < 128u ? f[i] : 256u - f[i]; }
+            return s;
+        }
+
+        /*!
+         * Filter the rows [r0, r1) of the w x h RGBA image px into out. Each output row is a
+         * filter type byte followed by 4w bytes.
+         */
+        inline void filter_rows (const unsigned char* px, unsigned int w, unsigned int r0, unsigned int r1,
+                                 compression level, std::vector<unsigned char>& out)
+        {
+            const std::size_t rowbytes = std::size_t{w} * 4u;
+            out.resize ((rowbytes + 1u) * (r1 - r0));
+            std::vector<unsigned char> trial (level == compression::store ? 0u : rowbytes * 3u);
+            for (unsigned int r = r0; r < r1; ++r) {
+                const unsigned char* cur = px + rowbytes * r;
+                unsigned char* o = out.data() + (rowbytes + 1u) * (r - r0);
+                if (level == compression::store) {
+                    o[0] = 0; // None
+                    std::memcpy (o + 1, cur, rowbytes);
+                    continue;
+                }
+                unsigned char* f_sub = trial.data();
+                filter_sub (cur, rowbytes, f_sub);
+                if (r == 0) {
+                    o[0] = 1; // Sub is the only useful filter for the first row
+                    std::memcpy (o + 1, f_sub, rowbytes);
+                    continue;
+                }
+                const unsigned char* prev = cur - rowbytes;
+                unsigned char* f_up = trial.data() + rowbytes;
+                unsigned char* f_paeth = trial.data() + 2u * rowbytes;
+                filter_up (cur, prev, rowbytes, f_up);
+                filter_paeth (cur, prev, rowbytes, f_paeth);
+                uint32_t c_sub = filter_cost (f_sub, rowbytes);
+                uint32_t c_up = filter_cost (f_up, rowbytes);
+                uint32_t c_paeth = filter_cost (f_paeth, rowbytes);
+                if (c_up <= c_sub && c_up <= c_paeth) {
+                    o[0] = 2;
+                    std::memcpy (o + 1, f_up, rowbytes);
+                } else if (c_sub <= c_paeth) {
+                    o[0] = 1;
+                    std::memcpy (o + 1, f_sub, rowbytes);
+                } else {
+                    o[0] = 4;
+                    std::memcpy (o + 1, f_paeth, rowbytes);
+                }
+            }
+        }
+
+        inline void put_u32be (std::vector<unsigned char>& v, uint32_t x)
+        {
+            v.push_back (static_cast<unsigned char>((x >> 24) & 0xffu));
+            v.push_back (static_cast<unsigned char>((x >> 16) & 0xffu));
+            v.push_back (static_cast<unsigned char>((x >> 8) & 0xffu));
+            v.push_back (static_cast<unsigned char>(x & 0xffu));
+        }
+
+        //! The CRC of a chunk covers its type and its data
+        inline uint32_t chunk_crc (const char* type, const unsigned char* data, std::size_t len)
+        {
+            uint32_t crc = crc32 (reinterpret_cast<const unsigned char*>(type), 4);
+            return crc32 (data, len, crc);
+        }
+
+        //! Write a complete chunk (length, type, data, crc) to the stream
+        inline void write_chunk (std::ostream& os, const char* type, const unsigned char* data, std::size_t len, uint32_t crc)
+        {
+            std::vector<unsigned char> hdr;
+            put_u32be (hdr, static_cast<uint32_t>(len));
+            hdr.insert (hdr.end(), type, type + 4);
+            std::vector<unsigned char> tail;
+            put_u32be (tail, crc);
+            os.write (reinterpret_cast<const char*>(hdr.data()), hdr.size());
+            if (len > 0) { os.write (reinterpret_cast<const char*>(data), len); }
+            os.write (reinterpret_cast<const char*>(tail.data()), tail.size());
+        }
+
+        inline void write_chunk (std::ostream& os, const char* type, const unsigned char* data, std::size_t len)
+        {
+            write_chunk (os, type, data, len, chunk_crc (type, data, len));
+        }
+
+        //! Run fn(i) for i in [0, n) over up to n threads
+        template <typename F>
+        void parallel_for (unsigned int n, F fn)
+        {
+            if (n < 2) {
+                for (unsigned int i = 0; i < n; ++i) { fn (i); }
+                return;
+            }
+            std::vector<std::thread> pool;
+            pool.reserve (n - 1);
+            for (unsigned int i = 1; i < n; ++i) { pool.emplace_back (fn, i); }
+            fn (0u);
+            for (auto& t : pool) { t.join(); }
+        }
+
+        /*!
+         * Encode the w x h, 8 bit RGBA image px as a PNG and write it to the stream os. Rows are
+         * given top to bottom. Throws std::runtime_error on failure.
+         */
+        inline void encode (std::ostream& os, const unsigned char* px, unsigned int w, unsigned int h,
+                            const encoder_options& opts = encoder_options())
+        {
+            if (w == 0u || h == 0u) { throw std::runtime_error ("mplot::png::encode: zero sized image"); }
+
+            if (opts.level == compression::best) {
+                std::vector<unsigned char> buf;
+                unsigned int err = lodepng::encode (buf, px, w, h);
+                if (err) {
+                    throw std::runtime_error (std::string("mplot::png::encode: lodepng error: ") + lodepng_error_text (err));
+                }
+                os.write (reinterpret_cast<const char*>(buf.data()), buf.size());
+                return;
+            }
+
+            // Decide how to split the rows between threads
+            unsigned int nthreads = opts.threads > 0u ? opts.threads : std::thread::hardware_concurrency();
+            nthreads = std::max (1u, nthreads);
+            const unsigned int minrows = std::max (1u, opts.min_rows_per_block);
+            unsigned int nblocks = std::max (1u, std::min (nthreads, h / minrows));
+            const unsigned int rows_per_block = (h + nblocks - 1u) / nblocks;
+            nblocks = (h + rows_per_block - 1u) / rows_per_block; // no empty blocks
+
+            std::vector<std::vector<unsigned char>> zdata (nblocks);
+            std::vector<uint32_t> adlers (nblocks, 1u);
+            std::vector<std::size_t> flens (nblocks, 0u);
+
+            parallel_for (nblocks, [&](unsigned int b) {
+                const unsigned int r0 = b * rows_per_block;
+                const unsigned int r1 = std::min (h, r0 + rows_per_block);
+                std::vector<unsigned char> filtered;
+                filter_rows (px, w, r0, r1, opts.level, filtered);
+                flens[b] = filtered.size();
+                adlers[b] = adler32 (filtered.data(), filtered.size());
+                const bool final = (b == nblocks - 1u);
+                std::vector<unsigned char>& z = zdata[b];
+                if (b == 0u) { z.push_back (0x78); z.push_back (0x01); } // zlib header, fastest
+                if (opts.level == compression::store) {
+                    z.reserve (z.size() + filtered.size() + 5u * (filtered.size() / 65535u + 2u));
+                    deflate_stored (filtered.data(), filtered.size(), final, z);
+                } else {
+                    z.reserve (z.size() + filtered.size() / 2u);
+                    deflate_fast (filtered.data(), filtered.size(), final, z);
+                }
+            });
+
+            uint32_t adler = adlers[0];
+            for (unsigned int b = 1; b < nblocks; ++b) { adler = adler32_combine (adler, adlers[b], flens[b]); }
+            put_u32be (zdata.back(), adler);
+
+            // The zlib stream may be spread over several IDAT chunks, so there's one per block
+            std::vector<uint32_t> crcs (nblocks, 0u);
+            parallel_for (nblocks, [&](unsigned int b) { crcs[b] = chunk_crc ("IDAT", zdata[b].data(), zdata[b].size()); });
+
+            // Signature and header
+            static constexpr unsigned char signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+            os.write (reinterpret_cast<const char*>(signature), 8);
+            std::vector<unsigned char> ihdr;
+            put_u32be (ihdr, w);
+            put_u32be (ihdr, h);
+            ihdr.push_back (8); // bit depth
+            ihdr.push_back (6); // colour type RGBA
+            ihdr.push_back (0); // compression
+            ihdr.push_back (0); // filter method
+            ihdr.push_back (0); // no interlace
+            write_chunk (os, "IHDR", ihdr.data(), ihdr.size());
+            for (unsigned int b = 0; b < nblocks; ++b) {
+                write_chunk (os, "IDAT", zdata[b].data(), zdata[b].size(), crcs[b]);
+            }
+            write_chunk (os, "IEND", nullptr, 0u);
+            if (!os) { throw std::runtime_error ("mplot::png::encode: stream write failed"); }
+        }
+
+    } // namespace png
+
+    /*!
+     * Save the w x h, 8 bit RGBA image px (rows ordered top to bottom) as a PNG file. Throws
+     * std::runtime_error on failure.
+     */
+    inline void savepng (const std::string& filename, const unsigned char* px, unsigned int w, unsigned int h,
+                         const png::encoder_options& opts = png::encoder_options())
+    {
+        std::ofstream fout (filename, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!fout.is_open()) { throw std::runtime_error ("mplot::savepng: Failed to open '" + filename + "' for writing"); }
+        png::encode (fout, px, w, h, opts);
+    }
+
+} // namespace mplot
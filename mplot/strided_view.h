@@ -0,0 +1,108 @@
+/*!
+ * \file
+ *
+ * A non-owning, read-only view of n elements of type T in memory owned by someone else. The
+ * elements may be contiguous (as in a std::vector or std::span) or separated by a fixed stride
+ * (one field of an array of structs, one row of a column-major matrix, every k-th element of an
+ * mmapped file). VisualDataModel accepts strided_views as scalar or vector data so that data can
+ * be visualised where it lies, without first being copied into a std::vector.
+ *
+ * \author Seb James
+ * \date October 2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace mplot {
+
+    template <typename T>
+    class strided_view
+    {
+    public:
+        using value_type = T;
+
+        //! An empty view
+        constexpr strided_view() = default;
+
+        //! A view of n elements starting at first, with consecutive elements stride_bytes apart.
+        //! stride_bytes defaults to sizeof(T), meaning the elements are contiguous.
+        strided_view (const T* first, const std::size_t n, const std::ptrdiff_t stride_bytes = sizeof (T))
+            : first_elem (reinterpret_cast<const std::byte*>(first)), n_elem (n), stride (stride_bytes) {}
+
+        //! A view of a contiguous span
+        strided_view (std::span<const T> s) : strided_view (s.data(), s.size()) {}
+
+        //! A view of the content of a std::vector. The vector must outlive the view and must not
+        //! be reallocated while the view is in use. This is explicit, so that passing a vector
+        //! where a view is expected (as to setScalarData) doesn't quietly make a non-owning view.
+        explicit strided_view (const std::vector<T>& v) : strided_view (v.data(), v.size()) {}
+
+        //! A view of a temporary vector would dangle as soon as it was made
+        strided_view (std::vector<T>&&) = delete;
+
+        /*!
+         * A view of the member m of each of the n structs starting at first. For example, to view
+         * the y of each element of a std::vector<particle> ps:
+         *
+         * auto ys = mplot::strided_view<float>::of_member (ps.data(), ps.size(), &particle::y);
+         */
+        template <typename S>
+        static strided_view of_member (const S* first, const std::size_t n, T S::* m)
+        {
+            return strided_view (&(first->*m), n, static_cast<std::ptrdiff_t>(sizeof (S)));
+        }
+
+        constexpr std::size_t size() const { return this->n_elem; }
+        constexpr bool empty() const { return this->n_elem == 0; }
+        //! The distance, in bytes, between consecutive elements
+        constexpr std::ptrdiff_t stride_bytes() const { return this->stride; }
+        //! True if the elements are packed together as in an array
+        constexpr bool contiguous() const { return this->stride == static_cast<std::ptrdiff_t>(sizeof (T)); }
+
+        const T& operator[] (const std::size_t i) const
+        {
+            return *reinterpret_cast<const T*>(this->first_elem + static_cast<std::ptrdiff_t>(i) * this->stride);
+        }
+        const T& front() const { return (*this)[0]; }
+        const T& back() const { return (*this)[this->n_elem - 1]; }
+
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            iterator() = default;
+            iterator (const std::byte* _p, const std::ptrdiff_t _stride) : p (_p), stride (_stride) {}
+            reference operator*() const { return *reinterpret_cast<const T*>(this->p); }
+            pointer operator->() const { return reinterpret_cast<const T*>(this->p); }
+            iterator& operator++() { this->p += this->stride; return *this; }
+            iterator operator++ (int) { iterator tmp = *this; this->p += this->stride; return tmp; }
+            bool operator== (const iterator& rhs) const { return this->p == rhs.p; }
+            bool operator!= (const iterator& rhs) const { return this->p != rhs.p; }
+        private:
+            const std::byte* p = nullptr;
+            std::ptrdiff_t stride = sizeof (T);
+        };
+
+        iterator begin() const { return iterator (this->first_elem, this->stride); }
+        iterator end() const
+        {
+            return iterator (this->first_elem + static_cast<std::ptrdiff_t>(this->n_elem) * this->stride, this->stride);
+        }
+
+    private:
+        const std::byte* first_elem = nullptr;
+        std::size_t n_elem = 0;
+        std::ptrdiff_t stride = sizeof (T);
+    };
+
+} // namespace mplot
@@ -0,0 +1,113 @@
+/*!
+ * \file
+ *
+ * A least-recently-used cache of laid-out text. Each VisualFace holds one. A VisualTextModel
+ * looks up its string (with its font scale and line spacing) before laying it out glyph by
+ * glyph, so re-creating identical labels (the tick labels of a GraphVisual that is rescaled, for
+ * example) skips the layout.
+ *
+ * \author Seb James
+ * \date October 2026
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <array>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+#include <sm/vec>
+
+#include <mplot/cachetools.h>
+
+namespace mplot {
+
+    //! The quads (and their atlas texture coordinates) for one string of text
+    struct text_layout
+    {
+        //! Four corners per glyph: bottom left, top left, top right, bottom right
+        std::vector<std::array<float, 12>> quads;
+        //! Atlas texel coordinates (left, top, right, bottom) for each quad
+        std::vector<std::array<float, 4>> quad_uvs;
+        //! Left, right, bottom and top extents of the text
+        sm::vec<float, 4> extents = { 1e7, -1e7, 1e7, -1e7 };
+    };
+
+    //! An LRU cache of text_layouts for one face, keyed by text, font scale and line spacing
+    class text_layout_cache
+    {
+    public:
+        struct key
+        {
+            std::basic_string<char32_t> text;
+            float fontscale = 1.0f;
+            float line_spacing = 1.0f;
+            bool operator== (const key& rhs) const = default;
+        };
+
+        struct key_hash
+        {
+            std::size_t operator() (const key& k) const
+            {
+                mplot::cachetools::hasher h;
+                h.add_bytes (k.text.data(), k.text.size() * sizeof (char32_t));
+                h.add (k.fontscale);
+                h.add (k.line_spacing);
+                return static_cast<std::size_t>(h.value());
+            }
+        };
+
+        //! The maximum number of layouts to keep. Set 0 to disable the cache.
+        std::size_t capacity = 1024;
+
+        //! Return the cached layout for k (marking it most recently used) or nullptr
+        const text_layout* find (const key& k)
+        {
+            auto mi = this->index.find (k);
+            if (mi == this->index.end()) { return nullptr; }
+            this->entries.splice (this->entries.begin(), this->entries, mi->second);
+            return &mi->second->second;
+        }
+
+        //! Add the layout for k, evicting the least recently used entry if the cache is full
+        const text_layout& insert (const key& k, text_layout&& tl)
+        {
+            auto mi = this->index.find (k);
+            if (mi != this->index.end()) {
+                mi->second->second = std::move (tl);
+                this->entries.splice (this->entries.begin(), this->entries, mi->second);
+                return mi->second->second;
+            }
+            if (this->capacity == 0) {
+                this->uncached = std::move (tl);
+                return this->uncached;
+            }
+            while (this->entries.size() >= this->capacity) {
+                this->index.erase (this->entries.back().first);
+                this->entries.pop_back();
+            }
+            this->entries.emplace_front (k, std::move (tl));
+            this->index.emplace (k, this->entries.begin());
+            return this->entries.front().second;
+        }
+
+        std::size_t size() const { return this->entries.size(); }
+
+        void clear()
+        {
+            this->index.clear();
+            this->entries.clear();
+        }
+
+    private:
+        //! Most recently used first
+        std::list<std::pair<key, text_layout>> entries;
+        std::unordered_map<key, typename std::list<std::pair<key, text_layout>>::iterator, key_hash> index;
+        //! Holds the most recent layout when capacity is 0
+        text_layout uncached;
+    };
+
+} // namespace mplot
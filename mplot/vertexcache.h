@@ -0,0 +1,81 @@
+/*!
+ * \file
+ *
+ * Support code for caching the finalised vertices of a VisualModel on disk (see
+ * VisualModelBase::vertex_cache_dir). A VisualModel that supports caching computes a content
+ * hash of the inputs that determine its vertices with a vertexcache::hasher. The hash is used
+ * as the cache key.
+ *
+ * \author Seb James
+ * \date October 2026
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <mplot/cachetools.h>
+#include <mplot/version.h>
+
+namespace mplot::vertexcache {
+
+    //! Identifies a vertex cache file ("MPVC") and its format version
+    static constexpr uint32_t magic = 0x4356504du;
+    static constexpr uint32_t format_version = 1u;
+
+    //! The cache key hash, with helpers for the kinds of data that VisualModels are built from
+    struct hasher : public mplot::cachetools::hasher
+    {
+        using mplot::cachetools::hasher::add;
+
+        /*!
+         * Add the name of the VisualModel class that makes the vertices, the version of its
+         * vertex generating code and the library version. A class should increment its
+         * generator version whenever its initializeVertices() output changes, so that stale
+         * cache files are not reused.
+         */
+        void add_generator (const std::string& name, const uint32_t generator_version)
+        {
+            this->add (name);
+            this->add (generator_version);
+            this->add (mplot::version_major);
+            this->add (mplot::version_minor);
+        }
+
+        //! Add the state of an sm::scale that affects its output
+        template <typename S>
+        void add_scale (S& s)
+        {
+            this->add (s.do_autoscale);
+            // An autoscaled scale's params are determined by the data, which should be hashed separately
+            if (!s.do_autoscale) {
+                this->add (s.getParams(0));
+                this->add (s.getParams(1));
+            }
+        }
+
+        //! Add the state of a mplot::ColourMap
+        template <typename C>
+        void add_colourmap (const C& cm)
+        {
+            this->add (cm.getType());
+            this->add (cm.getHue());
+            this->add (cm.getSat());
+            this->add (cm.getVal());
+            this->add (cm.getFlagsStr());
+        }
+    };
+
+    //! The start of the name of every vertex cache file
+    static constexpr const char* file_prefix = "mplot_vertices_";
+
+    //! The name of the cache file for a given key
+    inline std::string filename (const uint64_t key)
+    {
+        std::stringstream ss;
+        ss << file_prefix << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+        return ss.str();
+    }
+
+} // namespace mplot::vertexcache
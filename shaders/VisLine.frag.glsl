@@ -0,0 +1,35 @@
+// The coded-in shaders tell non-Mac platforms that they use OpenGL 4.5, but Mac limited to 4.1
+#version 410
+
+in highp vec2 fragxy;
+flat in highp vec2 seg_a;
+flat in highp vec2 seg_b;
+flat in highp float seg_s;
+
+uniform vec3 linecolour;
+uniform float alpha;
+uniform highp float linewidth;
+uniform highp int lineround;
+uniform float dash;     // Dash length. 0 for a solid line.
+uniform float dashgap;  // Gap between dashes
+
+out vec4 finalcolor;
+
+void main()
+{
+    // Where the fragment lies along the segment (0 at seg_a, 1 at seg_b)
+    highp vec2 ab = seg_b - seg_a;
+    highp float len2 = dot(ab, ab);
+    highp float t = len2 > 0.0 ? dot(fragxy - seg_a, ab) / len2 : 0.0;
+
+    if (lineround == 1) {
+        // Trim the quad to a capsule
+        highp vec2 nearest = seg_a + clamp(t, 0.0, 1.0) * ab;
+        if (length(fragxy - nearest) > 0.5 * linewidth) { discard; }
+    }
+    if (dash > 0.0) {
+        highp float s = seg_s + t * sqrt(len2);
+        if (mod(s, dash + dashgap) > dash) { discard; }
+    }
+    finalcolor = vec4(linecolour, alpha);
+}
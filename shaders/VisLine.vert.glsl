@@ -0,0 +1,79 @@
+// The coded-in shaders tell non-Mac platforms that they use OpenGL 4.5, but Mac limited to 4.1
+#version 410
+
+// The line shader. Each instance is one segment of a polyline, from pt_a to pt_b, and is drawn
+// as two triangles (6 vertices) covering a quad of width linewidth around the segment.
+
+uniform mat4 m_matrix;
+uniform mat4 v_matrix;
+uniform mat4 p_matrix;
+// linewidth and lineround are also used in the fragment shader, so their precision is given
+uniform highp float linewidth;
+uniform float linez;         // The z of the line's plane
+uniform highp int lineround; // 1 for round ends (and so round joins), 0 for miter joins
+uniform float shorten;   // If > 0, shorten each segment by this at each end and don't join them
+
+// Each point is (x, y, s) where s is the distance along the line to the point
+layout(location = 0) in vec3 prev;  // The point before pt_a (pt_a itself at the start of the line)
+layout(location = 1) in vec3 pt_a;
+layout(location = 2) in vec3 pt_b;
+layout(location = 3) in vec3 next;  // The point after pt_b (pt_b itself at the end of the line)
+
+out highp vec2 fragxy;         // The fragment's position in the line's plane
+flat out highp vec2 seg_a;     // The (possibly shortened) segment
+flat out highp vec2 seg_b;
+flat out highp float seg_s;    // The distance along the line to seg_a
+
+void main()
+{
+    // For each of the 6 vertices: which end of the segment (0 is a, 1 is b) and which side
+    const float ends[6] = float[6](0.0, 0.0, 1.0, 0.0, 1.0, 1.0);
+    const float sides[6] = float[6](-1.0, 1.0, 1.0, -1.0, 1.0, -1.0);
+    float end = ends[gl_VertexID];
+    float side = sides[gl_VertexID];
+
+    vec2 a = pt_a.xy;
+    vec2 b = pt_b.xy;
+    float hw = 0.5 * linewidth;
+    float len = length(b - a);
+    vec2 d = len > 0.0 ? (b - a) / len : vec2(1.0, 0.0);
+    vec2 n = vec2(-d.y, d.x);
+    float s = pt_a.z;
+
+    if (shorten > 0.0) {
+        // Leave a gap at each end. A segment too short for its gaps collapses to nothing.
+        if (len <= 2.0 * shorten) { hw = 0.0; }
+        float sh = min(shorten, 0.5 * len);
+        a += d * sh;
+        b -= d * sh;
+        s += sh;
+    }
+
+    vec2 p = end == 0.0 ? a : b;
+    vec2 off = n * hw;
+    if (lineround == 1) {
+        // Cover the capsule around the segment. The fragment shader trims it to shape.
+        p += d * (end == 0.0 ? -hw : hw);
+    } else if (shorten <= 0.0) {
+        // Meet the neighbouring segment on the bisector of the angle between the two
+        vec2 e = end == 0.0 ? a - prev.xy : next.xy - b;
+        float elen = length(e);
+        if (elen > 0.0) {
+            vec2 t = d + e / elen;
+            float tlen = length(t);
+            if (tlen > 0.001) {
+                t /= tlen;
+                vec2 m = vec2(-t.y, t.x);
+                float cos_half = dot(m, n);
+                // Very sharp turns (more than about 150 degrees) are left unjoined
+                if (cos_half > 0.25) { off = m * (hw / cos_half); }
+            }
+        }
+    }
+
+    fragxy = p + side * off;
+    seg_a = a;
+    seg_b = b;
+    seg_s = s;
+    gl_Position = p_matrix * v_matrix * m_matrix * vec4(fragxy, linez, 1.0);
+}
@@ -1,12 +1,21 @@
 // The coded-in shaders tell non-Mac platforms that they use OpenGL 4.5, but Mac limited to 4.1
 #version 410
-in vec2 TexCoords;
+in vec2 TexCoords; // in texels of the glyph atlas
+in vec3 TextTint;
 out vec4 color;
 
 uniform sampler2D text;
 uniform vec3 textColor;
+uniform int sdf; // 1 if the atlas holds signed distance fields (edge at 0.5) rather than coverage
 
 void main()
 {
-    color = vec4(textColor, texture(text, TexCoords).r);
+    vec2 uv = TexCoords / vec2(textureSize(text, 0));
+    float a = texture(text, uv).r;
+    if (sdf != 0) {
+        // Antialias over about one screen pixel, whatever the scale of the text
+        float w = max(fwidth(a), 0.0001);
+        a = smoothstep(0.5 - w, 0.5 + w, a);
+    }
+    color = vec4(textColor * TextTint, a);
 }
@@ -11,9 +11,11 @@ layout(location = 2) in vec4 vcolor;   // Attrib location 2 is vertex colour
 layout(location = 3) in vec4 texture;  // Attrib location 3 is texture map location
 
 out vec2 TexCoords;
+out vec3 TextTint; // multiplies textColor; per-vertex colour in batched text
 
 void main()
 {
     gl_Position = p_matrix * v_matrix * m_matrix * position;
     TexCoords = texture.xy;
+    TextTint = vcolor.rgb;
 }
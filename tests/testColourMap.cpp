@@ -3,6 +3,9 @@
 #include <list>
 #include <array>
 #include <iostream>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
 #include <mplot/ColourMap.h>
 
 int main ()
@@ -81,5 +84,57 @@ int main ()
     if (c != mid_jet) { --rtn; std::cout << "ulli fail\n"; }
     std::cout << "(unsigned long long int) Colour: " << c[0] << "," << c[1] << ","<< c[2] << std::endl;
 
+    // Procedural maps are baked into lookup tables. Check that the tables reproduce the computed
+    // colours to better than one 8 bit step and compare the speed of lookup vs. computation.
+    constexpr float max_lut_err = 1.0f / 255.0f;
+    using namespace std::chrono;
+    for (auto t : { mplot::ColourMapType::Fire, mplot::ColourMapType::Monochrome,
+                    mplot::ColourMapType::HSV1D, mplot::ColourMapType::CyclicFour }) {
+        mplot::ColourMap<float> cm_lut (t);
+        float err = 0.0f;
+        float acc = 0.0f;
+        constexpr int n = 1000000;
+        steady_clock::time_point t0 = steady_clock::now();
+        for (int i = 0; i < n; ++i) { acc += cm_lut.convert (static_cast<float>(i) / n)[0]; }
+        steady_clock::time_point t1 = steady_clock::now();
+        for (int i = 0; i < n; ++i) { acc += cm_lut.compute (static_cast<float>(i) / n)[0]; }
+        steady_clock::time_point t2 = steady_clock::now();
+        for (int i = 0; i < n; i += 97) {
+            std::array<float, 3> c1 = cm_lut.convert (static_cast<float>(i) / n);
+            std::array<float, 3> c2 = cm_lut.compute (static_cast<float>(i) / n);
+            for (int j = 0; j < 3; ++j) { err = std::max (err, std::abs (c1[j] - c2[j])); }
+        }
+        std::cout << cm_lut.getTypeStr() << ": lookup " << duration_cast<microseconds>(t1 - t0).count()
+                  << " us, compute " << duration_cast<microseconds>(t2 - t1).count() << " us per "
+                  << n << " (max error " << err << ", checksum " << acc << ")\n";
+        if (err > max_lut_err) { --rtn; std::cout << cm_lut.getTypeStr() << " LUT fail\n"; }
+    }
+    for (auto t : { mplot::ColourMapType::HSV, mplot::ColourMapType::DiscFourBlack, mplot::ColourMapType::DiscSixWhite }) {
+        mplot::ColourMap<float> cm_lut (t);
+        float err = 0.0f;
+        float acc = 0.0f;
+        constexpr int n = 1000;
+        steady_clock::time_point t0 = steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) { acc += cm_lut.convert (static_cast<float>(i) / n, static_cast<float>(j) / n)[0]; }
+        }
+        steady_clock::time_point t1 = steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) { acc += cm_lut.compute (static_cast<float>(i) / n, static_cast<float>(j) / n)[0]; }
+        }
+        steady_clock::time_point t2 = steady_clock::now();
+        for (int i = 0; i < n; i += 7) {
+            for (int j = 0; j < n; j += 7) {
+                std::array<float, 3> c1 = cm_lut.convert (static_cast<float>(i) / n, static_cast<float>(j) / n);
+                std::array<float, 3> c2 = cm_lut.compute (static_cast<float>(i) / n, static_cast<float>(j) / n);
+                for (int k = 0; k < 3; ++k) { err = std::max (err, std::abs (c1[k] - c2[k])); }
+            }
+        }
+        std::cout << cm_lut.getTypeStr() << ": lookup " << duration_cast<microseconds>(t1 - t0).count()
+                  << " us, compute " << duration_cast<microseconds>(t2 - t1).count() << " us per "
+                  << n * n << " (max error " << err << ", checksum " << acc << ")\n";
+        if (err > max_lut_err) { --rtn; std::cout << cm_lut.getTypeStr() << " LUT fail\n"; }
+    }
+
     return rtn;
 }
@@ -0,0 +1,117 @@
+// Test the M4 and LTTB decimation functions and the min/max pyramid that GraphVisual uses for large datasets
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <mplot/decimate.h>
+
+int main()
+{
+    int rtn = 0;
+
+    // A million points of a noisy sine wave over x in [0, 1)
+    const std::size_t n = 1000000;
+    std::vector<std::array<float, 2>> pts (n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const float x = static_cast<float>(i) / static_cast<float>(n);
+        pts[i] = { x, std::sin (20.0f * x) + ((i * 7919) % 13 == 0 ? 0.5f : 0.0f) };
+    }
+
+    // M4 keeps no more than 4 points per column, in order, including the first and last
+    const std::size_t ncols = 500;
+    std::vector<std::size_t> keep = mplot::decimate::m4 (pts, 0.0, 1.0, ncols);
+    if (keep.size() > 4 * ncols || keep.size() < ncols) { --rtn; std::cout << "m4 size fail: " << keep.size() << "\n"; }
+    if (keep.front() != 0 || keep.back() != n - 1) { --rtn; std::cout << "m4 ends fail\n"; }
+    for (std::size_t i = 1; i < keep.size(); ++i) {
+        if (keep[i] <= keep[i - 1]) { --rtn; std::cout << "m4 order fail\n"; break; }
+    }
+
+    // In each column, the kept points have the same minimum and maximum as all of the points
+    std::vector<float> lo (ncols, 10.0f), hi (ncols, -10.0f), klo (ncols, 10.0f), khi (ncols, -10.0f);
+    auto col = [ncols](float x)
+    {
+        return std::min (static_cast<std::size_t>(std::floor (static_cast<double>(x) * static_cast<double>(ncols))), ncols - 1);
+    };
+    for (const auto& p : pts) {
+        lo[col (p[0])] = std::min (lo[col (p[0])], p[1]);
+        hi[col (p[0])] = std::max (hi[col (p[0])], p[1]);
+    }
+    for (std::size_t k : keep) {
+        const auto& p = pts[k];
+        klo[col (p[0])] = std::min (klo[col (p[0])], p[1]);
+        khi[col (p[0])] = std::max (khi[col (p[0])], p[1]);
+    }
+    if (lo != klo || hi != khi) { --rtn; std::cout << "m4 column extremes fail\n"; }
+
+    // Points off the axes are gathered into one column at each side
+    std::vector<std::array<float, 2>> wide = { {-2.0f, 1.0f}, {-1.0f, 5.0f}, {-0.5f, -5.0f}, {-0.1f, 0.0f}, {0.5f, 0.0f},
+                                               {1.5f, 0.0f}, {2.0f, 9.0f}, {3.0f, 0.0f} };
+    keep = mplot::decimate::m4 (wide, 0.0, 1.0, 4);
+    if (keep != std::vector<std::size_t>{ 0, 1, 2, 3, 4, 5, 6, 7 }) { --rtn; std::cout << "m4 off-axes fail\n"; }
+
+    // LTTB returns exactly n_out points, in order, including the first and last
+    const std::size_t n_out = 1000;
+    keep = mplot::decimate::lttb (pts, n_out);
+    if (keep.size() != n_out || keep.front() != 0 || keep.back() != n - 1) {
+        --rtn; std::cout << "lttb size/ends fail: " << keep.size() << "\n";
+    }
+    for (std::size_t i = 1; i < keep.size(); ++i) {
+        if (keep[i] <= keep[i - 1]) { --rtn; std::cout << "lttb order fail\n"; break; }
+    }
+
+    // LTTB picks out a lone spike
+    std::vector<std::array<float, 2>> spike (10000);
+    for (std::size_t i = 0; i < spike.size(); ++i) { spike[i] = { static_cast<float>(i), i == 4321 ? 100.0f : 0.0f }; }
+    keep = mplot::decimate::lttb (spike, 50);
+    bool found = false;
+    for (std::size_t k : keep) { if (k == 4321) { found = true; } }
+    if (!found) { --rtn; std::cout << "lttb spike fail\n"; }
+
+    // Small datasets are not decimated
+    keep = mplot::decimate::lttb (wide, 100);
+    if (keep.size() != wide.size()) { --rtn; std::cout << "lttb small fail\n"; }
+
+    // The pyramid gives the same M4 points, for any range of x (as when zooming), and when it
+    // is extended as points are appended
+    std::mt19937 gen (7);
+    std::uniform_int_distribution<int> level (0, 20); // Small integers, to give many ties
+    std::vector<std::array<float, 2>> ts;
+    mplot::decimate::minmax_pyramid pyr;
+    for (std::size_t i = 0; i < 100000; ++i) {
+        ts.push_back ({ static_cast<float>(i / 3), static_cast<float>(level (gen)) });
+        if (i % 9973 == 0) { pyr.extend (ts); }
+    }
+    pyr.extend (ts);
+    if (pyr.size() != ts.size() || !pyr.sorted_x()) { --rtn; std::cout << "pyramid size/sorted fail\n"; }
+    const std::array<std::array<double, 2>, 4> ranges = { { {0.0, 33333.0}, {1000.0, 1100.0}, {-50.0, 20000.0}, {33000.0, 40000.0} } };
+    for (const auto& r : ranges) {
+        for (std::size_t nc : { std::size_t{1}, std::size_t{7}, std::size_t{640} }) {
+            if (pyr.m4 (ts, r[0], r[1], nc) != mplot::decimate::m4 (ts, r[0], r[1], nc)) {
+                --rtn; std::cout << "pyramid m4 fail for [" << r[0] << "," << r[1] << ") in " << nc << " columns\n";
+            }
+        }
+    }
+    std::uniform_int_distribution<std::size_t> pos (0, ts.size() - 1);
+    for (int k = 0; k < 1000; ++k) {
+        std::size_t a = pos (gen);
+        std::size_t b = pos (gen);
+        if (a > b) { std::swap (a, b); }
+        ++b;
+        std::size_t lo = a, hi = a;
+        for (std::size_t i = a; i < b; ++i) {
+            if (ts[i][1] < ts[lo][1]) { lo = i; }
+            if (ts[i][1] > ts[hi][1]) { hi = i; }
+        }
+        const std::array<std::size_t, 2> mm = pyr.minmax (ts, a, b);
+        if (mm[0] != lo || mm[1] != hi) { --rtn; std::cout << "pyramid minmax fail\n"; break; }
+    }
+    ts.push_back ({ -1.0f, 0.0f });
+    pyr.extend (ts);
+    if (pyr.sorted_x()) { --rtn; std::cout << "pyramid unsorted fail\n"; }
+
+    if (rtn == 0) { std::cout << "testDecimate passed\n"; }
+    return rtn;
+}
@@ -0,0 +1,47 @@
+/*
+ * Time the creation of a font face from each of the embedded fonts. The faces are loaded from
+ * memory, so this measures FreeType's face setup plus the rasterisation of the printable ASCII
+ * glyphs into the (CPU-side) atlas. No GL context is needed; the atlas upload is a no-op.
+ */
+#include <iostream>
+#include <chrono>
+#include <mplot/glad/gl.h>
+#include <mplot/VisualFaceBase.h>
+
+// A face that keeps its atlas on the CPU only
+struct cpu_face : public mplot::visgl::VisualFaceBase
+{
+    cpu_face (const mplot::VisualFont font, const unsigned int fontpixels, FT_Library& ft)
+    {
+        this->init_common (font, fontpixels, ft);
+        this->prewarm();
+    }
+    void upload_atlas (const bool, const int, const int, const int, const int) final {}
+};
+
+int main()
+{
+    int rtn = 0;
+
+    FT_Library ft;
+    if (FT_Init_FreeType (&ft)) { return -1; }
+
+    using sc = std::chrono::steady_clock;
+    constexpr int reps = 10;
+    for (auto font : { mplot::VisualFont::DVSans, mplot::VisualFont::DVSansBold,
+                       mplot::VisualFont::Vera, mplot::VisualFont::VeraMono, mplot::VisualFont::VeraSerif }) {
+        sc::time_point t0 = sc::now();
+        for (int i = 0; i < reps; ++i) {
+            cpu_face f (font, 24, ft);
+            if (f.face == nullptr) { --rtn; }
+            if (f.glyph ('m').advance == 0u) { --rtn; }
+        }
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(sc::now() - t0).count();
+        std::cout << "Font " << static_cast<int>(font) << ": " << (us / reps) << " us per face\n";
+    }
+
+    FT_Done_FreeType (ft);
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
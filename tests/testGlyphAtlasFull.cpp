@@ -0,0 +1,60 @@
+/*
+ * Fill a small glyph atlas and check that a glyph for which there is no room has no size (so that
+ * it draws nothing) but keeps its advance, and that every packed glyph lies within the atlas. No
+ * GL context is needed; the atlas is never uploaded.
+ */
+#include <iostream>
+#include <string>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include <mplot/VisualFaceBase.h>
+
+struct atlas_probe : public mplot::visgl::VisualFaceBase
+{
+    atlas_probe (FT_Library& ft, const int _atlas_max)
+    {
+        this->atlas_max = _atlas_max;
+        this->init_common (mplot::VisualFont::DVSans, 24, ft);
+    }
+    int width() const { return this->atlas_w; }
+    int height() const { return this->atlas_h; }
+protected:
+    void upload_atlas (const bool, const int, const int, const int, const int) final {}
+};
+
+int main()
+{
+    int rtn = 0;
+
+    FT_Library ft;
+    if (FT_Init_FreeType (&ft)) { std::cout << "Could not init FreeType\n"; return -1; }
+    {
+        // Room for only a dozen or so 24 pixel glyphs
+        atlas_probe face (ft, 64);
+        if (face.face == nullptr) { std::cout << "No face\n"; return -1; }
+
+        unsigned int n_blank = 0;
+        const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+        for (char ch : chars) {
+            const mplot::visgl::CharInfo& ci = face.glyph (static_cast<char32_t>(ch));
+            if (ci.advance == 0u) { --rtn; std::cout << "'" << ch << "' has no advance\n"; }
+            if (ci.size.x() == 0 && ci.size.y() == 0) {
+                ++n_blank;
+            } else if (ci.atlas_pos.x() + ci.size.x() > face.width() || ci.atlas_pos.y() + ci.size.y() > face.height()) {
+                --rtn;
+                std::cout << "'" << ch << "' lies outside the atlas\n";
+            }
+        }
+        if (n_blank == 0) { --rtn; std::cout << "The atlas never filled up\n"; }
+
+        // The fallback is stored, so a second lookup gives the same blank glyph
+        const mplot::visgl::CharInfo& z = face.glyph (U'z');
+        if (z.size.x() != 0 || z.size.y() != 0 || z.advance == 0u) { --rtn; std::cout << "Fallback glyph fail\n"; }
+    }
+    FT_Done_FreeType (ft);
+
+    std::cout << "return rtn = " << rtn << std::endl;
+    return rtn;
+}
@@ -0,0 +1,66 @@
+/*
+ * Stream points into a GraphVisual with append() and check that a large dataset's lines and
+ * markers stay decimated: the graph holds far fewer vertices than an undecimated one.
+ */
+#include <iostream>
+#include <memory>
+#include <cmath>
+
+#include <sm/vec>
+
+#include <mplot/Visual.h>
+#include <mplot/GraphVisual.h>
+
+// Expose the number of vertices in the graph
+struct graph_probe : public mplot::GraphVisual<float>
+{
+    graph_probe (const sm::vec<float> _offset) : mplot::GraphVisual<float>(_offset) {}
+    std::size_t n_vertices() const { return this->vertexPositions.size() / 3; }
+};
+
+graph_probe* stream_graph (mplot::Visual<>& v, const unsigned int decimation_columns, const unsigned int n)
+{
+    auto gv = std::make_unique<graph_probe> (sm::vec<float>{});
+    v.bindmodel (gv);
+    gv->setlimits (0, 1, -1, 1);
+    gv->policy = mplot::stylepolicy::both;
+    gv->decimation_columns = decimation_columns;
+    gv->prepdata ("stream");
+    gv->finalize();
+    auto gvp = v.addVisualModel (gv);
+    for (unsigned int i = 0; i < n; ++i) {
+        const float x = static_cast<float>(i) / static_cast<float>(n);
+        gvp->append (x, std::sin (40.0f * x), 0);
+        if (i % 16 == 0) { v.render(); }
+    }
+    v.render();
+    return gvp;
+}
+
+int main()
+{
+    int rtn = 0;
+    try {
+        mplot::Visual v(640, 480, "GraphVisual append decimation");
+
+        constexpr unsigned int cols = 64;
+        constexpr unsigned int n = 40 * cols;
+        graph_probe* gfull = stream_graph (v, 0, n);
+        graph_probe* gdec = stream_graph (v, cols, n);
+
+        std::cout << "Vertices: undecimated " << gfull->n_vertices() << ", decimated " << gdec->n_vertices() << std::endl;
+        // At most 4 * cols line points and cols markers, plus fewer than cols appended points
+        // since the last rebuild, against n of each in the undecimated graph.
+        if (gdec->n_vertices() * 4 > gfull->n_vertices()) {
+            --rtn;
+            std::cout << "Appended lines and markers were not decimated\n";
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+        rtn = -1;
+    }
+
+    std::cout << "return rtn = " << rtn << std::endl;
+    return rtn;
+}
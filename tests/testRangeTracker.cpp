@@ -0,0 +1,65 @@
+// Test mplot::range_tracker, the incremental min/max/percentile tracker used for autoscaling
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include <mplot/range_tracker.h>
+
+int main()
+{
+    int rtn = 0;
+
+    // 0, 1, ..., 9999
+    std::vector<float> v (10000);
+    for (std::size_t i = 0; i < v.size(); ++i) { v[i] = static_cast<float>(i); }
+    mplot::range_tracker<float> rt;
+    rt.assign (mplot::strided_view<float>(v));
+    if (rt.min() != 0.0f || rt.max() != 9999.0f || rt.scans() != 1u) { --rtn; std::cout << "assign fail\n"; }
+
+    // Percentiles are accurate to about a bin width (10000/1024)
+    if (std::abs (rt.percentile (1.0) - 100.0) > 2.0 * rt.resolution()) { --rtn; std::cout << "1st percentile fail: " << rt.percentile (1.0) << "\n"; }
+    if (std::abs (rt.percentile (99.0) - 9899.0) > 2.0 * rt.resolution()) { --rtn; std::cout << "99th percentile fail: " << rt.percentile (99.0) << "\n"; }
+    if (rt.percentile (0.0) != 0.0 || rt.percentile (100.0) != 9999.0) { --rtn; std::cout << "0/100 percentile fail\n"; }
+
+    // Changing values inside the range needs no scan
+    std::mt19937 gen (42);
+    std::uniform_int_distribution<std::size_t> pick (1, v.size() - 2);
+    std::uniform_real_distribution<float> val (1.0f, 9998.0f);
+    for (int k = 0; k < 1000; ++k) { rt.set (pick (gen), val (gen)); }
+    if (rt.min() != 0.0f || rt.max() != 9999.0f || rt.scans() != 1u) { --rtn; std::cout << "set within range fail\n"; }
+
+    // A new extreme is tracked without a scan
+    rt.set (5, -5.0f);
+    if (rt.min() != -5.0f || rt.scans() != 1u) { --rtn; std::cout << "new min fail\n"; }
+
+    // Overwriting an extreme that is shared with another value needs no scan
+    rt.set (6, -5.0f);
+    rt.set (5, 50.0f);
+    if (rt.min() != -5.0f || rt.scans() != 1u) { --rtn; std::cout << "shared min fail\n"; }
+
+    // Overwriting the only value at an extreme leads to a scan when the range is next needed
+    rt.set (6, 60.0f);
+    if (rt.min() != 0.0f || rt.scans() != 2u) { --rtn; std::cout << "rescan on lost min fail: min " << rt.min() << " scans " << rt.scans() << "\n"; }
+    rt.set (v.size() - 1, 1.0f);
+    if (rt.max() >= 9999.0f || rt.scans() != 3u) { --rtn; std::cout << "rescan on lost max fail\n"; }
+
+    // NaNs are held, but ignored
+    rt.set (7, std::numeric_limits<float>::quiet_NaN());
+    rt.push_back (std::numeric_limits<float>::quiet_NaN());
+    if (rt.min() != 0.0f || rt.size() != v.size() + 1) { --rtn; std::cout << "NaN fail\n"; }
+
+    // Appending
+    mplot::range_tracker<int> ri;
+    for (int i = 0; i < 100; ++i) { ri.push_back (i); }
+    if (ri.min() != 0 || ri.max() != 99 || ri.size() != 100u) { --rtn; std::cout << "push_back fail\n"; }
+    const std::size_t s0 = ri.scans();
+    for (int i = 100; i < 200; ++i) { ri.push_back (i); }
+    if (ri.max() != 199 || std::abs (ri.percentile (50.0) - 100.0) > 2.0) { --rtn; std::cout << "append fail: median " << ri.percentile (50.0) << "\n"; }
+    // The appended values overflowed the histogram, so it has been rebuilt
+    if (ri.scans() == s0) { --rtn; std::cout << "append rebin fail\n"; }
+
+    if (rtn == 0) { std::cout << "testRangeTracker passed\n"; }
+    return rtn;
+}
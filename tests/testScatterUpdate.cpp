@@ -0,0 +1,90 @@
+/*
+ * Test ScatterVisual's updateData overloads: the whole-data update inherited from
+ * VisualDataModel and ScatterVisual's own sparse update, which recolours markers in place.
+ */
+#include <iostream>
+#include <vector>
+#include <array>
+#include <memory>
+#include <cmath>
+
+#include <sm/vec>
+#include <sm/vvec>
+
+#include <mplot/Visual.h>
+#include <mplot/ScatterVisual.h>
+
+// Expose the colours of the vertices
+struct scatter_probe : public mplot::ScatterVisual<float>
+{
+    scatter_probe (const sm::vec<float> _offset) : mplot::ScatterVisual<float>(_offset) {}
+    const std::vector<float>& colours() const { return this->vertexColors; }
+};
+
+// Does every vertex of marker i (of nv vertices) have the colour clr?
+bool marker_is (const std::vector<float>& c, std::size_t i, std::size_t nv, const std::array<float, 3>& clr)
+{
+    for (std::size_t j = nv * i; j < nv * (i + 1); ++j) {
+        for (std::size_t k = 0; k < 3; ++k) {
+            if (std::abs (c[3 * j + k] - clr[k]) > 1e-6f) { return false; }
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    int rtn = 0;
+    try {
+        mplot::Visual v(640, 480, "ScatterVisual::updateData");
+
+        constexpr std::size_t n = 10;
+        sm::vvec<sm::vec<float, 3>> points (n);
+        std::vector<float> data (n);
+        for (std::size_t i = 0; i < n; ++i) {
+            points[i] = { 0.1f * i, 0.0f, 0.0f };
+            data[i] = static_cast<float>(i);
+        }
+
+        auto sv = std::make_unique<scatter_probe> (sm::vec<float>{});
+        v.bindmodel (sv);
+        sv->setDataCoords (&points);
+        sv->setScalarData (&data);
+        sv->radiusFixed = 0.03f;
+        sv->finalize();
+        auto svp = v.addVisualModel (sv);
+
+        const std::size_t nv = svp->colours().size() / 3 / n;
+        if (nv == 0) { std::cout << "No vertices\n"; return -1; }
+
+        // The inherited whole-data update. Reverse the data, so that marker 0 takes the top colour.
+        std::vector<float> data2 (data.rbegin(), data.rend());
+        svp->updateData (&data2);
+        if (!marker_is (svp->colours(), 0, nv, svp->cm.convert (svp->colourScale.transform_one (data2[0])))
+            || !marker_is (svp->colours(), n - 1, nv, svp->cm.convert (svp->colourScale.transform_one (data2[n - 1])))) {
+            --rtn;
+            std::cout << "updateData (const std::vector<T>*) fail\n";
+        }
+
+        // The sparse update recolours marker 3 alone
+        std::vector<unsigned int> idx = { 3u };
+        std::vector<float> val = { 0.0f };
+        data2[3] = val[0];
+        svp->updateData (idx, val);
+        if (!marker_is (svp->colours(), 3, nv, svp->cm.convert (svp->colourScale.transform_one (0.0f)))) {
+            --rtn;
+            std::cout << "updateData (indices, values) fail\n";
+        }
+        if (!marker_is (svp->colours(), 4, nv, svp->cm.convert (svp->colourScale.transform_one (data2[4])))) {
+            --rtn;
+            std::cout << "updateData (indices, values) changed another marker\n";
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+        rtn = -1;
+    }
+
+    std::cout << "return rtn = " << rtn << std::endl;
+    return rtn;
+}
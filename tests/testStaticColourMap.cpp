@@ -0,0 +1,104 @@
+/*
+ * Test that mplot::StaticColourMap gives the same colours as mplot::ColourMap for a range of
+ * listed and computed colour maps, with both the single datum and the span-based convert. Also
+ * times the bulk conversion of a large array with each.
+ */
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <span>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <mplot/ColourMap.h>
+#include <mplot/StaticColourMap.h>
+
+// The static and runtime maps must agree exactly, NaN included
+template <mplot::ColourMapType cmt>
+int compare()
+{
+    mplot::StaticColourMap<cmt> scm;
+    mplot::ColourMap<float> cm (cmt);
+    if (scm.getType() != cmt) { std::cerr << "Wrong type\n"; return 1; }
+
+    std::vector<float> data;
+    for (int i = -100; i <= 1100; ++i) { data.push_back (i / 1000.0f); }
+    data.push_back (std::numeric_limits<float>::quiet_NaN());
+
+    std::vector<float> rgb_s (3 * data.size());
+    std::vector<float> rgb_r (3 * data.size());
+    scm.convert (std::span<const float>(data), std::span<float>(rgb_s));
+    cm.convert (std::span<const float>(data), std::span<float>(rgb_r));
+
+    int fails = 0;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        const std::array<float, 3> cs = scm.convert (data[i]);
+        const std::array<float, 3> cr = cm.convert (data[i]);
+        for (std::size_t j = 0; j < 3; ++j) {
+            if (cs[j] != cr[j] || rgb_s[3 * i + j] != cr[j] || rgb_r[3 * i + j] != cr[j]) { ++fails; }
+        }
+    }
+    if (fails) { std::cerr << scm.getTypeStr() << ": " << fails << " colour components differ\n"; }
+    return fails ? 1 : 0;
+}
+
+double time_ms (auto fn)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+int main()
+{
+    using mplot::ColourMapType;
+    int rtn = 0;
+
+    // Listed maps from each family (matplotlib, Crameri, CET and the aliases Jet and Rainbow)
+    rtn += compare<ColourMapType::Jet>();
+    rtn += compare<ColourMapType::Rainbow>();
+    rtn += compare<ColourMapType::Magma>();
+    rtn += compare<ColourMapType::Inferno>();
+    rtn += compare<ColourMapType::Plasma>();
+    rtn += compare<ColourMapType::Viridis>();
+    rtn += compare<ColourMapType::Cividis>();
+    rtn += compare<ColourMapType::Twilight>();
+    rtn += compare<ColourMapType::Petrov>();
+    rtn += compare<ColourMapType::Batlow>();
+    rtn += compare<ColourMapType::Cork>();
+    rtn += compare<ColourMapType::Vik>();
+    rtn += compare<ColourMapType::Navia>();
+    rtn += compare<ColourMapType::Managua>();
+    rtn += compare<ColourMapType::CET_L02>();
+    rtn += compare<ColourMapType::CET_C6>();
+    rtn += compare<ColourMapType::CET_D01A>();
+    rtn += compare<ColourMapType::CET_R3>();
+    // Computed maps, which StaticColourMap passes on to ColourMap
+    rtn += compare<ColourMapType::Fire>();
+    rtn += compare<ColourMapType::Greyscale>();
+    rtn += compare<ColourMapType::Monochrome>();
+
+    if (mplot::StaticColourMap<ColourMapType::Viridis>::table.empty()
+        || !mplot::StaticColourMap<ColourMapType::Fire>::table.empty()) {
+        std::cerr << "Unexpected table\n";
+        ++rtn;
+    }
+
+    // Time the bulk conversion of 4M data (about the size of a 2048 x 2048 grid)
+    std::vector<float> data (1u << 22);
+    for (std::size_t i = 0; i < data.size(); ++i) { data[i] = static_cast<float>(i % 1000) / 999.0f; }
+    std::vector<float> rgb (3 * data.size());
+    mplot::StaticColourMap<ColourMapType::Viridis> scm;
+    mplot::ColourMap<float> cm (ColourMapType::Viridis);
+    double t_run = time_ms ([&]() { cm.convert (std::span<const float>(data), std::span<float>(rgb)); });
+    float check = rgb[3 * 500];
+    double t_static = time_ms ([&]() { scm.convert (std::span<const float>(data), std::span<float>(rgb)); });
+    if (check != rgb[3 * 500]) { ++rtn; }
+    std::cout << data.size() << " data: ColourMap::convert " << t_run << " ms; StaticColourMap::convert "
+              << t_static << " ms\n";
+
+    std::cout << "return rtn = " << rtn << std::endl;
+    return rtn;
+}
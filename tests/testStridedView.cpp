@@ -0,0 +1,66 @@
+// Test mplot::strided_view, which lets VisualDataModels read data in place
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include <mplot/strided_view.h>
+
+struct particle
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    double mass = 0.0;
+};
+
+int main()
+{
+    int rtn = 0;
+
+    // Contiguous view of a vector
+    std::vector<float> v = { 1.0f, 2.0f, 3.0f, 4.0f };
+    mplot::strided_view<float> sv (v);
+    if (sv.size() != 4 || !sv.contiguous() || sv[2] != 3.0f) { --rtn; std::cout << "contiguous view fail\n"; }
+    if (std::accumulate (sv.begin(), sv.end(), 0.0f) != 10.0f) { --rtn; std::cout << "iteration fail\n"; }
+
+    // A view of a vector is made explicitly, and never of a temporary
+    static_assert (!std::is_convertible_v<const std::vector<float>&, mplot::strided_view<float>>);
+    static_assert (!std::is_constructible_v<mplot::strided_view<float>, std::vector<float>&&>);
+
+    // Every other element
+    mplot::strided_view<float> evens (v.data(), 2, 2 * sizeof (float));
+    if (evens[0] != 1.0f || evens[1] != 3.0f || evens.contiguous()) { --rtn; std::cout << "stride 2 fail\n"; }
+
+    // One field of an array of structs
+    std::vector<particle> ps (5);
+    for (std::size_t i = 0; i < ps.size(); ++i) {
+        ps[i].y = static_cast<float>(i) * 10.0f;
+        ps[i].mass = static_cast<double>(i);
+    }
+    auto ys = mplot::strided_view<float>::of_member (ps.data(), ps.size(), &particle::y);
+    auto ms = mplot::strided_view<double>::of_member (ps.data(), ps.size(), &particle::mass);
+    if (ys.size() != 5 || ys.stride_bytes() != static_cast<std::ptrdiff_t>(sizeof (particle))) { --rtn; std::cout << "of_member fail\n"; }
+    for (std::size_t i = 0; i < ps.size(); ++i) {
+        if (ys[i] != ps[i].y || ms[i] != ps[i].mass) { --rtn; std::cout << "of_member element " << i << " fail\n"; }
+    }
+    // The view sees changes to the underlying data without copying
+    ps[3].y = -1.0f;
+    if (ys[3] != -1.0f) { --rtn; std::cout << "aliasing fail\n"; }
+
+    // A row of a column-major (Armadillo style) 3x4 matrix
+    std::array<float, 12> colmajor = {};
+    for (std::size_t c = 0; c < 4; ++c) {
+        for (std::size_t r = 0; r < 3; ++r) { colmajor[c * 3 + r] = static_cast<float>(r * 100 + c); }
+    }
+    mplot::strided_view<float> row1 (colmajor.data() + 1, 4, 3 * sizeof (float));
+    for (std::size_t c = 0; c < 4; ++c) {
+        if (row1[c] != static_cast<float>(100 + c)) { --rtn; std::cout << "matrix row fail\n"; }
+    }
+
+    mplot::strided_view<float> empty_view;
+    if (!empty_view.empty() || empty_view.begin() != empty_view.end()) { --rtn; std::cout << "empty fail\n"; }
+
+    std::cout << (rtn == 0 ? "PASS\n" : "FAIL\n");
+    return rtn;
+}
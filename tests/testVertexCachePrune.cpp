@@ -0,0 +1,52 @@
+// Test that mplot::cachetools::prune removes the least recently used vertex cache files
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <filesystem>
+#include <mplot/vertexcache.h>
+
+namespace fs = std::filesystem;
+
+int main()
+{
+    int rtn = 0;
+
+    const fs::path dir = fs::temp_directory_path() / "mplot_testVertexCachePrune";
+    fs::remove_all (dir);
+    fs::create_directories (dir);
+
+    // Five 1000 byte cache files, each used a minute after the last, and a file of another kind
+    const auto now = fs::file_time_type::clock::now();
+    for (uint64_t k = 0; k < 5; ++k) {
+        const fs::path fp = dir / mplot::vertexcache::filename (k + 1);
+        std::ofstream (fp, std::ios::binary) << std::string (1000, 'v');
+        fs::last_write_time (fp, now - std::chrono::minutes (10 - k));
+    }
+    const fs::path other = dir / "mplot_program_0000000000000001.bin";
+    std::ofstream (other, std::ios::binary) << std::string (5000, 'p');
+    fs::last_write_time (other, now - std::chrono::hours (1));
+
+    // Use the oldest file, so that it becomes the most recently used
+    mplot::cachetools::touch (dir / mplot::vertexcache::filename (1));
+
+    // Keep 2500 bytes: files 2, 3 and 4 go; 5 and the just used 1 stay
+    mplot::cachetools::prune (dir, mplot::vertexcache::file_prefix, 2500);
+    for (uint64_t k = 1; k <= 5; ++k) {
+        const bool expected = (k == 1 || k == 5);
+        if (fs::exists (dir / mplot::vertexcache::filename (k)) != expected) {
+            --rtn;
+            std::cout << "File " << k << (expected ? " was removed\n" : " was kept\n");
+        }
+    }
+    if (!fs::exists (other)) { --rtn; std::cout << "A file of another kind was removed\n"; }
+
+    // Under the limit, nothing is removed
+    mplot::cachetools::prune (dir, mplot::vertexcache::file_prefix, 1u << 20);
+    if (!fs::exists (dir / mplot::vertexcache::filename (5))) { --rtn; std::cout << "Pruned under the limit\n"; }
+
+    fs::remove_all (dir);
+
+    std::cout << "return rtn = " << rtn << std::endl;
+    return rtn;
+}
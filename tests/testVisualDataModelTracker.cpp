@@ -0,0 +1,70 @@
+/*
+ * Test that a VisualDataModel's range tracker stays in step with sparse updates made while the
+ * scales are ready (and not autoscaling), so that autoscaling after clearAutoscale() uses the
+ * true range of the data. No window or GL context is needed; the model is never finalized.
+ */
+#include <iostream>
+#include <vector>
+#include <numeric>
+#include <cmath>
+#include <array>
+
+#include <mplot/Visual.h>
+#include <mplot/VisualDataModel.h>
+
+// A data model with no vertices, to exercise VisualDataModel's scaling code
+struct nullmodel : public mplot::VisualDataModel<float>
+{
+    void initializeVertices() {}
+};
+
+int main()
+{
+    int rtn = 0;
+
+    std::vector<float> data (100);
+    std::iota (data.begin(), data.end(), 0.0f); // 0 to 99
+
+    nullmodel m;
+    m.track_range = true;
+    m.zScale.do_autoscale = true;
+    m.colourScale.do_autoscale = true;
+    m.setScalarData (&data);
+    m.setupScaling();
+    if (!m.colourScale.ready() || m.tracked_range().max != 99.0f) { --rtn; std::cout << "initial autoscale fail\n"; }
+
+    // Sparse updates while the scales are ready. The scales don't change, but the tracker must
+    // still see the new values.
+    bool z_changed = false;
+    std::array<unsigned int, 1> i50 = { 50u };
+    std::array<float, 1> v50 = { 1000.0f };
+    data[50] = v50[0];
+    if (m.rescale_at (i50, v50, z_changed) == false) { --rtn; std::cout << "ready scale sparse update fail\n"; }
+    std::array<unsigned int, 1> i0 = { 0u };
+    std::array<float, 1> v0 = { 20.0f };
+    data[0] = v0[0];
+    if (m.rescale_at (i0, v0, z_changed) == false) { --rtn; std::cout << "ready scale sparse update 2 fail\n"; }
+
+    // Now autoscale again. The next sparse update must find that the range is 1 to 1000, not the
+    // 0 to 99 of the last autoscale, and ask for a rebuild.
+    m.clearAutoscale();
+    std::array<unsigned int, 1> i60 = { 60u };
+    std::array<float, 1> v60 = { 5.0f };
+    data[60] = v60[0];
+    if (m.rescale_at (i60, v60, z_changed) == true) { --rtn; std::cout << "rescale_at missed the range change\n"; }
+    if (m.tracked_range().min != 1.0f || m.tracked_range().max != 1000.0f) {
+        --rtn;
+        std::cout << "tracked range " << m.tracked_range().min << " to " << m.tracked_range().max << " (expected 1 to 1000)\n";
+    }
+
+    // The rebuild (as reinit() would do) autoscales to the tracked range
+    m.setupScaling();
+    if (std::abs (m.colourScale.transform_one (1000.0f) - 1.0f) > 1e-6f
+        || std::abs (m.colourScale.transform_one (1.0f)) > 1e-6f) {
+        --rtn;
+        std::cout << "autoscale after clearAutoscale fail\n";
+    }
+
+    std::cout << "return rtn = " << rtn << std::endl;
+    return rtn;
+}
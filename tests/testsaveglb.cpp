@@ -0,0 +1,137 @@
+/*
+ * Save a scene with Visual::saveglb, with and without KHR_mesh_quantization, parse both .glb
+ * files back in and check that the dequantised positions and normals match the float ones.
+ * The model is a long, thin rod, so the quantisation scale is far from uniform.
+ */
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+#include <sm/vec>
+
+#include <mplot/Visual.h>
+#include <mplot/RodVisual.h>
+
+struct glb
+{
+    nlohmann::json js;
+    std::vector<uint8_t> bin;
+};
+
+uint32_t read_u32 (const std::vector<uint8_t>& b, std::size_t i)
+{
+    return b[i] | (uint32_t{b[i + 1]} << 8) | (uint32_t{b[i + 2]} << 16) | (uint32_t{b[i + 3]} << 24);
+}
+
+glb read_glb (const std::string& path)
+{
+    std::ifstream f (path, std::ios::in | std::ios::binary);
+    std::vector<uint8_t> b ((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    if (b.size() < 20u || read_u32 (b, 0) != 0x46546c67u || read_u32 (b, 8) != b.size()) {
+        throw std::runtime_error ("Bad glb header");
+    }
+    glb g;
+    const uint32_t jlen = read_u32 (b, 12);
+    g.js = nlohmann::json::parse (b.begin() + 20, b.begin() + 20 + jlen);
+    const std::size_t bstart = 20u + jlen;
+    const uint32_t blen = read_u32 (b, bstart);
+    g.bin.assign (b.begin() + bstart + 8, b.begin() + bstart + 8 + blen);
+    return g;
+}
+
+// Read element i of a VEC3 accessor as floats, applying glTF's normalized integer rules
+sm::vec<float, 3> read_vec3 (const glb& g, unsigned int acc, std::size_t i)
+{
+    const auto& a = g.js["accessors"][acc];
+    const auto& bv = g.js["bufferViews"][a["bufferView"].get<unsigned int>()];
+    const int ctype = a["componentType"].get<int>();
+    const std::size_t csize = ctype == 5126 ? 4u : (ctype == 5122 ? 2u : 1u);
+    const std::size_t stride = bv.contains ("byteStride") ? bv["byteStride"].get<std::size_t>() : 3u * csize;
+    const std::size_t base = bv["byteOffset"].get<std::size_t>() + i * stride;
+    sm::vec<float, 3> v = {};
+    for (std::size_t k = 0u; k < 3u; ++k) {
+        const uint8_t* p = g.bin.data() + base + k * csize;
+        if (ctype == 5126) {
+            uint32_t u = p[0] | (uint32_t{p[1]} << 8) | (uint32_t{p[2]} << 16) | (uint32_t{p[3]} << 24);
+            std::memcpy (&v[k], &u, 4);
+        } else if (ctype == 5122) {
+            auto s = static_cast<int16_t>(p[0] | (p[1] << 8));
+            v[k] = std::max (s / 32767.0f, -1.0f);
+        } else if (ctype == 5120) {
+            v[k] = std::max (static_cast<int8_t>(p[0]) / 127.0f, -1.0f);
+        }
+    }
+    return v;
+}
+
+sm::vec<float, 3> node_vec (const glb& g, const char* key, sm::vec<float, 3> dflt)
+{
+    const auto& n = g.js["nodes"][0];
+    if (!n.contains (key)) { return dflt; }
+    return { n[key][0].get<float>(), n[key][1].get<float>(), n[key][2].get<float>() };
+}
+
+int main()
+{
+    int rtn = 0;
+    try {
+        mplot::Visual v(640, 480, "saveglb");
+
+        auto rv = std::make_unique<mplot::RodVisual<>>(sm::vec<float, 3>{1.0f, 2.0f, 3.0f},
+                                                       sm::vec<float, 3>{0.0f, 0.0f, 0.0f},
+                                                       sm::vec<float, 3>{8.0f, 0.5f, 0.0f}, 0.1f,
+                                                       std::array<float, 3>{1.0f, 0.0f, 0.0f});
+        v.bindmodel (rv);
+        rv->finalize();
+        v.addVisualModel (rv);
+
+        v.saveglb ("./testsaveglb.glb");
+        v.saveglb ("./testsaveglb_q.glb", true);
+
+        glb gf = read_glb ("./testsaveglb.glb");
+        glb gq = read_glb ("./testsaveglb_q.glb");
+
+        const std::size_t nv = gf.js["accessors"][1]["count"].get<std::size_t>();
+        if (nv == 0u || gq.js["accessors"][1]["count"].get<std::size_t>() != nv) {
+            std::cerr << "Vertex counts differ\n";
+            return -1;
+        }
+
+        const sm::vec<float, 3> tf = node_vec (gf, "translation", {});
+        const sm::vec<float, 3> tq = node_vec (gq, "translation", {});
+        const sm::vec<float, 3> sq = node_vec (gq, "scale", {1.0f, 1.0f, 1.0f});
+
+        float maxperr = 0.0f;
+        float maxnerr = 0.0f;
+        for (std::size_t i = 0u; i < nv; ++i) {
+            // Positions in the scene, as a viewer would place them
+            sm::vec<float, 3> pf = tf + read_vec3 (gf, 1, i);
+            sm::vec<float, 3> pq = tq + sq * read_vec3 (gq, 1, i);
+            maxperr = std::max (maxperr, (pf - pq).length());
+            // Normals as a viewer would light them: the inverse-transpose of the node scale
+            sm::vec<float, 3> nf = read_vec3 (gf, 3, i);
+            sm::vec<float, 3> nq = read_vec3 (gq, 3, i) / sq;
+            nq.renormalize();
+            maxnerr = std::max (maxnerr, (nf - nq).length());
+        }
+        std::cout << "Max position error " << maxperr << ", max normal error " << maxnerr << std::endl;
+        // Half a quantisation step along the rod's longest side is 4/32767
+        if (maxperr > 2e-4f) { std::cerr << "Dequantised positions differ\n"; rtn -= 1; }
+        // 8 bit normals, stretched by the node scale, are good to a few degrees. Unscaled
+        // normals would be out by tens of degrees on this rod.
+        if (maxnerr > 0.05f) { std::cerr << "Dequantised normals differ\n"; rtn -= 1; }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Caught exception: " << e.what() << std::endl;
+        rtn = -1;
+    }
+
+    return rtn;
+}
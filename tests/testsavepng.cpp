@@ -0,0 +1,128 @@
+/*
+ * Test the multithreaded PNG encoder in mplot/savepng.h by round-tripping images through
+ * lodepng::decode. Also times mplot::png::encode against lodepng::encode for 1080p and 4K frames.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <mplot/lodepng.h>
+#include <mplot/savepng.h>
+
+// Make up an image that looks a bit like a screenshot (flat background, some smooth shading and
+// some noise)
+std::vector<unsigned char> make_image (unsigned int w, unsigned int h)
+{
+    std::vector<unsigned char> px (std::size_t{w} * h * 4u, 255);
+    unsigned int seed = 12345u;
+    for (unsigned int y = 0; y < h; ++y) {
+        for (unsigned int x = 0; x < w; ++x) {
+            unsigned char* p = px.data() + (std::size_t{y} * w + x) * 4u;
+            if (x > w / 4 && x < 3 * w / 4 && y > h / 4 && y < 3 * h / 4) {
+                p[0] = static_cast<unsigned char>((x * 255u) / w);
+                p[1] = static_cast<unsigned char>((y * 255u) / h);
+                p[2] = static_cast<unsigned char>(128 + 127 * std::sin (0.05 * (x + y)));
+            } else if (x % 97 < 3) {
+                seed = seed * 1103515245u + 12345u;
+                p[0] = static_cast<unsigned char>(seed >> 16);
+                p[1] = static_cast<unsigned char>(seed >> 8);
+                p[2] = static_cast<unsigned char>(seed >> 24);
+            }
+            if (x % 7 == 0) { p[3] = 200; }
+        }
+    }
+    return px;
+}
+
+int roundtrip (unsigned int w, unsigned int h, const mplot::png::encoder_options& opts)
+{
+    std::vector<unsigned char> px = make_image (w, h);
+    std::ostringstream oss;
+    mplot::png::encode (oss, px.data(), w, h, opts);
+    std::string s = oss.str();
+
+    std::vector<unsigned char> decoded;
+    unsigned int dw = 0, dh = 0;
+    unsigned int err = lodepng::decode (decoded, dw, dh,
+                                        reinterpret_cast<const unsigned char*>(s.data()), s.size(), LCT_RGBA, 8);
+    if (err) {
+        std::cerr << "lodepng::decode error " << err << ": " << lodepng_error_text (err) << std::endl;
+        return -1;
+    }
+    if (dw != w || dh != h || decoded != px) {
+        std::cerr << "Round trip mismatch for " << w << "x" << h << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+double time_ms (auto fn)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+int main()
+{
+    int rtn = 0;
+
+    mplot::png::encoder_options opts;
+    for (auto level : { mplot::png::compression::store, mplot::png::compression::fast }) {
+        opts.level = level;
+        for (unsigned int threads : { 1u, 3u, 8u }) {
+            opts.threads = threads;
+            opts.min_rows_per_block = 1;
+            rtn += roundtrip (1, 1, opts);
+            rtn += roundtrip (17, 9, opts);
+            rtn += roundtrip (640, 480, opts);
+            // More than 65535 bytes per block to test multiple stored blocks
+            rtn += roundtrip (300, 257, opts);
+        }
+    }
+    // compression::best hands the whole image to lodepng, so the thread count is irrelevant
+    opts.level = mplot::png::compression::best;
+    opts.threads = 1;
+    rtn += roundtrip (1, 1, opts);
+    rtn += roundtrip (17, 9, opts);
+    rtn += roundtrip (640, 480, opts);
+
+    if (rtn != 0) {
+        std::cout << "Round trip tests FAILED\n";
+        return rtn;
+    }
+
+    // Benchmark against lodepng
+    for (auto [w, h] : { std::pair<unsigned int, unsigned int>{1920, 1080}, {3840, 2160} }) {
+        std::vector<unsigned char> px = make_image (w, h);
+        std::size_t sz_lode = 0, sz_store = 0, sz_fast = 0;
+        double t_lode = time_ms ([&]() {
+            std::vector<unsigned char> buf;
+            lodepng::encode (buf, px.data(), w, h);
+            sz_lode = buf.size();
+        });
+        mplot::png::encoder_options o;
+        o.level = mplot::png::compression::store;
+        double t_store = time_ms ([&]() {
+            std::ostringstream oss;
+            mplot::png::encode (oss, px.data(), w, h, o);
+            sz_store = oss.str().size();
+        });
+        o.level = mplot::png::compression::fast;
+        double t_fast = time_ms ([&]() {
+            std::ostringstream oss;
+            mplot::png::encode (oss, px.data(), w, h, o);
+            sz_fast = oss.str().size();
+        });
+        std::cout << w << "x" << h << ": lodepng " << t_lode << " ms (" << sz_lode << " bytes); "
+                  << "store " << t_store << " ms (" << sz_store << " bytes); "
+                  << "fast " << t_fast << " ms (" << sz_fast << " bytes)\n";
+    }
+
+    std::cout << "return rtn = " << rtn << std::endl;
+    return rtn;
+}